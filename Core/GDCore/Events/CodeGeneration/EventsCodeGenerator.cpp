@@ -1,6 +1,9 @@
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
 #include <utility>
 
 #include "GDCore/CommonTools.h"
@@ -295,7 +298,7 @@ gd::String EventsCodeGenerator::GenerateConditionCode(
   gd::String conditionCode;
 
   const gd::InstructionMetadata& instrInfos =
-      MetadataProvider::GetConditionMetadata(platform, condition.GetType());
+      MetadataProvider::GetConditionMetadata(platform, condition.GetInternedType());
   if (MetadataProvider::IsBadInstructionMetadata(instrInfos)) {
     return "/* Unknown instruction - skipped. */";
   }
@@ -518,7 +521,7 @@ gd::String EventsCodeGenerator::GenerateActionCode(
   gd::String actionCode;
 
   const gd::InstructionMetadata& instrInfos =
-      MetadataProvider::GetActionMetadata(platform, action.GetType());
+      MetadataProvider::GetActionMetadata(platform, action.GetInternedType());
   if (MetadataProvider::IsBadInstructionMetadata(instrInfos)) {
     return "/* Unknown instruction - skipped. */";
   }
@@ -804,7 +807,7 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(
   } else if (ParameterMetadata::IsBehavior(metadata.GetType())) {
     argOutput = GenerateGetBehaviorNameCode(parameter.GetPlainString());
   } else if (metadata.GetType() == "key") {
-    argOutput = "\"" + ConvertToString(parameter.GetPlainString()) + "\"";
+    argOutput = ConvertToStringExplicit(parameter.GetPlainString());
   } else if (metadata.GetType() == "audioResource" ||
              metadata.GetType() == "bitmapFontResource" ||
              metadata.GetType() == "fontResource" ||
@@ -819,9 +822,9 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(
              // Deprecated, old parameter names:
              metadata.GetType() == "password" || metadata.GetType() == "musicfile" ||
              metadata.GetType() == "soundfile" || metadata.GetType() == "police") {
-    argOutput = "\"" + ConvertToString(parameter.GetPlainString()) + "\"";
+    argOutput = ConvertToStringExplicit(parameter.GetPlainString());
   } else if (metadata.GetType() == "mouse") {
-    argOutput = "\"" + ConvertToString(parameter.GetPlainString()) + "\"";
+    argOutput = ConvertToStringExplicit(parameter.GetPlainString());
   } else if (metadata.GetType() == "yesorno") {
     auto parameterString = parameter.GetPlainString();
     argOutput += (parameterString == "yes" || parameterString == "oui")
@@ -851,7 +854,7 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(
       if (!metadata.GetType().empty())
         cout << "Warning: Unknown type of parameter \"" << metadata.GetType()
              << "\"." << std::endl;
-      argOutput += "\"" + ConvertToString(parameter.GetPlainString()) + "\"";
+      argOutput += ConvertToStringExplicit(parameter.GetPlainString());
     }
   }
 
@@ -1006,18 +1009,94 @@ gd::String EventsCodeGenerator::GenerateEventsListCode(
   return output;
 }
 
-gd::String EventsCodeGenerator::ConvertToString(gd::String plainString) {
-  plainString = plainString.FindAndReplace("\\", "\\\\")
-                    .FindAndReplace("\r", "\\r")
-                    .FindAndReplace("\n", "\\n")
-                    .FindAndReplace("\"", "\\\"");
+namespace {
+
+bool IsCharacterToEscape(char character) {
+  return character == '\\' || character == '\r' || character == '\n' ||
+         character == '"';
+}
+
+/**
+ * \brief Return true if one of the 8 bytes is a character to escape.
+ */
+bool HasCharacterToEscape(std::uint64_t bytes) {
+  const std::uint64_t ones = 0x0101010101010101ULL;
+  const std::uint64_t highBits = 0x8080808080808080ULL;
+  // A byte of `bytes ^ (ones * character)` is zero if the byte is the
+  // character, and a zero byte sets its high bit in `(x - ones) & ~x`.
+  auto hasZeroByte = [&](std::uint64_t x) {
+    return ((x - ones) & ~x & highBits) != 0;
+  };
+  return hasZeroByte(bytes ^ (ones * '\\')) ||
+         hasZeroByte(bytes ^ (ones * '\r')) ||
+         hasZeroByte(bytes ^ (ones * '\n')) ||
+         hasZeroByte(bytes ^ (ones * '"'));
+}
+
+/**
+ * \brief Return the position of the first character to escape from the given
+ * position, or the size of the string if there is none.
+ *
+ * Characters to escape are all ASCII, so the UTF-8 bytes are checked directly
+ * (bytes of other characters are never ASCII), 8 at a time.
+ */
+std::size_t FindCharacterToEscape(const std::string& str, std::size_t position) {
+  const char* data = str.data();
+  while (position + 8 <= str.size()) {
+    std::uint64_t bytes;
+    std::memcpy(&bytes, data + position, 8);
+    if (HasCharacterToEscape(bytes)) break;
+
+    position += 8;
+  }
+  while (position < str.size() && !IsCharacterToEscape(data[position]))
+    position++;
+
+  return position;
+}
 
-  return plainString;
+/**
+ * \brief Append the string, with its characters escaped, to the output in a
+ * single pass.
+ */
+void AppendEscapedString(const std::string& str, std::string& output) {
+  std::size_t position = 0;
+  while (true) {
+    std::size_t escapePosition = FindCharacterToEscape(str, position);
+    output.append(str, position, escapePosition - position);
+    if (escapePosition == str.size()) return;
+
+    char character = str[escapePosition];
+    output += '\\';
+    output += character == '\r' ? 'r' : character == '\n' ? 'n' : character;
+    position = escapePosition + 1;
+  }
+}
+
+}  // namespace
+
+gd::String EventsCodeGenerator::ConvertToString(gd::String plainString) {
+  const std::string& str = static_cast<const gd::String&>(plainString).Raw();
+  if (FindCharacterToEscape(str, 0) == str.size()) return plainString;
+
+  gd::String convertedString;
+  std::string& output = convertedString.Raw();
+  output.reserve(str.size() + str.size() / 8 + 2);
+  AppendEscapedString(str, output);
+  return convertedString;
 }
 
 gd::String EventsCodeGenerator::ConvertToStringExplicit(
     gd::String plainString) {
-  return "\"" + ConvertToString(plainString) + "\"";
+  const std::string& str = static_cast<const gd::String&>(plainString).Raw();
+
+  gd::String convertedString;
+  std::string& output = convertedString.Raw();
+  output.reserve(str.size() + str.size() / 8 + 2);
+  output += '"';
+  AppendEscapedString(str, output);
+  output += '"';
+  return convertedString;
 }
 
 void EventsCodeGenerator::DeleteUselessEvents(gd::EventsList& events) {
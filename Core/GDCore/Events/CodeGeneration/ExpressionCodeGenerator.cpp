@@ -5,7 +5,12 @@
  */
 #include "ExpressionCodeGenerator.h"
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <vector>
 
@@ -89,7 +94,331 @@ gd::String ExpressionCodeGenerator::GenerateExpressionCode(
   return generator.GetOutput();
 }
 
+namespace {
+
+/**
+ * \brief A number or a string computed at generation time.
+ */
+struct ConstantValue {
+  ConstantValue() : isString(false), number(0){};
+
+  bool isString;
+  double number;
+  gd::String string;
+};
+
+/**
+ * \brief Return the terms of a chain of "+" and "-" operations.
+ *
+ * The parser builds "a - b + c" as "a - (b + c)", but the generated code
+ * evaluates it from left to right, as "(a - b) + c". The chain must be
+ * considered as a whole to compute it like the generated code would.
+ */
+void GetOperationsChain(OperatorNode& node,
+                        std::vector<ExpressionNode*>& terms,
+                        std::vector<gd::String::value_type>& operators) {
+  OperatorNode* operatorNode = &node;
+  while (true) {
+    terms.push_back(operatorNode->leftHandSide.get());
+    operators.push_back(operatorNode->op);
+
+    auto* nextOperatorNode =
+        dynamic_cast<OperatorNode*>(operatorNode->rightHandSide.get());
+    if (!nextOperatorNode ||
+        (nextOperatorNode->op != '+' && nextOperatorNode->op != '-')) {
+      terms.push_back(operatorNode->rightHandSide.get());
+      return;
+    }
+    operatorNode = nextOperatorNode;
+  }
+}
+
+/**
+ * \brief Apply an operator to two constants, like the generated code would.
+ *
+ * \return false if the operation must be left to the generated code (mixing
+ * numbers and strings, or giving a non finite number).
+ */
+bool ApplyOperator(const ConstantValue& leftHandSide,
+                   gd::String::value_type op,
+                   const ConstantValue& rightHandSide,
+                   ConstantValue& result) {
+  if (leftHandSide.isString || rightHandSide.isString) {
+    if (op != '+' || !leftHandSide.isString || !rightHandSide.isString)
+      return false;
+
+    result.isString = true;
+    result.string = leftHandSide.string + rightHandSide.string;
+    return true;
+  }
+
+  double number = 0;
+  if (op == '+')
+    number = leftHandSide.number + rightHandSide.number;
+  else if (op == '-')
+    number = leftHandSide.number - rightHandSide.number;
+  else if (op == '*')
+    number = leftHandSide.number * rightHandSide.number;
+  else if (op == '/')
+    number = leftHandSide.number / rightHandSide.number;
+  else
+    return false;
+
+  if (!std::isfinite(number)) return false;
+
+  result.isString = false;
+  result.number = number;
+  return true;
+}
+
+/**
+ * \brief Return the shortest number literal giving back exactly the number.
+ */
+gd::String GenerateNumberCode(double number) {
+  char buffer[32];
+  for (int precision = 15; precision <= 17; ++precision) {
+    snprintf(buffer, sizeof(buffer), "%.*g", precision, number);
+    if (std::strtod(buffer, nullptr) == number) break;
+  }
+
+  // Negative numbers are put in parentheses so that they can be used as an
+  // operand of any operator (like in "2 - (-1)").
+  if (std::signbit(number)) return "(" + gd::String(buffer) + ")";
+  return buffer;
+}
+
+}  // namespace
+
+/**
+ * \brief Compute the value of an expression made only of literals, operators
+ * and pure functions.
+ *
+ * Only functions declared as pure (see gd::ExpressionMetadata::SetPure) are
+ * computed. The result of each node is stored, so that nodes are computed
+ * only once, even if the code generator asks for the value of the operands of
+ * a node which is not constant.
+ */
+class ExpressionCodeGenerator::ConstantEvaluator
+    : public ExpressionParser2NodeWorker {
+ public:
+  ConstantEvaluator(const gd::Platform& platform_,
+                    const gd::ObjectsContainersList& objectsContainersList_)
+      : platform(platform_),
+        objectsContainersList(objectsContainersList_),
+        isConstant(false){};
+  virtual ~ConstantEvaluator(){};
+
+  /**
+   * \brief Compute the value of the node, if constant.
+   * \return false if the node is not constant.
+   */
+  bool Evaluate(ExpressionNode& node, ConstantValue& result) {
+    auto it = evaluatedNodes.find(&node);
+    if (it == evaluatedNodes.end()) {
+      node.Visit(*this);
+      // Reset the state, so that a node is not considered as constant because
+      // the last operand it evaluated was constant.
+      const bool nodeIsConstant = isConstant;
+      isConstant = false;
+      it = evaluatedNodes
+               .emplace(&node, std::make_pair(nodeIsConstant, value))
+               .first;
+    }
+    if (!it->second.first) return false;
+
+    result = it->second.second;
+    return true;
+  }
+
+  /**
+   * \brief Return true if the node is the given number (with the same sign,
+   * even for 0).
+   */
+  bool IsNumber(ExpressionNode& node, double number) {
+    ConstantValue nodeValue;
+    return Evaluate(node, nodeValue) && !nodeValue.isString &&
+           nodeValue.number == number &&
+           std::signbit(nodeValue.number) == std::signbit(number);
+  }
+
+ protected:
+  void OnVisitSubExpressionNode(SubExpressionNode& node) override {
+    isConstant = Evaluate(*node.expression, value);
+  }
+  void OnVisitOperatorNode(OperatorNode& node) override {
+    isConstant = false;
+    if (node.op == '+' || node.op == '-') {
+      std::vector<ExpressionNode*> terms;
+      std::vector<gd::String::value_type> operators;
+      GetOperationsChain(node, terms, operators);
+
+      ConstantValue result;
+      if (!Evaluate(*terms[0], result)) return;
+      for (std::size_t i = 1; i < terms.size(); ++i) {
+        ConstantValue term;
+        if (!Evaluate(*terms[i], term) ||
+            !ApplyOperator(result, operators[i - 1], term, result))
+          return;
+      }
+
+      value = result;
+      isConstant = true;
+    } else if (node.op == '*' || node.op == '/') {
+      ConstantValue leftHandSide;
+      ConstantValue rightHandSide;
+      ConstantValue result;
+      if (!Evaluate(*node.leftHandSide, leftHandSide) ||
+          !Evaluate(*node.rightHandSide, rightHandSide) ||
+          !ApplyOperator(leftHandSide, node.op, rightHandSide, result))
+        return;
+
+      value = result;
+      isConstant = true;
+    }
+  }
+  void OnVisitUnaryOperatorNode(UnaryOperatorNode& node) override {
+    isConstant = false;
+    ConstantValue factor;
+    if (!Evaluate(*node.factor, factor) || factor.isString) return;
+
+    if (node.op == '-')
+      value.number = -factor.number;
+    else if (node.op == '+')
+      value.number = factor.number;
+    else
+      return;
+
+    value.isString = false;
+    isConstant = true;
+  }
+  void OnVisitNumberNode(NumberNode& node) override {
+    value.isString = false;
+    value.number = node.number.To<double>();
+    isConstant = std::isfinite(value.number);
+  }
+  void OnVisitTextNode(TextNode& node) override {
+    value.isString = true;
+    value.string = node.text;
+    isConstant = true;
+  }
+  void OnVisitVariableNode(VariableNode& node) override { isConstant = false; }
+  void OnVisitVariableAccessorNode(VariableAccessorNode& node) override {
+    isConstant = false;
+  }
+  void OnVisitVariableBracketAccessorNode(
+      VariableBracketAccessorNode& node) override {
+    isConstant = false;
+  }
+  void OnVisitIdentifierNode(IdentifierNode& node) override {
+    isConstant = false;
+  }
+  void OnVisitObjectFunctionNameNode(ObjectFunctionNameNode& node) override {
+    isConstant = false;
+  }
+  void OnVisitFunctionCallNode(FunctionCallNode& node) override {
+    isConstant = false;
+    if (!node.objectName.empty() || node.parameters.size() != 1) return;
+
+    const gd::ExpressionMetadata& metadata =
+        MetadataProvider::GetFunctionCallMetadata(
+            platform, objectsContainersList, node);
+    if (!metadata.IsPure() || metadata.HasCustomCodeGenerator() ||
+        metadata.GetParametersCount() != 1)
+      return;
+
+    ConstantValue parameter;
+    if (!Evaluate(*node.parameters[0], parameter) || parameter.isString)
+      return;
+
+    value.isString = false;
+    value.number = metadata.GetPureFunction()(parameter.number);
+    isConstant = std::isfinite(value.number);
+  }
+  void OnVisitEmptyNode(EmptyNode& node) override { isConstant = false; }
+
+ private:
+  const gd::Platform& platform;
+  const gd::ObjectsContainersList& objectsContainersList;
+  bool isConstant;
+  ConstantValue value;
+  std::unordered_map<const ExpressionNode*, std::pair<bool, ConstantValue>>
+      evaluatedNodes;
+};
+
+ExpressionCodeGenerator::ConstantEvaluator&
+ExpressionCodeGenerator::GetConstantEvaluator() {
+  if (!constantEvaluator)
+    constantEvaluator = std::make_shared<ConstantEvaluator>(
+        codeGenerator.GetPlatform(), codeGenerator.GetObjectsContainersList());
+
+  return *constantEvaluator;
+}
+
+bool ExpressionCodeGenerator::GenerateConstantCode(ExpressionNode& node) {
+  ConstantValue value;
+  if (!GetConstantEvaluator().Evaluate(node, value)) return false;
+
+  output += value.isString ? codeGenerator.ConvertToStringExplicit(value.string)
+                           : GenerateNumberCode(value.number);
+  return true;
+}
+
 void ExpressionCodeGenerator::OnVisitOperatorNode(OperatorNode& node) {
+  if (GenerateConstantCode(node)) return;
+
+  ConstantEvaluator& constantEvaluator = GetConstantEvaluator();
+  if (node.op == '+' || node.op == '-') {
+    std::vector<ExpressionNode*> terms;
+    std::vector<gd::String::value_type> operators;
+    GetOperationsChain(node, terms, operators);
+
+    // Compute the constant terms at the beginning of the chain (the rest can't
+    // be computed, as operations are done from left to right).
+    ConstantValue result;
+    std::size_t termIndex = 0;
+    if (constantEvaluator.Evaluate(*terms[0], result)) {
+      termIndex = 1;
+      ConstantValue term;
+      while (termIndex < terms.size() &&
+             constantEvaluator.Evaluate(*terms[termIndex], term) &&
+             ApplyOperator(result, operators[termIndex - 1], term, result))
+        termIndex++;
+    }
+
+    if (termIndex >= 2) {
+      output += result.isString
+                    ? codeGenerator.ConvertToStringExplicit(result.string)
+                    : GenerateNumberCode(result.number);
+    } else {
+      terms[0]->Visit(*this);
+      termIndex = 1;
+    }
+
+    for (; termIndex < terms.size(); ++termIndex) {
+      // Subtracting 0 does not change a number (adding 0 would change -0).
+      if (operators[termIndex - 1] == '-' &&
+          constantEvaluator.IsNumber(*terms[termIndex], 0))
+        continue;
+
+      output += " ";
+      output.push_back(operators[termIndex - 1]);
+      output += " ";
+      terms[termIndex]->Visit(*this);
+    }
+    return;
+  }
+
+  // Multiplying or dividing by 1 does not change a number.
+  if ((node.op == '*' || node.op == '/') &&
+      constantEvaluator.IsNumber(*node.rightHandSide, 1)) {
+    node.leftHandSide->Visit(*this);
+    return;
+  }
+  if (node.op == '*' && constantEvaluator.IsNumber(*node.leftHandSide, 1)) {
+    node.rightHandSide->Visit(*this);
+    return;
+  }
+
   node.leftHandSide->Visit(*this);
   output += " ";
   output.push_back(node.op);
@@ -99,6 +428,11 @@ void ExpressionCodeGenerator::OnVisitOperatorNode(OperatorNode& node) {
 
 void ExpressionCodeGenerator::OnVisitUnaryOperatorNode(
     UnaryOperatorNode& node) {
+  // Literals are kept as written (like "-(2)") as there is nothing to compute.
+  if (!dynamic_cast<NumberNode*>(node.factor.get()) &&
+      GenerateConstantCode(node))
+    return;
+
   output.push_back(node.op);
   output += "(";  // Add extra parenthesis to ensure that things like --2 are
                   // properly outputted as -(-2) (GDevelop don't have -- or ++
@@ -109,6 +443,11 @@ void ExpressionCodeGenerator::OnVisitUnaryOperatorNode(
 
 void ExpressionCodeGenerator::OnVisitSubExpressionNode(
     SubExpressionNode& node) {
+  if (!dynamic_cast<NumberNode*>(node.expression.get()) &&
+      !dynamic_cast<TextNode*>(node.expression.get()) &&
+      GenerateConstantCode(node))
+    return;
+
   output += "(";
   node.expression->Visit(*this);
   output += ")";
@@ -206,6 +545,7 @@ void ExpressionCodeGenerator::OnVisitVariableBracketAccessorNode(
   }
 
   ExpressionCodeGenerator generator("number|string", "", codeGenerator, context);
+  generator.constantEvaluator = constantEvaluator;
   node.expression->Visit(generator);
   output +=
       codeGenerator.GenerateVariableBracketAccessor(generator.GetOutput());
@@ -276,6 +616,8 @@ void ExpressionCodeGenerator::OnVisitIdentifierNode(IdentifierNode& node) {
 }
 
 void ExpressionCodeGenerator::OnVisitFunctionCallNode(FunctionCallNode& node) {
+  if (GenerateConstantCode(node)) return;
+
   auto type = gd::ExpressionTypeFinder::GetType(codeGenerator.GetPlatform(),
                                             codeGenerator.GetProjectScopedContainers(),
                                             rootType,
@@ -311,7 +653,7 @@ void ExpressionCodeGenerator::OnVisitFunctionCallNode(FunctionCallNode& node) {
 }
 
 gd::String ExpressionCodeGenerator::GenerateFreeFunctionCode(
-    const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+    const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
     const ExpressionMetadata& expressionMetadata) {
   codeGenerator.AddIncludeFiles(
       expressionMetadata.GetIncludeFiles());
@@ -332,7 +674,7 @@ gd::String ExpressionCodeGenerator::GenerateFreeFunctionCode(
 gd::String ExpressionCodeGenerator::GenerateObjectFunctionCode(
     const gd::String& type,
     const gd::String& objectName,
-    const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+    const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
     const ExpressionMetadata& expressionMetadata) {
   codeGenerator.AddIncludeFiles(
       expressionMetadata.GetIncludeFiles());
@@ -378,7 +720,7 @@ gd::String ExpressionCodeGenerator::GenerateBehaviorFunctionCode(
     const gd::String& type,
     const gd::String& objectName,
     const gd::String& behaviorName,
-    const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+    const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
     const ExpressionMetadata& expressionMetadata) {
   codeGenerator.AddIncludeFiles(
       expressionMetadata.GetIncludeFiles());
@@ -424,7 +766,7 @@ gd::String ExpressionCodeGenerator::GenerateBehaviorFunctionCode(
 }
 
 gd::String ExpressionCodeGenerator::GenerateParametersCodes(
-    const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+    const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
     const ExpressionMetadata& expressionMetadata,
     size_t initialParameterIndex) {
   size_t nonCodeOnlyParameterIndex = 0;
@@ -442,6 +784,7 @@ gd::String ExpressionCodeGenerator::GenerateParametersCodes(
                                               rootObjectName,
                                               *parameters[nonCodeOnlyParameterIndex].get());
         ExpressionCodeGenerator generator(parameterMetadata.GetType(), objectName, codeGenerator, context);
+        generator.constantEvaluator = constantEvaluator;
         parameters[nonCodeOnlyParameterIndex]->Visit(generator);
         parametersCode += generator.GetOutput();
       } else if (parameterMetadata.IsOptional()) {
@@ -475,7 +818,7 @@ gd::String ExpressionCodeGenerator::GenerateParametersCodes(
 }
 
 std::vector<gd::Expression> ExpressionCodeGenerator::PrintParameters(
-    const std::vector<std::unique_ptr<ExpressionNode>>& parameters) {
+    const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters) {
   // Printing parameters is only useful because custom code generator of
   // expression require to get the parameters of the expression as strings
   // (gd::Expression). Once the old ExpressionParser is removed, custom
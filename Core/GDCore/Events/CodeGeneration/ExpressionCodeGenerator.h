@@ -81,26 +81,35 @@ class GD_CORE_API ExpressionCodeGenerator : public ExpressionParser2NodeWorker {
 
  private:
   gd::String GenerateFreeFunctionCode(
-      const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+      const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
       const ExpressionMetadata& expressionMetadata);
   gd::String GenerateObjectFunctionCode(
       const gd::String& type,
       const gd::String& objectName,
-      const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+      const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
       const ExpressionMetadata& expressionMetadata);
   gd::String GenerateBehaviorFunctionCode(
       const gd::String& type,
       const gd::String& objectName,
       const gd::String& behaviorName,
-      const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+      const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
       const ExpressionMetadata& expressionMetadata);
   gd::String GenerateParametersCodes(
-      const std::vector<std::unique_ptr<ExpressionNode>>& parameters,
+      const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters,
       const ExpressionMetadata& expressionMetadata,
       size_t initialParameterIndex);
   gd::String GenerateDefaultValue(const gd::String& type);
+
+  /**
+   * \brief If the node is only made of literals, operators and pure functions,
+   * output its value (computed at generation time) and return true.
+   */
+  bool GenerateConstantCode(ExpressionNode& node);
+
+  class ConstantEvaluator;
+  ConstantEvaluator& GetConstantEvaluator();
   static std::vector<gd::Expression> PrintParameters(
-      const std::vector<std::unique_ptr<ExpressionNode>>& parameters);
+      const std::vector<ArenaUniquePtr<ExpressionNode>>& parameters);
 
   gd::String output;
   gd::String objectNameToUseForVariableAccessor;
@@ -108,6 +117,9 @@ class GD_CORE_API ExpressionCodeGenerator : public ExpressionParser2NodeWorker {
   EventsCodeGenerationContext& context;
   const gd::String rootType;
   const gd::String rootObjectName;
+  std::shared_ptr<ConstantEvaluator>
+      constantEvaluator;  ///< Shared with the generators of the operands, as
+                          ///< they generate the code of the same nodes.
 };
 
 }  // namespace gd
@@ -21,11 +21,7 @@ VariablesContainer BaseEvent::badLocalVariables;
 std::vector<gd::String> BaseEvent::emptyDependencies;
 gd::String BaseEvent::emptySourceFile;
 
-BaseEvent::BaseEvent()
-    : totalTimeDuringLastSession(0),
-      percentDuringLastSession(0),
-      disabled(false),
-      folded(false) {}
+BaseEvent::BaseEvent() : disabled(false), folded(false) {}
 
 bool BaseEvent::HasSubEvents() const { return !GetSubEvents().IsEmpty(); }
 
@@ -39,31 +35,10 @@ gd::String BaseEvent::GenerateEventCode(
   try {
     if (type.empty()) return "";
 
-    const gd::Platform& platform = codeGenerator.GetPlatform();
-
-    // First try to guess the extension used
-    gd::String eventNamespace = type.substr(0, type.find("::"));
-    std::shared_ptr<gd::PlatformExtension> guessedExtension =
-        platform.GetExtension(eventNamespace);
-    if (guessedExtension) {
-      std::map<gd::String, gd::EventMetadata>& allEvents =
-          guessedExtension->GetAllEvents();
-      if (allEvents.find(type) != allEvents.end())
-        return allEvents[type].codeGeneration(*this, codeGenerator, context);
-    }
-
-    // Else make a search in all the extensions
-    for (std::size_t i = 0; i < platform.GetAllPlatformExtensions().size();
-         ++i) {
-      std::shared_ptr<gd::PlatformExtension> extension =
-          platform.GetAllPlatformExtensions()[i];
-      if (!extension) continue;
-
-      std::map<gd::String, gd::EventMetadata>& allEvents =
-          extension->GetAllEvents();
-      if (allEvents.find(type) != allEvents.end())
-        return allEvents[type].codeGeneration(*this, codeGenerator, context);
-    }
+    gd::EventMetadata* eventMetadata =
+        codeGenerator.GetPlatform().GetEventMetadata(type);
+    if (eventMetadata)
+      return eventMetadata->codeGeneration(*this, codeGenerator, context);
   } catch (...) {
     std::cout << "ERROR: Exception caught during code generation for event \""
               << type << "\"." << std::endl;
@@ -78,7 +53,7 @@ void BaseEvent::PreprocessAsyncActions(const gd::Platform& platform) {
     for (std::size_t aId = 0; aId < actionsList->size(); ++aId) {
       const auto& action = actionsList->at(aId);
       const gd::InstructionMetadata& actionMetadata =
-          gd::MetadataProvider::GetActionMetadata(platform, action.GetType());
+          gd::MetadataProvider::GetActionMetadata(platform, action.GetInternedType());
       if (actionMetadata.IsAsync() &&
           (!actionMetadata.IsOptionallyAsync() || action.IsAwaited())) {
         gd::InstructionsList remainingActions;
@@ -111,33 +86,11 @@ void BaseEvent::Preprocess(gd::EventsCodeGenerator& codeGenerator,
   try {
     if (type.empty()) return;
 
-    const gd::Platform& platform = codeGenerator.GetPlatform();
-
-    // First try to guess the extension used
-    gd::String eventNamespace = type.substr(0, type.find("::"));
-    std::shared_ptr<gd::PlatformExtension> guessedExtension =
-        platform.GetExtension(eventNamespace);
-    if (guessedExtension) {
-      std::map<gd::String, gd::EventMetadata>& allEvents =
-          guessedExtension->GetAllEvents();
-      if (allEvents.find(type) != allEvents.end())
-        return allEvents[type].preprocessing(
-            *this, codeGenerator, eventList, indexOfTheEventInThisList);
-    }
-
-    // Else make a search in all the extensions
-    for (std::size_t i = 0; i < platform.GetAllPlatformExtensions().size();
-         ++i) {
-      std::shared_ptr<gd::PlatformExtension> extension =
-          platform.GetAllPlatformExtensions()[i];
-      if (!extension) continue;
-
-      std::map<gd::String, gd::EventMetadata>& allEvents =
-          extension->GetAllEvents();
-      if (allEvents.find(type) != allEvents.end())
-        return allEvents[type].preprocessing(
-            *this, codeGenerator, eventList, indexOfTheEventInThisList);
-    }
+    gd::EventMetadata* eventMetadata =
+        codeGenerator.GetPlatform().GetEventMetadata(type);
+    if (eventMetadata)
+      return eventMetadata->preprocessing(
+          *this, codeGenerator, eventList, indexOfTheEventInThisList);
   } catch (...) {
     std::cout << "ERROR: Exception caught during preprocessing of event \""
               << type << "\"." << std::endl;
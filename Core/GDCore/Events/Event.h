@@ -312,12 +312,6 @@ class GD_CORE_API BaseEvent {
       originalEvent;  ///< Pointer only used for profiling events, so as to
                       ///< remember the original event from which it has been
                       ///< copied.
-  signed long long
-      totalTimeDuringLastSession;  ///< Total time, in microseconds, used by the
-                                   ///< event during the last run. Used for
-                                   ///< profiling.
-  float percentDuringLastSession;  ///< Total time used by the event during the
-                                   ///< last run. Used for profiling.
 
  private:
   bool folded;  ///< True if the subevents should be hidden in the events editor
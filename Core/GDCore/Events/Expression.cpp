@@ -6,36 +6,218 @@
 
 #include "GDCore/Events/Expression.h"
 
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodeSerializer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/Arena.h"
+#include "GDCore/Tools/VersionWrapper.h"
 
 namespace gd {
 
-Expression::Expression() : node(nullptr) {};
+/**
+ * \brief A parsed expression, with its nodes allocated from an arena.
+ */
+struct Expression::Tree {
+  // Most expressions are small: use small blocks to avoid wasting memory.
+  Tree() : arena(1024){};
+
+  gd::Arena arena;  ///< Must be declared before (so destroyed after) the node.
+  gd::ArenaUniquePtr<gd::ExpressionNode> node;
+};
+
+/**
+ * \brief The trees shared by expressions, and the trees loaded from a cache
+ * (see Expression::LoadTreesCache) not used yet.
+ */
+struct Expression::TreesRegistry {
+  TreesRegistry() : nextCleanupSize(1024){};
+
+  std::mutex mutex;
+  // Trees are only referenced weakly, so that they are destroyed with the
+  // last expression using them.
+  std::unordered_map<std::string, std::weak_ptr<Tree>> trees;
+  std::size_t nextCleanupSize;
+  std::unordered_map<std::string, std::string> serializedTrees;
+};
+
+namespace {
+// Must be changed when the serialization of the trees is changed.
+const char* treesCacheFormat = "GDExpressionTrees1";
+}  // namespace
+
+Expression::Expression() {};
 
 Expression::Expression(gd::String plainString_)
-    : node(nullptr), plainString(plainString_) {};
+    : plainString(plainString_) {};
 
 Expression::Expression(const char* plainString_)
-    : node(nullptr), plainString(plainString_) {};
+    : plainString(plainString_) {};
 
 Expression::Expression(const Expression& copy)
-    : node(nullptr), plainString{copy.plainString} {};
+    : plainString{copy.plainString}, tree(copy.tree) {};
 
 Expression& Expression::operator=(const Expression& expression) {
   plainString = expression.plainString;
-  node = nullptr;
+  tree = expression.tree;
   return *this;
 };
 
 Expression::~Expression(){};
 
 ExpressionNode* Expression::GetRootNode() const {
-  if (!node) {
-    gd::ExpressionParser2 parser = ExpressionParser2();
-    node = std::move(parser.ParseExpression(plainString));
+  if (!tree) tree = GetTree(plainString);
+  return tree->node.get();
+}
+
+Expression::TreesRegistry& Expression::GetTreesRegistry() {
+  static TreesRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<Expression::Tree> Expression::GetTree(
+    const gd::String& plainString) {
+  auto& registry = GetTreesRegistry();
+
+  std::string serializedTree;
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.trees.find(plainString.Raw());
+    if (it != registry.trees.end()) {
+      auto existingTree = it->second.lock();
+      if (existingTree) return existingTree;
+    }
+
+    auto serializedTreeIt = registry.serializedTrees.find(plainString.Raw());
+    if (serializedTreeIt != registry.serializedTrees.end()) {
+      serializedTree = std::move(serializedTreeIt->second);
+      registry.serializedTrees.erase(serializedTreeIt);
+    }
+  }
+
+  auto newTree = std::make_shared<Tree>();
+  if (!serializedTree.empty()) {
+    std::size_t position = 0;
+    newTree->node = gd::ExpressionParser2NodeSerializer::UnserializeNode(
+        serializedTree, position, &newTree->arena);
+    if (!newTree->node || position != serializedTree.size()) {
+      // Discard the nodes read from the malformed tree, and parse instead.
+      newTree = std::make_shared<Tree>();
+    }
+  }
+  if (!newTree->node) {
+    gd::ExpressionParser2 parser;
+    newTree->node = parser.ParseExpression(plainString, &newTree->arena);
+  }
+
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto& cachedTree = registry.trees[plainString.Raw()];
+  auto existingTree = cachedTree.lock();
+  if (existingTree) return existingTree;  // Parsed by another thread.
+
+  cachedTree = newTree;
+  if (registry.trees.size() >= registry.nextCleanupSize) {
+    for (auto it = registry.trees.begin(); it != registry.trees.end();) {
+      if (it->second.expired())
+        it = registry.trees.erase(it);
+      else
+        ++it;
+    }
+    registry.nextCleanupSize =
+        std::max<std::size_t>(1024, registry.trees.size() * 2);
+  }
+
+  return newTree;
+}
+
+std::string Expression::GetTreesCacheVersion(const gd::String& language) {
+  // The trees depend on the parser, and on the metadata and translations of
+  // the diagnostics, which come with each version of GDevelop.
+  return gd::String::From(gd::ExpressionParser2::GetVersion()).Raw() + "/" +
+         gd::VersionWrapper::FullString().Raw() + "/" + language.Raw();
+}
+
+std::string Expression::SaveTreesCache(const gd::String& language) {
+  auto& registry = GetTreesRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::size_t treesCount = 0;
+  std::string serializedTrees;
+  std::string serializedTree;
+  for (const auto& it : registry.trees) {
+    auto tree = it.second.lock();
+    if (!tree || !tree->node) continue;
+
+    serializedTree.clear();
+    gd::ExpressionParser2NodeSerializer::SerializeNode(*tree->node,
+                                                      serializedTree);
+    gd::ExpressionParser2NodeSerializer::WriteString(it.first,
+                                                     serializedTrees);
+    gd::ExpressionParser2NodeSerializer::WriteString(serializedTree,
+                                                     serializedTrees);
+    treesCount++;
   }
-  return node.get();
+  for (const auto& it : registry.serializedTrees) {
+    auto treeIt = registry.trees.find(it.first);
+    if (treeIt != registry.trees.end() && !treeIt->second.expired()) continue;
+
+    gd::ExpressionParser2NodeSerializer::WriteString(it.first,
+                                                     serializedTrees);
+    gd::ExpressionParser2NodeSerializer::WriteString(it.second,
+                                                     serializedTrees);
+    treesCount++;
+  }
+
+  std::string cache;
+  gd::ExpressionParser2NodeSerializer::WriteString(treesCacheFormat, cache);
+  gd::ExpressionParser2NodeSerializer::WriteString(
+      GetTreesCacheVersion(language), cache);
+  gd::ExpressionParser2NodeSerializer::WriteSize(treesCount, cache);
+  cache += serializedTrees;
+  return cache;
+}
+
+bool Expression::LoadTreesCache(const std::string& cache,
+                                const gd::String& language) {
+  std::size_t position = 0;
+  std::string cacheFormat;
+  std::string cacheVersion;
+  std::size_t treesCount = 0;
+  if (!gd::ExpressionParser2NodeSerializer::ReadString(
+          cache, position, cacheFormat) ||
+      cacheFormat != treesCacheFormat ||
+      !gd::ExpressionParser2NodeSerializer::ReadString(
+          cache, position, cacheVersion) ||
+      cacheVersion != GetTreesCacheVersion(language) ||
+      !gd::ExpressionParser2NodeSerializer::ReadSize(
+          cache, position, treesCount))
+    return false;
+
+  // Trees are only read when used, so just split the cache here.
+  std::unordered_map<std::string, std::string> serializedTrees;
+  for (std::size_t i = 0; i < treesCount; ++i) {
+    std::string plainString;
+    std::string serializedTree;
+    if (!gd::ExpressionParser2NodeSerializer::ReadString(
+            cache, position, plainString) ||
+        !gd::ExpressionParser2NodeSerializer::ReadString(
+            cache, position, serializedTree))
+      return false;
+
+    serializedTrees[std::move(plainString)] = std::move(serializedTree);
+  }
+  if (position != cache.size()) return false;
+
+  auto& registry = GetTreesRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& it : serializedTrees)
+    registry.serializedTrees[it.first] = std::move(it.second);
+
+  return true;
 }
 
 }  // namespace gd
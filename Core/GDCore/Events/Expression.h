@@ -9,6 +9,7 @@
 
 #include "GDCore/String.h"
 #include <memory>
+#include <string>
 
 namespace gd {
 class ExpressionParser2;
@@ -61,6 +62,12 @@ class GD_CORE_API Expression {
 
   /**
    * @brief Get the expression node.
+   *
+   * The expression is parsed on the first call. The tree is shared by all the
+   * expressions having the same plain string, so that each distinct
+   * expression is only parsed once: it must **not** be modified. To modify a
+   * tree (for example when refactoring), parse the expression with
+   * gd::ExpressionParser2 instead.
    * @return std::unique_ptr<gd::ExpressionNode>
    */
   gd::ExpressionNode* GetRootNode() const;
@@ -72,9 +79,42 @@ class GD_CORE_API Expression {
 
   virtual ~Expression();
 
+  /**
+   * \brief Save the trees of the expressions parsed so far (and the trees
+   * loaded but not used yet), so that they can be stored next to the project
+   * and loaded with LoadTreesCache instead of parsing again the expressions.
+   *
+   * The cache is only loaded by the same version of GDevelop, with the same
+   * version of the parser (see gd::ExpressionParser2::GetVersion).
+   *
+   * \param language The language of the diagnostics of the trees (which are
+   * translated), so that they are not loaded for another language.
+   */
+  static std::string SaveTreesCache(const gd::String& language);
+
+  /**
+   * \brief Load trees saved with SaveTreesCache. GetRootNode will use them,
+   * instead of parsing, for the expressions having the same plain string.
+   *
+   * \return false if the cache was saved with another version (of GDevelop
+   * or of the parser) or language, or is malformed, in which case nothing is
+   * loaded.
+   */
+  static bool LoadTreesCache(const std::string& cache,
+                             const gd::String& language);
+
  private:
+  struct Tree;
+  struct TreesRegistry;
+
+  static TreesRegistry& GetTreesRegistry();
+  static std::string GetTreesCacheVersion(const gd::String& language);
+  static std::shared_ptr<Tree> GetTree(const gd::String& plainString);
+
   gd::String plainString;  ///< The expression string
-  mutable std::unique_ptr<gd::ExpressionNode> node;
+  mutable std::shared_ptr<Tree>
+      tree;  ///< The parsed expression, shared with the other expressions
+             ///< having the same plain string.
 };
 
 }  // namespace gd
@@ -18,14 +18,17 @@ namespace gd {
 
 gd::Expression Instruction::badExpression("");
 
-Instruction::Instruction(gd::String type_) : type(type_), inverted(false) {
+Instruction::Instruction(gd::String type_)
+    : type(gd::InternedString(type_)), inverted(false) {
   parameters.reserve(8);
 }
 
 Instruction::Instruction(gd::String type_,
                          const std::vector<gd::Expression>& parameters_,
                          bool inverted_)
-    : type(type_), inverted(inverted_), parameters(parameters_) {
+    : type(gd::InternedString(type_)),
+      inverted(inverted_),
+      parameters(parameters_) {
   parameters.reserve(8);
 }
 
@@ -11,6 +11,7 @@
 #include "GDCore/Events/Expression.h"
 #include "GDCore/Events/InstructionsList.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/InternedString.h"
 
 namespace gd {
 
@@ -52,13 +53,21 @@ class GD_CORE_API Instruction {
    * \brief Return the type of the instruction.
    * \return The type of the instruction
    */
-  const gd::String& GetType() const { return type; }
+  const gd::String& GetType() const { return type.GetString(); }
+
+  /**
+   * \brief Return the type of the instruction, as an interned string (faster
+   * to compare and to hash).
+   */
+  const gd::InternedString& GetInternedType() const { return type; }
 
   /**
    * \brief Change the instruction type
    * \param val The new type of the instruction
    */
-  void SetType(const gd::String& newType) { type = newType; }
+  void SetType(const gd::String& newType) {
+    type = gd::InternedString(newType);
+  }
 
   /**
    * \brief Return true if the condition is inverted
@@ -168,7 +177,7 @@ class GD_CORE_API Instruction {
       std::shared_ptr<Instruction> instruction);
 
  private:
-  gd::String type;  ///< Instruction type
+  gd::InternedString type;  ///< Instruction type
   bool inverted;  ///< True if the instruction if inverted. Only applicable for
                   ///< instruction used as conditions by events
   bool awaitAsync =
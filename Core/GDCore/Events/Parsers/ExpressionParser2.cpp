@@ -6,7 +6,10 @@
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "GDCore/CommonTools.h"
@@ -29,14 +32,238 @@ namespace gd {
 gd::String ExpressionParser2::NAMESPACE_SEPARATOR = "::";
 
 ExpressionParser2::ExpressionParser2()
-    : expression(""),
-      currentPosition(0) {}
+    : expression(),
+      currentPosition(0),
+      arena(nullptr),
+      editStartPosition(0),
+      editPreviousEndPosition(0),
+      editEndPosition(0) {}
 
-std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
+namespace {
+
+/**
+ * \brief Find the nodes of a tree that can be reused when parsing the
+ * expression after an edit, with the pointers owning them.
+ *
+ * Only the nodes read by the grammar as a factor can be reused. Nodes with an
+ * error are excluded, as the error can come from the parent of the node.
+ */
+class ReusableNodesFinder : public ExpressionParser2NodeWorker {
+ public:
+  ReusableNodesFinder(
+      std::unordered_map<size_t, ArenaUniquePtr<ExpressionNode> *>
+          &reusableNodes_)
+      : reusableNodes(reusableNodes_){};
+  virtual ~ReusableNodesFinder(){};
+
+  void FindIn(ArenaUniquePtr<ExpressionNode> &node) {
+    if (!node) return;
+
+    ExpressionNode *rawNode = node.get();
+    if (!rawNode->diagnostic && rawNode->location.IsValid() &&
+        (dynamic_cast<FunctionCallNode *>(rawNode) ||
+         dynamic_cast<VariableNode *>(rawNode) ||
+         dynamic_cast<IdentifierNode *>(rawNode) ||
+         dynamic_cast<NumberNode *>(rawNode) ||
+         dynamic_cast<TextNode *>(rawNode))) {
+      // Parents are found before their children, so they are preferred.
+      reusableNodes.emplace(rawNode->location.GetStartPosition(), &node);
+    }
+
+    rawNode->Visit(*this);
+  }
+
+ protected:
+  void OnVisitSubExpressionNode(SubExpressionNode &node) override {
+    FindIn(node.expression);
+  }
+  void OnVisitOperatorNode(OperatorNode &node) override {
+    FindIn(node.leftHandSide);
+    FindIn(node.rightHandSide);
+  }
+  void OnVisitUnaryOperatorNode(UnaryOperatorNode &node) override {
+    FindIn(node.factor);
+  }
+  void OnVisitNumberNode(NumberNode &node) override {}
+  void OnVisitTextNode(TextNode &node) override {}
+  void OnVisitVariableNode(VariableNode &node) override {
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitVariableAccessorNode(VariableAccessorNode &node) override {
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitVariableBracketAccessorNode(
+      VariableBracketAccessorNode &node) override {
+    FindIn(node.expression);
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitIdentifierNode(IdentifierNode &node) override {}
+  void OnVisitObjectFunctionNameNode(ObjectFunctionNameNode &node) override {}
+  void OnVisitFunctionCallNode(FunctionCallNode &node) override {
+    for (auto &parameter : node.parameters) FindIn(parameter);
+  }
+  void OnVisitEmptyNode(EmptyNode &node) override {}
+
+ private:
+  std::unordered_map<size_t, ArenaUniquePtr<ExpressionNode> *>
+      &reusableNodes;
+};
+
+/**
+ * \brief Move the locations of all the nodes of a tree (and their errors) by
+ * an offset.
+ */
+class LocationsShifter : public ExpressionParser2NodeWorker {
+ public:
+  LocationsShifter(std::ptrdiff_t offset_) : offset(offset_){};
+  virtual ~LocationsShifter(){};
+
+ protected:
+  void OnVisitSubExpressionNode(SubExpressionNode &node) override {
+    ShiftNode(node);
+    node.expression->Visit(*this);
+  }
+  void OnVisitOperatorNode(OperatorNode &node) override {
+    ShiftNode(node);
+    node.leftHandSide->Visit(*this);
+    node.rightHandSide->Visit(*this);
+  }
+  void OnVisitUnaryOperatorNode(UnaryOperatorNode &node) override {
+    ShiftNode(node);
+    node.factor->Visit(*this);
+  }
+  void OnVisitNumberNode(NumberNode &node) override { ShiftNode(node); }
+  void OnVisitTextNode(TextNode &node) override { ShiftNode(node); }
+  void OnVisitVariableNode(VariableNode &node) override {
+    ShiftNode(node);
+    Shift(node.nameLocation);
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitVariableAccessorNode(VariableAccessorNode &node) override {
+    ShiftNode(node);
+    Shift(node.nameLocation);
+    Shift(node.dotLocation);
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitVariableBracketAccessorNode(
+      VariableBracketAccessorNode &node) override {
+    ShiftNode(node);
+    node.expression->Visit(*this);
+    if (node.child) node.child->Visit(*this);
+  }
+  void OnVisitIdentifierNode(IdentifierNode &node) override {
+    ShiftNode(node);
+    Shift(node.identifierNameLocation);
+    Shift(node.identifierNameDotLocation);
+    Shift(node.childIdentifierNameLocation);
+  }
+  void OnVisitObjectFunctionNameNode(ObjectFunctionNameNode &node) override {
+    ShiftNode(node);
+    Shift(node.objectNameLocation);
+    Shift(node.objectNameDotLocation);
+    Shift(node.objectFunctionOrBehaviorNameLocation);
+    Shift(node.behaviorNameNamespaceSeparatorLocation);
+    Shift(node.behaviorFunctionNameLocation);
+  }
+  void OnVisitFunctionCallNode(FunctionCallNode &node) override {
+    ShiftNode(node);
+    Shift(node.functionNameLocation);
+    Shift(node.objectNameLocation);
+    Shift(node.objectNameDotLocation);
+    Shift(node.behaviorNameLocation);
+    Shift(node.behaviorNameNamespaceSeparatorLocation);
+    Shift(node.openingParenthesisLocation);
+    Shift(node.closingParenthesisLocation);
+    for (auto &parameter : node.parameters) parameter->Visit(*this);
+  }
+  void OnVisitEmptyNode(EmptyNode &node) override { ShiftNode(node); }
+
+ private:
+  void ShiftNode(ExpressionNode &node) {
+    Shift(node.location);
+    if (node.diagnostic) {
+      ExpressionParserLocation location = node.diagnostic->GetLocation();
+      Shift(location);
+      node.diagnostic->SetLocation(location);
+    }
+  }
+
+  void Shift(ExpressionParserLocation &location) {
+    if (!location.IsValid()) return;
+
+    location = ExpressionParserLocation(location.GetStartPosition() + offset,
+                                        location.GetEndPosition() + offset);
+  }
+
+  std::ptrdiff_t offset;
+};
+
+}  // namespace
+
+ArenaUniquePtr<ExpressionNode> ExpressionParser2::ParseExpressionAfterEdit(
+    const gd::String &expression_,
+    ArenaUniquePtr<ExpressionNode> previousRootNode,
+    size_t editPosition,
+    size_t removedLength,
+    size_t insertedLength) {
+  editStartPosition = editPosition;
+  editPreviousEndPosition = editPosition + removedLength;
+  editEndPosition = editPosition + insertedLength;
+
+  // Nodes of a tree allocated from an arena can't outlive it, so they can't be
+  // moved to the new tree.
+  assert(!previousRootNode || !previousRootNode->IsAllocatedFromArena());
+  if (previousRootNode && previousRootNode->IsAllocatedFromArena())
+    return ParseExpression(expression_);
+
+  ReusableNodesFinder finder(reusableNodes);
+  finder.FindIn(previousRootNode);
+
+  auto node = ParseExpression(expression_);
+  reusableNodes.clear();
+  return node;
+}
+
+ArenaUniquePtr<ExpressionNode> ExpressionParser2::ReuseNode() {
+  size_t position = GetCurrentPosition();
+  size_t previousPosition;
+  if (position < editStartPosition)
+    previousPosition = position;
+  else if (position >= editEndPosition)
+    previousPosition = position - editEndPosition + editPreviousEndPosition;
+  else
+    return nullptr;  // The node starts in the edited span.
+
+  auto it = reusableNodes.find(previousPosition);
+  if (it == reusableNodes.end() || !*it->second) return nullptr;
+
+  // Reading a node can look up to 2 characters after it (for a namespace
+  // separator): they must not be edited either.
+  ArenaUniquePtr<ExpressionNode> &previousNode = *it->second;
+  if (previousPosition < editStartPosition &&
+      previousNode->location.GetEndPosition() + 2 > editStartPosition)
+    return nullptr;
+
+  ArenaUniquePtr<ExpressionNode> node = std::move(previousNode);
+  reusableNodes.erase(it);
+
+  std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(position) -
+                          static_cast<std::ptrdiff_t>(previousPosition);
+  if (offset != 0) {
+    LocationsShifter shifter(offset);
+    node->Visit(shifter);
+  }
+
+  node->parent = nullptr;
+  currentPosition = node->location.GetEndPosition();
+  return node;
+}
+
+ArenaUniquePtr<TextNode> ExpressionParser2::ReadText() {
   size_t textStartPosition = GetCurrentPosition();
   SkipAllWhitespaces();
   if (!CheckIfChar(IsQuote)) {
-    auto text = gd::make_unique<TextNode>("");
+    auto text = MakeUnique<TextNode>("");
 	  // It can't happen.
     text->diagnostic =
         RaiseSyntaxError(_("A text must start with a double quote (\")."));
@@ -75,7 +302,7 @@ std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
     currentPosition++;
   }
 
-  auto text = gd::make_unique<TextNode>(parsedText);
+  auto text = MakeUnique<TextNode>(parsedText);
   text->location =
       ExpressionParserLocation(textStartPosition, GetCurrentPosition());
   if (!textParsingHasEnded) {
@@ -87,7 +314,7 @@ std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
   return text;
 }
 
-std::unique_ptr<NumberNode> ExpressionParser2::ReadNumber() {
+ArenaUniquePtr<NumberNode> ExpressionParser2::ReadNumber() {
   size_t numberStartPosition = GetCurrentPosition();
   SkipAllWhitespaces();
   gd::String parsedNumber;
@@ -131,7 +358,7 @@ std::unique_ptr<NumberNode> ExpressionParser2::ReadNumber() {
   // Note that parsedNumber can finish by a dot (1., 2., 0.). This is
   // valid in most languages so we allow this.
 
-  auto number = gd::make_unique<NumberNode>(parsedNumber);
+  auto number = MakeUnique<NumberNode>(parsedNumber);
   number->location =
       ExpressionParserLocation(numberStartPosition, GetCurrentPosition());
   if (!numberHasStarted || !digitFound) {
@@ -6,7 +6,10 @@
 #ifndef GDCORE_EXPRESSIONPARSER2_H
 #define GDCORE_EXPRESSIONPARSER2_H
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,17 +53,53 @@ class GD_CORE_API ExpressionParser2 {
    * Parse the given expression into a tree of nodes.
    *
    * \param expression The expression to parse.
+   * \param arena If not null, the arena from which the nodes (and their
+   * errors) are allocated. It must outlive the returned tree.
    *
    * \return The node representing the expression as a parsed tree.
    */
-  std::unique_ptr<ExpressionNode> ParseExpression(
-      const gd::String &expression_) {
-    expression = expression_;
+  ArenaUniquePtr<ExpressionNode> ParseExpression(
+      const gd::String &expression_, gd::Arena *arena_ = nullptr) {
+    // Decode the expression once, so that characters are then read in
+    // constant time using their position (which is also used for locations).
+    expression.clear();
+    expression.reserve(expression_.Raw().size());
+    for (auto character : expression_) expression.push_back(character);
 
     currentPosition = 0;
-    return Start();
+    arena = arena_;
+    auto node = Start();
+    arena = nullptr;
+    return node;
   }
 
+  /**
+   * Parse the given expression after it was edited, reusing the nodes of the
+   * tree of the expression before the edit that are not affected by it.
+   *
+   * Function calls, variables, identifiers, numbers and texts outside of the
+   * edited span are moved to the new tree (with their locations updated)
+   * instead of being parsed again. The resulting tree is the same as the one
+   * returned by ParseExpression.
+   *
+   * \param expression The expression to parse (after the edit).
+   * \param previousRootNode The tree of the expression before the edit. Its
+   * nodes are moved to the new tree, so it must not be used anymore. It must
+   * not be allocated from an arena (this is asserted, and the expression is
+   * then entirely parsed again).
+   * \param editPosition The position of the edit.
+   * \param removedLength The number of characters removed by the edit.
+   * \param insertedLength The number of characters inserted by the edit.
+   *
+   * \return The node representing the expression as a parsed tree.
+   */
+  ArenaUniquePtr<ExpressionNode> ParseExpressionAfterEdit(
+      const gd::String &expression_,
+      ArenaUniquePtr<ExpressionNode> previousRootNode,
+      size_t editPosition,
+      size_t removedLength,
+      size_t insertedLength);
+
   /**
    * Given an object name (or empty if none) and a behavior name (or empty if
    * none), return the index of the first parameter that is inside the
@@ -77,18 +116,27 @@ class GD_CORE_API ExpressionParser2 {
     return !behaviorName.empty() ? 2 : (!objectName.empty() ? 1 : 0);
   }
 
+  /**
+   * Return the version of the parser. It must be increased when the trees
+   * built by the parser (their nodes, locations or diagnostics) are changed,
+   * so that the trees saved by a previous version are not used.
+   *
+   * \see gd::Expression::SaveTreesCache
+   */
+  static int GetVersion() { return 1; }
+
  private:
   /** \name Grammar
    * Each method is a part of the grammar.
    */
   ///@{
-  std::unique_ptr<ExpressionNode> Start() {
+  ArenaUniquePtr<ExpressionNode> Start() {
     size_t expressionStartPosition = GetCurrentPosition();
     auto expression = Expression();
 
     // Check for extra characters at the end of the expression
     if (!IsEndReached()) {
-      auto op = gd::make_unique<OperatorNode>(' ');
+      auto op = MakeUnique<OperatorNode>(' ');
       op->leftHandSide = std::move(expression);
       op->rightHandSide = ReadUntilEnd();
       op->rightHandSide->parent = op.get();
@@ -105,18 +153,18 @@ class GD_CORE_API ExpressionParser2 {
     return expression;
   }
 
-  std::unique_ptr<ExpressionNode> Expression() {
+  ArenaUniquePtr<ExpressionNode> Expression() {
     SkipAllWhitespaces();
 
     size_t expressionStartPosition = GetCurrentPosition();
-    std::unique_ptr<ExpressionNode> leftHandSide = Term();
+    ArenaUniquePtr<ExpressionNode> leftHandSide = Term();
 
     SkipAllWhitespaces();
 
     if (IsEndReached()) return leftHandSide;
     if (CheckIfChar(IsExpressionEndingChar)) return leftHandSide;
     if (CheckIfChar(IsExpressionOperator)) {
-      auto op = gd::make_unique<OperatorNode>(GetCurrentChar());
+      auto op = MakeUnique<OperatorNode>(GetCurrentChar());
       op->leftHandSide = std::move(leftHandSide);
       op->leftHandSide->parent = op.get();
       op->diagnostic = ValidateOperator(GetCurrentChar());
@@ -133,7 +181,7 @@ class GD_CORE_API ExpressionParser2 {
         "More than one term was found. Verify that your expression is "
         "properly written.");
 
-    auto op = gd::make_unique<OperatorNode>(' ');
+    auto op = MakeUnique<OperatorNode>(' ');
     op->leftHandSide = std::move(leftHandSide);
     op->leftHandSide->parent = op.get();
     op->rightHandSide = Expression();
@@ -143,11 +191,11 @@ class GD_CORE_API ExpressionParser2 {
     return std::move(op);
   }
 
-  std::unique_ptr<ExpressionNode> Term() {
+  ArenaUniquePtr<ExpressionNode> Term() {
     SkipAllWhitespaces();
 
     size_t expressionStartPosition = GetCurrentPosition();
-    std::unique_ptr<ExpressionNode> factor = Factor();
+    ArenaUniquePtr<ExpressionNode> factor = Factor();
 
     SkipAllWhitespaces();
 
@@ -155,7 +203,7 @@ class GD_CORE_API ExpressionParser2 {
     // to guarantee the proper operator precedence. (Expression could also
     // be reworked to use a while loop).
     while (CheckIfChar(IsTermOperator)) {
-      auto op = gd::make_unique<OperatorNode>(GetCurrentChar());
+      auto op = MakeUnique<OperatorNode>(GetCurrentChar());
       op->leftHandSide = std::move(factor);
       op->leftHandSide->parent = op.get();
       op->diagnostic = ValidateOperator(GetCurrentChar());
@@ -172,12 +220,17 @@ class GD_CORE_API ExpressionParser2 {
     return factor;
   };
 
-  std::unique_ptr<ExpressionNode> Factor() {
+  ArenaUniquePtr<ExpressionNode> Factor() {
     SkipAllWhitespaces();
+    if (!reusableNodes.empty()) {
+      ArenaUniquePtr<ExpressionNode> reusedNode = ReuseNode();
+      if (reusedNode) return reusedNode;
+    }
+
     size_t expressionStartPosition = GetCurrentPosition();
 
     if (CheckIfChar(IsQuote)) {
-      std::unique_ptr<ExpressionNode> factor = ReadText();
+      ArenaUniquePtr<ExpressionNode> factor = ReadText();
       return factor;
     } else if (CheckIfChar(IsUnaryOperator)) {
       auto unaryOperatorCharacter = GetCurrentChar();
@@ -185,7 +238,7 @@ class GD_CORE_API ExpressionParser2 {
 
       auto operatorOperand = Factor();
 
-      auto unaryOperator = gd::make_unique<UnaryOperatorNode>(
+      auto unaryOperator = MakeUnique<UnaryOperatorNode>(
           unaryOperatorCharacter);
       unaryOperator->diagnostic = ValidateUnaryOperator(
           unaryOperatorCharacter, expressionStartPosition);
@@ -196,11 +249,11 @@ class GD_CORE_API ExpressionParser2 {
 
       return std::move(unaryOperator);
     } else if (CheckIfChar(IsNumberFirstChar)) {
-      std::unique_ptr<ExpressionNode> factor = ReadNumber();
+      ArenaUniquePtr<ExpressionNode> factor = ReadNumber();
       return factor;
     } else if (CheckIfChar(IsOpeningParenthesis)) {
       SkipChar();
-      std::unique_ptr<ExpressionNode> factor = SubExpression();
+      ArenaUniquePtr<ExpressionNode> factor = SubExpression();
 
       if (!CheckIfChar(IsClosingParenthesis)) {
         factor->diagnostic =
@@ -213,24 +266,24 @@ class GD_CORE_API ExpressionParser2 {
       return Identifier();
     }
 
-    std::unique_ptr<ExpressionNode> factor = ReadUntilWhitespace();
+    ArenaUniquePtr<ExpressionNode> factor = ReadUntilWhitespace();
     return factor;
   }
 
-  std::unique_ptr<SubExpressionNode> SubExpression() {
+  ArenaUniquePtr<SubExpressionNode> SubExpression() {
     size_t expressionStartPosition = GetCurrentPosition();
 
     auto expression = Expression();
 
     auto subExpression =
-        gd::make_unique<SubExpressionNode>(std::move(expression));
+        MakeUnique<SubExpressionNode>(std::move(expression));
     subExpression->location =
         ExpressionParserLocation(expressionStartPosition, GetCurrentPosition());
 
     return std::move(subExpression);
   };
 
-  std::unique_ptr<IdentifierOrFunctionCallOrObjectFunctionNameOrEmptyNode>
+  ArenaUniquePtr<IdentifierOrFunctionCallOrObjectFunctionNameOrEmptyNode>
   Identifier() {
     auto identifierAndLocation = ReadIdentifierName();
     gd::String name = identifierAndLocation.name;
@@ -267,7 +320,7 @@ class GD_CORE_API ExpressionParser2 {
     } else if (CheckIfChar(IsOpeningSquareBracket)) {
       return Variable(name, nameLocation);
     } else {
-      auto identifier = gd::make_unique<IdentifierNode>(name);
+      auto identifier = MakeUnique<IdentifierNode>(name);
       identifier->location = ExpressionParserLocation(
           nameLocation.GetStartPosition(), GetCurrentPosition());
       identifier->identifierNameLocation = identifier->location;
@@ -275,8 +328,8 @@ class GD_CORE_API ExpressionParser2 {
     }
   }
 
-  std::unique_ptr<VariableNode> Variable(const gd::String &name, gd::ExpressionParserLocation nameLocation) {
-    auto variable = gd::make_unique<VariableNode>(name);
+  ArenaUniquePtr<VariableNode> Variable(const gd::String &name, gd::ExpressionParserLocation nameLocation) {
+    auto variable = MakeUnique<VariableNode>(name);
 
     if (CheckIfChar(IsOpeningSquareBracket) || CheckIfChar(IsDot)) {
       variable->child = VariableAccessorOrVariableBracketAccessor();
@@ -289,14 +342,14 @@ class GD_CORE_API ExpressionParser2 {
     return std::move(variable);
   }
 
-  std::unique_ptr<VariableAccessorOrVariableBracketAccessorNode>
+  ArenaUniquePtr<VariableAccessorOrVariableBracketAccessorNode>
   VariableAccessorOrVariableBracketAccessor() {
     size_t childStartPosition = GetCurrentPosition();
 
     SkipAllWhitespaces();
     if (CheckIfChar(IsOpeningSquareBracket)) {
       SkipChar();
-      auto child = gd::make_unique<VariableBracketAccessorNode>(Expression());
+      auto child = MakeUnique<VariableBracketAccessorNode>(Expression());
       child->expression->parent = child.get();
 
       if (!CheckIfChar(IsClosingSquareBracket)) {
@@ -321,7 +374,7 @@ class GD_CORE_API ExpressionParser2 {
 
       auto identifierAndLocation = ReadIdentifierName(/*allowDeprecatedSpacesInName=*/ false);
       auto child =
-          gd::make_unique<VariableAccessorNode>(identifierAndLocation.name);
+          MakeUnique<VariableAccessorNode>(identifierAndLocation.name);
       if (identifierAndLocation.name.empty()) {
         child->diagnostic = RaiseSyntaxError(_("A name should be entered after the dot."));
       }
@@ -341,12 +394,12 @@ class GD_CORE_API ExpressionParser2 {
 
     // Should never happen, unless a node called this function without checking if the current character
     // was a dot or an opening bracket - this means there is an error in the grammar.
-    auto unrecognisedNode = gd::make_unique<VariableAccessorOrVariableBracketAccessorNode>();
+    auto unrecognisedNode = MakeUnique<VariableAccessorOrVariableBracketAccessorNode>();
     unrecognisedNode->diagnostic = RaiseSyntaxError(_("A dot or bracket was expected here."));
     return std::move(unrecognisedNode);
   }
 
-  std::unique_ptr<FunctionCallNode> FreeFunction(
+  ArenaUniquePtr<FunctionCallNode> FreeFunction(
       const gd::String &functionFullName,
       const ExpressionParserLocation &identifierLocation,
       const ExpressionParserLocation &openingParenthesisLocation) {
@@ -354,7 +407,7 @@ class GD_CORE_API ExpressionParser2 {
     // + Test for it
 
     auto function =
-        gd::make_unique<FunctionCallNode>(functionFullName);
+        MakeUnique<FunctionCallNode>(functionFullName);
     auto parametersNode = Parameters(function.get());
     function->parameters = std::move(parametersNode.parameters);
     function->diagnostic = std::move(parametersNode.diagnostic);
@@ -369,7 +422,7 @@ class GD_CORE_API ExpressionParser2 {
     return std::move(function);
   }
 
-  std::unique_ptr<IdentifierOrFunctionCallOrObjectFunctionNameOrEmptyNode>
+  ArenaUniquePtr<IdentifierOrFunctionCallOrObjectFunctionNameOrEmptyNode>
   ObjectFunctionOrBehaviorFunctionOrVariable(
       const gd::String &parentIdentifier,
       const ExpressionParserLocation &parentIdentifierLocation,
@@ -379,7 +432,7 @@ class GD_CORE_API ExpressionParser2 {
     const auto &childIdentifierNameLocation =
         childIdentifierAndLocation.location;
 
-    std::unique_ptr<gd::ExpressionParserError> emptyNameError = childIdentifierName.empty() ?
+    gd::ArenaUniquePtr<gd::ExpressionParserError> emptyNameError = childIdentifierName.empty() ?
       RaiseSyntaxError(_("A name should be entered after the dot.")) : nullptr;
 
     SkipAllWhitespaces();
@@ -400,7 +453,7 @@ class GD_CORE_API ExpressionParser2 {
     } else if (CheckIfChar(IsOpeningParenthesis)) {
       ExpressionParserLocation openingParenthesisLocation = SkipChar();
 
-      auto function = gd::make_unique<FunctionCallNode>(
+      auto function = MakeUnique<FunctionCallNode>(
           parentIdentifier,
           childIdentifierName);
       auto parametersNode = Parameters(function.get(), parentIdentifier);
@@ -417,11 +470,11 @@ class GD_CORE_API ExpressionParser2 {
           parametersNode.closingParenthesisLocation;
       return std::move(function);
     } else if (CheckIfChar(IsDot) || CheckIfChar(IsOpeningSquareBracket)) {
-      auto variable = gd::make_unique<VariableNode>(parentIdentifier);
+      auto variable = MakeUnique<VariableNode>(parentIdentifier);
       variable->diagnostic = std::move(emptyNameError);
 
       auto child =
-          gd::make_unique<VariableAccessorNode>(childIdentifierName);
+          MakeUnique<VariableAccessorNode>(childIdentifierName);
       child->child = VariableAccessorOrVariableBracketAccessor();
       child->child->parent = child.get();
       child->nameLocation = childIdentifierNameLocation;
@@ -438,7 +491,7 @@ class GD_CORE_API ExpressionParser2 {
       return std::move(variable);
     }
 
-    auto node = gd::make_unique<IdentifierNode>(
+    auto node = MakeUnique<IdentifierNode>(
         parentIdentifier, childIdentifierName);
     node->location = ExpressionParserLocation(
         parentIdentifierLocation.GetStartPosition(), GetCurrentPosition());
@@ -449,7 +502,7 @@ class GD_CORE_API ExpressionParser2 {
     return std::move(node);
   }
 
-  std::unique_ptr<FunctionCallOrObjectFunctionNameOrEmptyNode> BehaviorFunction(
+  ArenaUniquePtr<FunctionCallOrObjectFunctionNameOrEmptyNode> BehaviorFunction(
       const gd::String &objectName,
       const gd::String &behaviorName,
       const ExpressionParserLocation &objectNameLocation,
@@ -465,7 +518,7 @@ class GD_CORE_API ExpressionParser2 {
     if (CheckIfChar(IsOpeningParenthesis)) {
       ExpressionParserLocation openingParenthesisLocation = SkipChar();
 
-      auto function = gd::make_unique<FunctionCallNode>(
+      auto function = MakeUnique<FunctionCallNode>(
           objectName,
           behaviorName,
           functionName);
@@ -487,7 +540,7 @@ class GD_CORE_API ExpressionParser2 {
       function->functionNameLocation = functionNameLocation;
       return std::move(function);
     } else {
-      auto node = gd::make_unique<ObjectFunctionNameNode>(
+      auto node = MakeUnique<ObjectFunctionNameNode>(
           objectName, behaviorName, functionName);
       node->diagnostic = RaiseSyntaxError(
           _("An opening parenthesis was expected here to call a function."));
@@ -506,8 +559,8 @@ class GD_CORE_API ExpressionParser2 {
 
   // A temporary node that will be integrated into function nodes.
   struct ParametersNode {
-    std::vector<std::unique_ptr<ExpressionNode>> parameters;
-    std::unique_ptr<gd::ExpressionParserError> diagnostic;
+    std::vector<ArenaUniquePtr<ExpressionNode>> parameters;
+    gd::ArenaUniquePtr<gd::ExpressionParserError> diagnostic;
     ExpressionParserLocation closingParenthesisLocation;
   };
 
@@ -515,7 +568,7 @@ class GD_CORE_API ExpressionParser2 {
       FunctionCallNode *functionCallNode,
       const gd::String &objectName = "",
       const gd::String &behaviorName = "") {
-    std::vector<std::unique_ptr<ExpressionNode>> parameters;
+    std::vector<ArenaUniquePtr<ExpressionNode>> parameters;
     gd::String lastObjectName = "";
 
     bool previousCharacterIsParameterSeparator = false;
@@ -529,7 +582,7 @@ class GD_CORE_API ExpressionParser2 {
       }
       bool isEmptyParameter = CheckIfChar(IsParameterSeparator)
           || (CheckIfChar(IsClosingParenthesis) && previousCharacterIsParameterSeparator);
-      auto parameter = isEmptyParameter ? gd::make_unique<EmptyNode>() : Expression();
+      auto parameter = isEmptyParameter ? MakeUnique<EmptyNode>() : Expression();
       parameter->parent = functionCallNode;
       parameters.push_back(std::move(parameter));
 
@@ -547,27 +600,27 @@ class GD_CORE_API ExpressionParser2 {
   }
   ///@}
 
-  std::unique_ptr<ExpressionParserError> ValidateOperator(
+  ArenaUniquePtr<ExpressionParserError> ValidateOperator(
       gd::String::value_type operatorChar) {
     if (operatorChar == '+' || operatorChar == '-' || operatorChar == '/' ||
         operatorChar == '*') {
-      return std::unique_ptr<ExpressionParserError>(nullptr);
+      return ArenaUniquePtr<ExpressionParserError>(nullptr);
     }
-    return gd::make_unique<ExpressionParserError>(
+    return MakeUnique<ExpressionParserError>(
         gd::ExpressionParserError::ErrorType::InvalidOperator,
         _("You've used an operator that is not supported. Operator should be "
           "either +, -, / or *."),
         GetCurrentPosition());
   }
 
-  std::unique_ptr<ExpressionParserError> ValidateUnaryOperator(
+  ArenaUniquePtr<ExpressionParserError> ValidateUnaryOperator(
       gd::String::value_type operatorChar,
       size_t position) {
     if (operatorChar == '+' || operatorChar == '-') {
-      return std::unique_ptr<ExpressionParserError>(nullptr);
+      return ArenaUniquePtr<ExpressionParserError>(nullptr);
     }
 
-    return gd::make_unique<ExpressionParserError>(
+    return MakeUnique<ExpressionParserError>(
         gd::ExpressionParserError::ErrorType::InvalidOperator,
         _("You've used an \"unary\" operator that is not supported. Operator "
           "should be "
@@ -622,8 +675,9 @@ class GD_CORE_API ExpressionParser2 {
     // Namespace separator is a special kind of delimiter as it is 2 characters
     // long
     return (currentPosition + NAMESPACE_SEPARATOR.size() <= expression.size() &&
-            expression.substr(currentPosition, NAMESPACE_SEPARATOR.size()) ==
-                NAMESPACE_SEPARATOR);
+            std::equal(NAMESPACE_SEPARATOR.begin(),
+                       NAMESPACE_SEPARATOR.end(),
+                       expression.begin() + currentPosition));
   }
 
   bool IsEndReached() { return currentPosition >= expression.size(); }
@@ -667,11 +721,11 @@ class GD_CORE_API ExpressionParser2 {
     return identifierAndLocation;
   }
 
-  std::unique_ptr<TextNode> ReadText();
+  ArenaUniquePtr<TextNode> ReadText();
 
-  std::unique_ptr<NumberNode> ReadNumber();
+  ArenaUniquePtr<NumberNode> ReadNumber();
 
-  std::unique_ptr<EmptyNode> ReadUntilWhitespace() {
+  ArenaUniquePtr<EmptyNode> ReadUntilWhitespace() {
     size_t startPosition = GetCurrentPosition();
     gd::String text;
     while (currentPosition < expression.size() &&
@@ -680,13 +734,13 @@ class GD_CORE_API ExpressionParser2 {
       currentPosition++;
     }
 
-    auto node = gd::make_unique<EmptyNode>(text);
+    auto node = MakeUnique<EmptyNode>(text);
     node->location =
         ExpressionParserLocation(startPosition, GetCurrentPosition());
     return node;
   }
 
-  std::unique_ptr<EmptyNode> ReadUntilEnd() {
+  ArenaUniquePtr<EmptyNode> ReadUntilEnd() {
     size_t startPosition = GetCurrentPosition();
     gd::String text;
     while (currentPosition < expression.size()) {
@@ -694,7 +748,7 @@ class GD_CORE_API ExpressionParser2 {
       currentPosition++;
     }
 
-    auto node = gd::make_unique<EmptyNode>(text);
+    auto node = MakeUnique<EmptyNode>(text);
     node->location =
         ExpressionParserLocation(startPosition, GetCurrentPosition());
     return node;
@@ -712,27 +766,61 @@ class GD_CORE_API ExpressionParser2 {
   }
   ///@}
 
+  /** \name Allocating nodes
+   */
+  ///@{
+  /**
+   * \brief Like gd::make_unique, but allocating from the arena given to
+   * ParseExpression, if any.
+   */
+  template <class T, class... Args>
+  ArenaUniquePtr<T> MakeUnique(Args &&...args) {
+    return gd::MakeArenaUnique<T>(arena, std::forward<Args>(args)...);
+  }
+  ///@}
+
+  /** \name Reusing nodes
+   * Helpers for ParseExpressionAfterEdit
+   */
+  ///@{
+  /**
+   * \brief Return the node of the previous tree that can be reused at the
+   * current position (and move after it), if any.
+   */
+  ArenaUniquePtr<ExpressionNode> ReuseNode();
+  ///@}
+
   /** \name Raising errors
    * Helpers to attach errors to nodes
    */
   ///@{
-  std::unique_ptr<ExpressionParserError> RaiseSyntaxError(
+  ArenaUniquePtr<ExpressionParserError> RaiseSyntaxError(
       const gd::String &message) {
-    return std::move(gd::make_unique<ExpressionParserError>(
+    return std::move(MakeUnique<ExpressionParserError>(
         gd::ExpressionParserError::ErrorType::SyntaxError, message,
         GetCurrentPosition()));
   }
 
-  std::unique_ptr<ExpressionParserError> RaiseTypeError(
+  ArenaUniquePtr<ExpressionParserError> RaiseTypeError(
       const gd::String &message, size_t beginningPosition) {
-    return std::move(gd::make_unique<ExpressionParserError>(
+    return std::move(MakeUnique<ExpressionParserError>(
         gd::ExpressionParserError::ErrorType::MismatchedType, message,
         beginningPosition, GetCurrentPosition()));
   }
   ///@}
 
-  gd::String expression;
+  std::u32string expression;  ///< The characters of the expression being
+                              ///< parsed.
   std::size_t currentPosition;
+  gd::Arena *arena;  ///< The arena to allocate nodes from, if any.
+
+  std::unordered_map<size_t, ArenaUniquePtr<ExpressionNode> *>
+      reusableNodes;  ///< The nodes of the previous tree that can be reused,
+                      ///< by their position in the previous expression.
+  size_t editStartPosition;
+  size_t editPreviousEndPosition;  ///< The end of the edited span, in the
+                                   ///< previous expression.
+  size_t editEndPosition;  ///< The end of the edited span, in the expression.
 
   static gd::String NAMESPACE_SEPARATOR;
 };
@@ -10,6 +10,7 @@
 
 #include "ExpressionParser2NodeWorker.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/Arena.h"
 
 namespace gd {
 class Expression;
@@ -23,7 +24,8 @@ struct FunctionCallNode;
 namespace gd {
 
 struct GD_CORE_API ExpressionParserLocation {
-  ExpressionParserLocation() : isValid(false){};
+  ExpressionParserLocation()
+      : isValid(false), startPosition(0), endPosition(0){};
   ExpressionParserLocation(size_t position)
       : isValid(true), startPosition(position), endPosition(position){};
   ExpressionParserLocation(size_t startPosition_, size_t endPosition_)
@@ -42,8 +44,10 @@ struct GD_CORE_API ExpressionParserLocation {
 
 /**
  * \brief An error that can be attached to a gd::ExpressionNode.
+ *
+ * Like nodes, it can be allocated from a gd::Arena by the parser.
  */
-struct GD_CORE_API ExpressionParserError {
+struct GD_CORE_API ExpressionParserError : public ArenaAllocated {
   enum ErrorType {
     SyntaxError,
     InvalidOperator,
@@ -83,6 +87,10 @@ struct GD_CORE_API ExpressionParserError {
   const gd::String &GetActualValue() { return actualValue; }
   size_t GetStartPosition() { return location.GetStartPosition(); }
   size_t GetEndPosition() { return location.GetEndPosition(); }
+  const ExpressionParserLocation &GetLocation() { return location; }
+  void SetLocation(const ExpressionParserLocation &location_) {
+    location = location_;
+  }
 
 private:
   gd::ExpressionParserError::ErrorType type;
@@ -95,13 +103,18 @@ private:
 /**
  * \brief The base node, from which all nodes in the tree of
  * an expression inherits from.
+ *
+ * Nodes are owned by their parent (using gd::ArenaUniquePtr), and can be
+ * allocated from a gd::Arena (see gd::ExpressionParser2::ParseExpression) so
+ * that a whole tree is allocated at once. In this case, the arena must outlive
+ * the tree.
  */
-struct GD_CORE_API ExpressionNode {
+struct GD_CORE_API ExpressionNode : public ArenaAllocated {
   ExpressionNode() : parent(nullptr) {};
   virtual ~ExpressionNode(){};
   virtual void Visit(ExpressionParser2NodeWorker &worker){};
 
-  std::unique_ptr<ExpressionParserError> diagnostic;
+  ArenaUniquePtr<ExpressionParserError> diagnostic;
   ExpressionParserLocation location;  ///< The location of the entire node. Some
                                       /// nodes might have other locations
                                       /// stored inside them. For example, a
@@ -112,14 +125,14 @@ struct GD_CORE_API ExpressionNode {
 };
 
 struct GD_CORE_API SubExpressionNode : public ExpressionNode {
-  SubExpressionNode(std::unique_ptr<ExpressionNode> expression_)
+  SubExpressionNode(ArenaUniquePtr<ExpressionNode> expression_)
       : ExpressionNode(), expression(std::move(expression_)){};
   virtual ~SubExpressionNode(){};
   virtual void Visit(ExpressionParser2NodeWorker &worker) {
     worker.OnVisitSubExpressionNode(*this);
   };
 
-  std::unique_ptr<ExpressionNode> expression;
+  ArenaUniquePtr<ExpressionNode> expression;
 };
 
 /**
@@ -133,8 +146,8 @@ struct GD_CORE_API OperatorNode : public ExpressionNode {
     worker.OnVisitOperatorNode(*this);
   };
 
-  std::unique_ptr<ExpressionNode> leftHandSide;
-  std::unique_ptr<ExpressionNode> rightHandSide;
+  ArenaUniquePtr<ExpressionNode> leftHandSide;
+  ArenaUniquePtr<ExpressionNode> rightHandSide;
   gd::String::value_type op;
 };
 
@@ -149,7 +162,7 @@ struct GD_CORE_API UnaryOperatorNode : public ExpressionNode {
     worker.OnVisitUnaryOperatorNode(*this);
   };
 
-  std::unique_ptr<ExpressionNode> factor;
+  ArenaUniquePtr<ExpressionNode> factor;
   gd::String::value_type op;
 };
 
@@ -241,7 +254,7 @@ struct GD_CORE_API FunctionCallOrObjectFunctionNameOrEmptyNode
 struct GD_CORE_API VariableAccessorOrVariableBracketAccessorNode : public ExpressionNode {
   VariableAccessorOrVariableBracketAccessorNode() : ExpressionNode(){};
 
-  std::unique_ptr<VariableAccessorOrVariableBracketAccessorNode> child;
+  ArenaUniquePtr<VariableAccessorOrVariableBracketAccessorNode> child;
 };
 
 /**
@@ -267,7 +280,7 @@ struct GD_CORE_API VariableNode : public FunctionCallOrObjectFunctionNameOrEmpty
 
   gd::String name;
 
-  std::unique_ptr<VariableAccessorOrVariableBracketAccessorNode>
+  ArenaUniquePtr<VariableAccessorOrVariableBracketAccessorNode>
       child;  // Can be nullptr if no accessor
 
   ExpressionParserLocation nameLocation;
@@ -297,14 +310,14 @@ struct GD_CORE_API VariableAccessorNode
  */
 struct GD_CORE_API VariableBracketAccessorNode
     : public VariableAccessorOrVariableBracketAccessorNode {
-  VariableBracketAccessorNode(std::unique_ptr<ExpressionNode> expression_)
+  VariableBracketAccessorNode(ArenaUniquePtr<ExpressionNode> expression_)
       : VariableAccessorOrVariableBracketAccessorNode(), expression(std::move(expression_)){};
   virtual ~VariableBracketAccessorNode(){};
   virtual void Visit(ExpressionParser2NodeWorker &worker) {
     worker.OnVisitVariableBracketAccessorNode(*this);
   };
 
-  std::unique_ptr<ExpressionNode> expression;
+  ArenaUniquePtr<ExpressionNode> expression;
 };
 
 /**
@@ -395,7 +408,7 @@ struct GD_CORE_API FunctionCallNode : public FunctionCallOrObjectFunctionNameOrE
 
   gd::String objectName;
   gd::String behaviorName;
-  std::vector<std::unique_ptr<ExpressionNode>> parameters;
+  std::vector<ArenaUniquePtr<ExpressionNode>> parameters;
   gd::String functionName;
 
   ExpressionParserLocation
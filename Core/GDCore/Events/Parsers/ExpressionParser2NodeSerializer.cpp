@@ -0,0 +1,438 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Events/Parsers/ExpressionParser2NodeSerializer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "GDCore/Events/Parsers/ExpressionParser2Node.h"
+#include "GDCore/String.h"
+#include "GDCore/Tools/Arena.h"
+
+namespace gd {
+
+namespace {
+
+enum NodeType : unsigned char {
+  SerializedNoNode = 0,
+  SerializedSubExpression,
+  SerializedOperator,
+  SerializedUnaryOperator,
+  SerializedNumber,
+  SerializedText,
+  SerializedVariable,
+  SerializedVariableAccessor,
+  SerializedVariableBracketAccessor,
+  SerializedIdentifier,
+  SerializedObjectFunctionName,
+  SerializedFunctionCall,
+  SerializedEmpty,
+};
+
+enum NodeFlags : unsigned char {
+  HasParent = 1,
+  HasDiagnostic = 2,
+};
+
+/**
+ * \brief Rebuild a tree written by gd::ExpressionParser2NodeSerializer.
+ *
+ * Any malformed input stops the reading (see `failed`).
+ */
+class NodeReader {
+ public:
+  NodeReader(const std::string& input_, std::size_t& position_,
+             gd::Arena* arena_)
+      : input(input_), position(position_), arena(arena_), failed(false){};
+
+  ArenaUniquePtr<ExpressionNode> ReadRootNode() {
+    auto node = ReadNode(nullptr);
+    if (failed || !node) return nullptr;
+
+    return node;
+  }
+
+ private:
+  template <class T, class... Args>
+  ArenaUniquePtr<T> MakeUnique(Args&&... args) {
+    return gd::MakeArenaUnique<T>(arena, std::forward<Args>(args)...);
+  }
+
+  unsigned char ReadByte() {
+    if (position >= input.size()) {
+      failed = true;
+      return 0;
+    }
+    return static_cast<unsigned char>(input[position++]);
+  }
+
+  std::size_t ReadSize() {
+    std::size_t size = 0;
+    if (!ExpressionParser2NodeSerializer::ReadSize(input, position, size))
+      failed = true;
+    return size;
+  }
+
+  gd::String ReadString() {
+    std::string str;
+    if (!ExpressionParser2NodeSerializer::ReadString(input, position, str))
+      failed = true;
+    return gd::String::FromUTF8(str);
+  }
+
+  ExpressionParserLocation ReadLocation() {
+    if (!ReadByte()) return ExpressionParserLocation();
+
+    std::size_t startPosition = ReadSize();
+    std::size_t endPosition = ReadSize();
+    return ExpressionParserLocation(startPosition, endPosition);
+  }
+
+  ArenaUniquePtr<ExpressionNode> ReadNode(ExpressionNode* parent) {
+    unsigned char nodeType = ReadByte();
+    if (failed || nodeType == SerializedNoNode) return nullptr;
+
+    unsigned char flags = ReadByte();
+    ExpressionParserLocation location = ReadLocation();
+    ArenaUniquePtr<ExpressionParserError> diagnostic;
+    if (flags & HasDiagnostic) {
+      std::size_t errorType = ReadSize();
+      gd::String message = ReadString();
+      ExpressionParserLocation errorLocation = ReadLocation();
+      gd::String actualValue = ReadString();
+      gd::String objectName = ReadString();
+      if (errorType > ExpressionParserError::ErrorType::MissingBehavior) {
+        failed = true;
+        return nullptr;
+      }
+
+      diagnostic = MakeUnique<ExpressionParserError>(
+          static_cast<ExpressionParserError::ErrorType>(errorType),
+          message,
+          errorLocation,
+          actualValue,
+          objectName);
+    }
+
+    ArenaUniquePtr<ExpressionNode> node = ReadNodeContent(nodeType);
+    if (failed || !node) {
+      failed = true;
+      return nullptr;
+    }
+
+    node->location = location;
+    node->diagnostic = std::move(diagnostic);
+    node->parent = (flags & HasParent) ? parent : nullptr;
+    return node;
+  }
+
+  /**
+   * \brief Read a child that the parser always sets (like the operands of an
+   * operator): a missing node means the input is malformed.
+   */
+  ArenaUniquePtr<ExpressionNode> ReadRequiredNode(ExpressionNode* parent) {
+    auto node = ReadNode(parent);
+    if (!node) failed = true;
+    return node;
+  }
+
+  ArenaUniquePtr<VariableAccessorOrVariableBracketAccessorNode>
+  ReadVariableAccessorNode(ExpressionNode* parent) {
+    auto node = ReadNode(parent);
+    if (!node) return nullptr;
+
+    auto* accessorNode =
+        dynamic_cast<VariableAccessorOrVariableBracketAccessorNode*>(
+            node.get());
+    if (!accessorNode) {
+      failed = true;
+      return nullptr;
+    }
+
+    node.release();
+    return ArenaUniquePtr<VariableAccessorOrVariableBracketAccessorNode>(
+        accessorNode);
+  }
+
+  ArenaUniquePtr<ExpressionNode> ReadNodeContent(unsigned char nodeType) {
+    if (nodeType == SerializedSubExpression) {
+      auto node = MakeUnique<SubExpressionNode>(nullptr);
+      node->expression = ReadRequiredNode(node.get());
+      return std::move(node);
+    } else if (nodeType == SerializedOperator) {
+      auto node = MakeUnique<OperatorNode>(ReadSize());
+      node->leftHandSide = ReadRequiredNode(node.get());
+      node->rightHandSide = ReadRequiredNode(node.get());
+      return std::move(node);
+    } else if (nodeType == SerializedUnaryOperator) {
+      auto node = MakeUnique<UnaryOperatorNode>(ReadSize());
+      node->factor = ReadRequiredNode(node.get());
+      return std::move(node);
+    } else if (nodeType == SerializedNumber) {
+      return MakeUnique<NumberNode>(ReadString());
+    } else if (nodeType == SerializedText) {
+      return MakeUnique<TextNode>(ReadString());
+    } else if (nodeType == SerializedVariable) {
+      auto node = MakeUnique<VariableNode>(ReadString());
+      node->nameLocation = ReadLocation();
+      node->child = ReadVariableAccessorNode(node.get());
+      return std::move(node);
+    } else if (nodeType == SerializedVariableAccessor) {
+      auto node = MakeUnique<VariableAccessorNode>(ReadString());
+      node->nameLocation = ReadLocation();
+      node->dotLocation = ReadLocation();
+      node->child = ReadVariableAccessorNode(node.get());
+      return std::move(node);
+    } else if (nodeType == SerializedVariableBracketAccessor) {
+      auto node = MakeUnique<VariableBracketAccessorNode>(nullptr);
+      node->expression = ReadRequiredNode(node.get());
+      node->child = ReadVariableAccessorNode(node.get());
+      return std::move(node);
+    } else if (nodeType == SerializedIdentifier) {
+      gd::String identifierName = ReadString();
+      gd::String childIdentifierName = ReadString();
+      auto node =
+          MakeUnique<IdentifierNode>(identifierName, childIdentifierName);
+      node->identifierNameLocation = ReadLocation();
+      node->identifierNameDotLocation = ReadLocation();
+      node->childIdentifierNameLocation = ReadLocation();
+      return std::move(node);
+    } else if (nodeType == SerializedObjectFunctionName) {
+      gd::String objectName = ReadString();
+      gd::String objectFunctionOrBehaviorName = ReadString();
+      gd::String behaviorFunctionName = ReadString();
+      auto node = MakeUnique<ObjectFunctionNameNode>(
+          objectName, objectFunctionOrBehaviorName, behaviorFunctionName);
+      node->objectNameLocation = ReadLocation();
+      node->objectNameDotLocation = ReadLocation();
+      node->objectFunctionOrBehaviorNameLocation = ReadLocation();
+      node->behaviorNameNamespaceSeparatorLocation = ReadLocation();
+      node->behaviorFunctionNameLocation = ReadLocation();
+      return std::move(node);
+    } else if (nodeType == SerializedFunctionCall) {
+      gd::String objectName = ReadString();
+      gd::String behaviorName = ReadString();
+      gd::String functionName = ReadString();
+      auto node =
+          MakeUnique<FunctionCallNode>(objectName, behaviorName, functionName);
+      node->functionNameLocation = ReadLocation();
+      node->objectNameLocation = ReadLocation();
+      node->objectNameDotLocation = ReadLocation();
+      node->behaviorNameLocation = ReadLocation();
+      node->behaviorNameNamespaceSeparatorLocation = ReadLocation();
+      node->openingParenthesisLocation = ReadLocation();
+      node->closingParenthesisLocation = ReadLocation();
+
+      std::size_t parametersCount = ReadSize();
+      for (std::size_t i = 0; i < parametersCount && !failed; ++i) {
+        node->parameters.push_back(ReadRequiredNode(node.get()));
+      }
+      return std::move(node);
+    } else if (nodeType == SerializedEmpty) {
+      return MakeUnique<EmptyNode>(ReadString());
+    }
+
+    failed = true;
+    return nullptr;
+  }
+
+  const std::string& input;
+  std::size_t& position;
+  gd::Arena* arena;
+  bool failed;
+};
+
+}  // namespace
+
+void ExpressionParser2NodeSerializer::SerializeNode(gd::ExpressionNode& node,
+                                                     std::string& output) {
+  gd::ExpressionParser2NodeSerializer serializer(output);
+  node.Visit(serializer);
+}
+
+gd::ArenaUniquePtr<gd::ExpressionNode>
+ExpressionParser2NodeSerializer::UnserializeNode(const std::string& input,
+                                                 std::size_t& position,
+                                                 gd::Arena* arena) {
+  NodeReader reader(input, position, arena);
+  return reader.ReadRootNode();
+}
+
+void ExpressionParser2NodeSerializer::WriteSize(std::size_t size,
+                                                std::string& output) {
+  // Write 7 bits per byte, the highest bit telling if more bytes follow.
+  while (size >= 0x80) {
+    output.push_back(static_cast<char>((size & 0x7F) | 0x80));
+    size >>= 7;
+  }
+  output.push_back(static_cast<char>(size));
+}
+
+void ExpressionParser2NodeSerializer::WriteString(const std::string& str,
+                                                  std::string& output) {
+  WriteSize(str.size(), output);
+  output += str;
+}
+
+bool ExpressionParser2NodeSerializer::ReadSize(const std::string& input,
+                                               std::size_t& position,
+                                               std::size_t& size) {
+  size = 0;
+  for (unsigned int shift = 0; shift < sizeof(std::size_t) * 8; shift += 7) {
+    if (position >= input.size()) return false;
+
+    unsigned char byte = static_cast<unsigned char>(input[position++]);
+    size |= static_cast<std::size_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+
+  return false;
+}
+
+bool ExpressionParser2NodeSerializer::ReadString(const std::string& input,
+                                                 std::size_t& position,
+                                                 std::string& str) {
+  std::size_t size = 0;
+  if (!ReadSize(input, position, size) || size > input.size() - position)
+    return false;
+
+  str.assign(input, position, size);
+  position += size;
+  return true;
+}
+
+void ExpressionParser2NodeSerializer::WriteNodeHeader(unsigned char nodeType,
+                                                      ExpressionNode& node) {
+  output.push_back(static_cast<char>(nodeType));
+  output.push_back(static_cast<char>((node.parent ? HasParent : 0) |
+                                     (node.diagnostic ? HasDiagnostic : 0)));
+  WriteLocation(node.location);
+  if (node.diagnostic) {
+    WriteSize(node.diagnostic->GetType(), output);
+    WriteString(node.diagnostic->GetMessage().Raw(), output);
+    WriteLocation(node.diagnostic->GetLocation());
+    WriteString(node.diagnostic->GetActualValue().Raw(), output);
+    WriteString(node.diagnostic->GetObjectName().Raw(), output);
+  }
+}
+
+void ExpressionParser2NodeSerializer::WriteChild(ExpressionNode* child) {
+  if (child)
+    child->Visit(*this);
+  else
+    output.push_back(static_cast<char>(SerializedNoNode));
+}
+
+void ExpressionParser2NodeSerializer::WriteLocation(
+    const ExpressionParserLocation& location) {
+  output.push_back(location.IsValid() ? 1 : 0);
+  if (!location.IsValid()) return;
+
+  WriteSize(location.GetStartPosition(), output);
+  WriteSize(location.GetEndPosition(), output);
+}
+
+void ExpressionParser2NodeSerializer::OnVisitSubExpressionNode(
+    SubExpressionNode& node) {
+  WriteNodeHeader(SerializedSubExpression, node);
+  WriteChild(node.expression.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitOperatorNode(OperatorNode& node) {
+  WriteNodeHeader(SerializedOperator, node);
+  WriteSize(node.op, output);
+  WriteChild(node.leftHandSide.get());
+  WriteChild(node.rightHandSide.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitUnaryOperatorNode(
+    UnaryOperatorNode& node) {
+  WriteNodeHeader(SerializedUnaryOperator, node);
+  WriteSize(node.op, output);
+  WriteChild(node.factor.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitNumberNode(NumberNode& node) {
+  WriteNodeHeader(SerializedNumber, node);
+  WriteString(node.number.Raw(), output);
+}
+
+void ExpressionParser2NodeSerializer::OnVisitTextNode(TextNode& node) {
+  WriteNodeHeader(SerializedText, node);
+  WriteString(node.text.Raw(), output);
+}
+
+void ExpressionParser2NodeSerializer::OnVisitVariableNode(VariableNode& node) {
+  WriteNodeHeader(SerializedVariable, node);
+  WriteString(node.name.Raw(), output);
+  WriteLocation(node.nameLocation);
+  WriteChild(node.child.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitVariableAccessorNode(
+    VariableAccessorNode& node) {
+  WriteNodeHeader(SerializedVariableAccessor, node);
+  WriteString(node.name.Raw(), output);
+  WriteLocation(node.nameLocation);
+  WriteLocation(node.dotLocation);
+  WriteChild(node.child.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitVariableBracketAccessorNode(
+    VariableBracketAccessorNode& node) {
+  WriteNodeHeader(SerializedVariableBracketAccessor, node);
+  WriteChild(node.expression.get());
+  WriteChild(node.child.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitIdentifierNode(
+    IdentifierNode& node) {
+  WriteNodeHeader(SerializedIdentifier, node);
+  WriteString(node.identifierName.Raw(), output);
+  WriteString(node.childIdentifierName.Raw(), output);
+  WriteLocation(node.identifierNameLocation);
+  WriteLocation(node.identifierNameDotLocation);
+  WriteLocation(node.childIdentifierNameLocation);
+}
+
+void ExpressionParser2NodeSerializer::OnVisitObjectFunctionNameNode(
+    ObjectFunctionNameNode& node) {
+  WriteNodeHeader(SerializedObjectFunctionName, node);
+  WriteString(node.objectName.Raw(), output);
+  WriteString(node.objectFunctionOrBehaviorName.Raw(), output);
+  WriteString(node.behaviorFunctionName.Raw(), output);
+  WriteLocation(node.objectNameLocation);
+  WriteLocation(node.objectNameDotLocation);
+  WriteLocation(node.objectFunctionOrBehaviorNameLocation);
+  WriteLocation(node.behaviorNameNamespaceSeparatorLocation);
+  WriteLocation(node.behaviorFunctionNameLocation);
+}
+
+void ExpressionParser2NodeSerializer::OnVisitFunctionCallNode(
+    FunctionCallNode& node) {
+  WriteNodeHeader(SerializedFunctionCall, node);
+  WriteString(node.objectName.Raw(), output);
+  WriteString(node.behaviorName.Raw(), output);
+  WriteString(node.functionName.Raw(), output);
+  WriteLocation(node.functionNameLocation);
+  WriteLocation(node.objectNameLocation);
+  WriteLocation(node.objectNameDotLocation);
+  WriteLocation(node.behaviorNameLocation);
+  WriteLocation(node.behaviorNameNamespaceSeparatorLocation);
+  WriteLocation(node.openingParenthesisLocation);
+  WriteLocation(node.closingParenthesisLocation);
+
+  WriteSize(node.parameters.size(), output);
+  for (auto& parameter : node.parameters) WriteChild(parameter.get());
+}
+
+void ExpressionParser2NodeSerializer::OnVisitEmptyNode(EmptyNode& node) {
+  WriteNodeHeader(SerializedEmpty, node);
+  WriteString(node.text.Raw(), output);
+}
+
+}  // namespace gd
@@ -0,0 +1,103 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_EXPRESSIONPARSER2NODESERIALIZER_H
+#define GDCORE_EXPRESSIONPARSER2NODESERIALIZER_H
+
+#include <memory>
+#include <string>
+
+#include "GDCore/Events/Parsers/ExpressionParser2Node.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
+namespace gd {
+class Arena;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Serialize a tree of nodes to a compact binary representation, and
+ * rebuild the tree from it.
+ *
+ * The rebuilt tree is exactly the same as the serialized one (including
+ * locations and diagnostics), so that it can be used instead of parsing again
+ * the expression.
+ *
+ * \see gd::ExpressionParser2
+ */
+class GD_CORE_API ExpressionParser2NodeSerializer
+    : public ExpressionParser2NodeWorker {
+ public:
+  ExpressionParser2NodeSerializer(std::string& output_) : output(output_){};
+  virtual ~ExpressionParser2NodeSerializer(){};
+
+  /**
+   * \brief Append the binary representation of the node (and its children)
+   * to the output.
+   */
+  static void SerializeNode(gd::ExpressionNode& node, std::string& output);
+
+  /**
+   * \brief Rebuild a tree from the binary representation starting at \a
+   * position, and move \a position after it.
+   *
+   * \param arena If not null, the arena used to allocate the nodes (see
+   * gd::ExpressionParser2::ParseExpression).
+   * \return The root node, or nullptr if the input is malformed.
+   */
+  static gd::ArenaUniquePtr<gd::ExpressionNode> UnserializeNode(
+      const std::string& input, std::size_t& position,
+      gd::Arena* arena = nullptr);
+
+  /**
+   * \brief Append a number to the output, using less bytes for small numbers.
+   */
+  static void WriteSize(std::size_t size, std::string& output);
+
+  /**
+   * \brief Append a string to the output, prefixed by its size.
+   */
+  static void WriteString(const std::string& str, std::string& output);
+
+  /**
+   * \brief Read a number written with WriteSize.
+   * \return false if the input is malformed.
+   */
+  static bool ReadSize(const std::string& input, std::size_t& position,
+                       std::size_t& size);
+
+  /**
+   * \brief Read a string written with WriteString.
+   * \return false if the input is malformed.
+   */
+  static bool ReadString(const std::string& input, std::size_t& position,
+                         std::string& str);
+
+ protected:
+  void OnVisitSubExpressionNode(SubExpressionNode& node) override;
+  void OnVisitOperatorNode(OperatorNode& node) override;
+  void OnVisitUnaryOperatorNode(UnaryOperatorNode& node) override;
+  void OnVisitNumberNode(NumberNode& node) override;
+  void OnVisitTextNode(TextNode& node) override;
+  void OnVisitVariableNode(VariableNode& node) override;
+  void OnVisitVariableAccessorNode(VariableAccessorNode& node) override;
+  void OnVisitVariableBracketAccessorNode(
+      VariableBracketAccessorNode& node) override;
+  void OnVisitIdentifierNode(IdentifierNode& node) override;
+  void OnVisitObjectFunctionNameNode(ObjectFunctionNameNode& node) override;
+  void OnVisitFunctionCallNode(FunctionCallNode& node) override;
+  void OnVisitEmptyNode(EmptyNode& node) override;
+
+ private:
+  void WriteNodeHeader(unsigned char nodeType, ExpressionNode& node);
+  void WriteChild(ExpressionNode* child);
+  void WriteLocation(const ExpressionParserLocation& location);
+
+  std::string& output;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_EXPRESSIONPARSER2NODESERIALIZER_H
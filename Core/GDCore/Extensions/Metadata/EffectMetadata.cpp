@@ -5,6 +5,8 @@
  */
 #include "EffectMetadata.h"
 
+#include "GDCore/Serialization/SerializerElement.h"
+
 namespace gd {
 
 EffectMetadata& EffectMetadata::SetIncludeFile(const gd::String& includeFile) {
@@ -20,4 +22,60 @@ EffectMetadata& EffectMetadata::AddIncludeFile(const gd::String& includeFile) {
   return *this;
 }
 
+void EffectMetadata::SerializeTo(SerializerElement& element) const {
+  element.SetAttribute("extensionNamespace", extensionNamespace);
+  element.SetAttribute("type", type);
+  element.SetAttribute("helpPath", helpPath);
+  element.SetAttribute("fullname", fullname);
+  element.SetAttribute("description", description);
+  element.SetAttribute("notWorkingForObjects", isMarkedAsNotWorkingForObjects);
+  element.SetAttribute("onlyWorkingFor2D", isMarkedAsOnlyWorkingFor2D);
+  element.SetAttribute("onlyWorkingFor3D", isMarkedAsOnlyWorkingFor3D);
+  element.SetAttribute("unique", isMarkedAsUnique);
+
+  SerializerElement& includeFilesElement = element.AddChild("includeFiles");
+  includeFilesElement.ConsiderAsArrayOf("includeFile");
+  for (const gd::String& includeFile : includeFiles) {
+    includeFilesElement.AddChild("includeFile").SetStringValue(includeFile);
+  }
+
+  SerializerElement& propertiesElement = element.AddChild("properties");
+  propertiesElement.ConsiderAsArrayOf("property");
+  for (const auto& it : properties) {
+    SerializerElement& propertyElement = propertiesElement.AddChild("property");
+    propertyElement.SetAttribute("name", it.first);
+    it.second.SerializeTo(propertyElement);
+  }
+}
+
+void EffectMetadata::UnserializeFrom(const SerializerElement& element) {
+  extensionNamespace = element.GetStringAttribute("extensionNamespace");
+  type = element.GetStringAttribute("type");
+  helpPath = element.GetStringAttribute("helpPath");
+  fullname = element.GetStringAttribute("fullname");
+  description = element.GetStringAttribute("description");
+  isMarkedAsNotWorkingForObjects =
+      element.GetBoolAttribute("notWorkingForObjects");
+  isMarkedAsOnlyWorkingFor2D = element.GetBoolAttribute("onlyWorkingFor2D");
+  isMarkedAsOnlyWorkingFor3D = element.GetBoolAttribute("onlyWorkingFor3D");
+  isMarkedAsUnique = element.GetBoolAttribute("unique");
+
+  includeFiles.clear();
+  const SerializerElement& includeFilesElement =
+      element.GetChild("includeFiles");
+  includeFilesElement.ConsiderAsArrayOf("includeFile");
+  for (std::size_t i = 0; i < includeFilesElement.GetChildrenCount(); ++i) {
+    includeFiles.push_back(includeFilesElement.GetChild(i).GetStringValue());
+  }
+
+  properties.clear();
+  const SerializerElement& propertiesElement = element.GetChild("properties");
+  propertiesElement.ConsiderAsArrayOf("property");
+  for (std::size_t i = 0; i < propertiesElement.GetChildrenCount(); ++i) {
+    const SerializerElement& propertyElement = propertiesElement.GetChild(i);
+    properties[propertyElement.GetStringAttribute("name")].UnserializeFrom(
+        propertyElement);
+  }
+}
+
 }  // namespace gd
@@ -13,6 +13,10 @@
 #include "GDCore/Project/PropertyDescriptor.h"
 #include "GDCore/String.h"
 
+namespace gd {
+class SerializerElement;
+}
+
 namespace gd {
 
 /**
@@ -178,6 +182,17 @@ class GD_CORE_API EffectMetadata {
     return isMarkedAsUnique;
   };
 
+  /**
+   * \brief Serialize the metadata, so that it can be restored without
+   * declaring the effect again.
+   */
+  void SerializeTo(SerializerElement& element) const;
+
+  /**
+   * \brief Unserialize the metadata.
+   */
+  void UnserializeFrom(const SerializerElement& element);
+
  private:
   gd::String extensionNamespace;
   gd::String type;
@@ -6,6 +6,7 @@
 #include "ExpressionMetadata.h"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 
 namespace gd {
@@ -81,4 +82,74 @@ gd::ExpressionMetadata& ExpressionMetadata::SetRequiresBaseObjectCapability(
   return *this;
 }
 
+void ExpressionMetadata::SerializeTo(SerializerElement& element) const {
+  element.SetAttribute("returnType", returnType);
+  element.SetAttribute("fullname", fullname);
+  element.SetAttribute("description", description);
+  element.SetAttribute("helpPath", helpPath);
+  element.SetAttribute("group", group);
+  element.SetAttribute("shown", shown);
+  element.SetAttribute("smallIcon", smallIconFilename);
+  element.SetAttribute("extensionNamespace", extensionNamespace);
+  element.SetAttribute("private", isPrivate);
+  element.SetAttribute("requiredBaseObjectCapability",
+                       requiredBaseObjectCapability);
+  element.SetAttribute("relevantContext", relevantContext);
+
+  gd::SerializerElement& parametersElement = element.AddChild("parameters");
+  parametersElement.ConsiderAsArrayOf("parameter");
+  for (const auto& parameter : parameters) {
+    parameter.SerializeTo(parametersElement.AddChild("parameter"));
+  }
+
+  gd::SerializerElement& codeElement = element.AddChild("code");
+  codeElement.SetAttribute("functionName",
+                           codeExtraInformation.functionCallName);
+  codeElement.SetAttribute("static", codeExtraInformation.staticFunction);
+  gd::SerializerElement& includeFilesElement =
+      codeElement.AddChild("includeFiles");
+  includeFilesElement.ConsiderAsArrayOf("includeFile");
+  for (const gd::String& includeFile : codeExtraInformation.includeFiles) {
+    includeFilesElement.AddChild("includeFile").SetStringValue(includeFile);
+  }
+}
+
+void ExpressionMetadata::UnserializeFrom(const SerializerElement& element) {
+  returnType = element.GetStringAttribute("returnType", "unknown");
+  fullname = element.GetStringAttribute("fullname");
+  description = element.GetStringAttribute("description");
+  helpPath = element.GetStringAttribute("helpPath");
+  group = element.GetStringAttribute("group");
+  shown = element.GetBoolAttribute("shown");
+  smallIconFilename = element.GetStringAttribute("smallIcon");
+  extensionNamespace = element.GetStringAttribute("extensionNamespace");
+  isPrivate = element.GetBoolAttribute("private");
+  requiredBaseObjectCapability =
+      element.GetStringAttribute("requiredBaseObjectCapability");
+  relevantContext = element.GetStringAttribute("relevantContext", "Any");
+
+  parameters.clear();
+  const gd::SerializerElement& parametersElement =
+      element.GetChild("parameters");
+  parametersElement.ConsiderAsArrayOf("parameter");
+  for (std::size_t i = 0; i < parametersElement.GetChildrenCount(); ++i) {
+    gd::ParameterMetadata parameter;
+    parameter.UnserializeFrom(parametersElement.GetChild(i));
+    parameters.push_back(parameter);
+  }
+
+  const gd::SerializerElement& codeElement = element.GetChild("code");
+  codeExtraInformation.functionCallName =
+      codeElement.GetStringAttribute("functionName");
+  codeExtraInformation.staticFunction = codeElement.GetBoolAttribute("static");
+  codeExtraInformation.includeFiles.clear();
+  const gd::SerializerElement& includeFilesElement =
+      codeElement.GetChild("includeFiles");
+  includeFilesElement.ConsiderAsArrayOf("includeFile");
+  for (std::size_t i = 0; i < includeFilesElement.GetChildrenCount(); ++i) {
+    codeExtraInformation.includeFiles.push_back(
+        includeFilesElement.GetChild(i).GetStringValue());
+  }
+}
+
 }  // namespace gd
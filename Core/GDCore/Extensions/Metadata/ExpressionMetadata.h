@@ -15,6 +15,7 @@
 #include "GDCore/String.h"
 namespace gd {
 class Layout;
+class SerializerElement;
 }
 
 namespace gd {
@@ -35,6 +36,7 @@ class ExpressionCodeGenerationInformation {
                            gd::EventsCodeGenerator& codeGenerator,
                            gd::EventsCodeGenerationContext& context)>
       customCodeGenerator;
+  std::function<double(double)> pureFunction;
   std::vector<gd::String> includeFiles;
 };
 
@@ -343,6 +345,35 @@ class GD_CORE_API ExpressionMetadata : public gd::AbstractFunctionMetadata {
 
   bool HasCustomCodeGenerator() const { return codeExtraInformation.hasCustomCodeGenerator; }
 
+  /**
+   * \brief Set that the expression always returns the same number for the
+   * same parameter, without any side effect, so that it can be computed
+   * during code generation when its parameter is constant.
+   *
+   * \param function The C++ equivalent of the function called by the
+   * generated code. It must give exactly the same result whatever the target
+   * (so trigonometric or logarithmic functions, for example, must not be
+   * declared as pure).
+   */
+  ExpressionMetadata& SetPure(std::function<double(double)> function) {
+    codeExtraInformation.pureFunction = function;
+    return *this;
+  }
+
+  /**
+   * \brief Return true if the expression can be computed during code
+   * generation (see SetPure).
+   */
+  bool IsPure() const { return !!codeExtraInformation.pureFunction; }
+
+  /**
+   * \brief Return the C++ equivalent of the function called by the generated
+   * code, if the expression is pure (see SetPure).
+   */
+  const std::function<double(double)>& GetPureFunction() const {
+    return codeExtraInformation.pureFunction;
+  }
+
   /**
    * \brief Return the structure containing the information about code
    * generation for the expression.
@@ -353,6 +384,24 @@ class GD_CORE_API ExpressionMetadata : public gd::AbstractFunctionMetadata {
     return *this;
   }
 
+  /**
+   * \brief Serialize the metadata, including the information about code
+   * generation, so that it can be restored without declaring the expression
+   * again.
+   *
+   * \note The custom code generator and the pure function (if any) can't be
+   * serialized.
+   */
+  void SerializeTo(SerializerElement& element) const;
+
+  /**
+   * \brief Unserialize the metadata.
+   *
+   * \note The custom code generator and the pure function (if any) are kept,
+   * so that they can be set before or after unserializing.
+   */
+  void UnserializeFrom(const SerializerElement& element);
+
   ExpressionCodeGenerationInformation codeExtraInformation;
 
  private:
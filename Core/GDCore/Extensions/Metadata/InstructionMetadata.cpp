@@ -223,4 +223,112 @@ InstructionMetadata& InstructionMetadata::SetRequiresBaseObjectCapability(
   return *this;
 }
 
+void InstructionMetadata::SerializeTo(SerializerElement& element) const {
+  element.SetAttribute("fullname", fullname);
+  element.SetAttribute("description", description);
+  element.SetAttribute("helpPath", helpPath);
+  element.SetAttribute("sentence", sentence);
+  element.SetAttribute("group", group);
+  element.SetAttribute("icon", iconFilename);
+  element.SetAttribute("smallIcon", smallIconFilename);
+  element.SetAttribute("canHaveSubInstructions", canHaveSubInstructions);
+  element.SetAttribute("extensionNamespace", extensionNamespace);
+  element.SetAttribute("hidden", hidden);
+  element.SetAttribute("usageComplexity", usageComplexity);
+  element.SetAttribute("private", isPrivate);
+  element.SetAttribute("objectInstruction", isObjectInstruction);
+  element.SetAttribute("behaviorInstruction", isBehaviorInstruction);
+  element.SetAttribute("requiredBaseObjectCapability",
+                       requiredBaseObjectCapability);
+  element.SetAttribute("relevantContext", relevantContext);
+
+  gd::SerializerElement& parametersElement = element.AddChild("parameters");
+  parametersElement.ConsiderAsArrayOf("parameter");
+  for (const auto& parameter : parameters) {
+    parameter.SerializeTo(parametersElement.AddChild("parameter"));
+  }
+
+  gd::SerializerElement& codeElement = element.AddChild("code");
+  codeElement.SetAttribute("functionName",
+                           codeExtraInformation.functionCallName);
+  codeElement.SetAttribute("asyncFunctionName",
+                           codeExtraInformation.asyncFunctionCallName);
+  codeElement.SetAttribute("type", codeExtraInformation.type);
+  codeElement.SetAttribute("accessType",
+                           static_cast<int>(codeExtraInformation.accessType));
+  codeElement.SetAttribute("associatedInstruction",
+                           codeExtraInformation.optionalAssociatedInstruction);
+  gd::SerializerElement& mutatorsElement = codeElement.AddChild("mutators");
+  mutatorsElement.ConsiderAsArrayOf("mutator");
+  for (const auto& it : codeExtraInformation.optionalMutators) {
+    gd::SerializerElement& mutatorElement = mutatorsElement.AddChild("mutator");
+    mutatorElement.SetAttribute("name", it.first);
+    mutatorElement.SetAttribute("functionName", it.second);
+  }
+  gd::SerializerElement& includeFilesElement =
+      codeElement.AddChild("includeFiles");
+  includeFilesElement.ConsiderAsArrayOf("includeFile");
+  for (const gd::String& includeFile : codeExtraInformation.includeFiles) {
+    includeFilesElement.AddChild("includeFile").SetStringValue(includeFile);
+  }
+}
+
+void InstructionMetadata::UnserializeFrom(const SerializerElement& element) {
+  fullname = element.GetStringAttribute("fullname");
+  description = element.GetStringAttribute("description");
+  helpPath = element.GetStringAttribute("helpPath");
+  sentence = element.GetStringAttribute("sentence");
+  group = element.GetStringAttribute("group");
+  iconFilename = element.GetStringAttribute("icon");
+  smallIconFilename = element.GetStringAttribute("smallIcon");
+  canHaveSubInstructions = element.GetBoolAttribute("canHaveSubInstructions");
+  extensionNamespace = element.GetStringAttribute("extensionNamespace");
+  hidden = element.GetBoolAttribute("hidden");
+  usageComplexity = element.GetIntAttribute("usageComplexity", 5);
+  isPrivate = element.GetBoolAttribute("private");
+  isObjectInstruction = element.GetBoolAttribute("objectInstruction");
+  isBehaviorInstruction = element.GetBoolAttribute("behaviorInstruction");
+  requiredBaseObjectCapability =
+      element.GetStringAttribute("requiredBaseObjectCapability");
+  relevantContext = element.GetStringAttribute("relevantContext", "Any");
+
+  parameters.clear();
+  const gd::SerializerElement& parametersElement =
+      element.GetChild("parameters");
+  parametersElement.ConsiderAsArrayOf("parameter");
+  for (std::size_t i = 0; i < parametersElement.GetChildrenCount(); ++i) {
+    ParameterMetadata parameter;
+    parameter.UnserializeFrom(parametersElement.GetChild(i));
+    parameters.push_back(parameter);
+  }
+
+  const gd::SerializerElement& codeElement = element.GetChild("code");
+  codeExtraInformation.functionCallName =
+      codeElement.GetStringAttribute("functionName");
+  codeExtraInformation.asyncFunctionCallName =
+      codeElement.GetStringAttribute("asyncFunctionName");
+  codeExtraInformation.type = codeElement.GetStringAttribute("type");
+  codeExtraInformation.accessType = static_cast<ExtraInformation::AccessType>(
+      codeElement.GetIntAttribute("accessType"));
+  codeExtraInformation.optionalAssociatedInstruction =
+      codeElement.GetStringAttribute("associatedInstruction");
+  codeExtraInformation.optionalMutators.clear();
+  const gd::SerializerElement& mutatorsElement =
+      codeElement.GetChild("mutators");
+  mutatorsElement.ConsiderAsArrayOf("mutator");
+  for (std::size_t i = 0; i < mutatorsElement.GetChildrenCount(); ++i) {
+    const gd::SerializerElement& mutatorElement = mutatorsElement.GetChild(i);
+    codeExtraInformation.optionalMutators[mutatorElement.GetStringAttribute(
+        "name")] = mutatorElement.GetStringAttribute("functionName");
+  }
+  codeExtraInformation.includeFiles.clear();
+  const gd::SerializerElement& includeFilesElement =
+      codeElement.GetChild("includeFiles");
+  includeFilesElement.ConsiderAsArrayOf("includeFile");
+  for (std::size_t i = 0; i < includeFilesElement.GetChildrenCount(); ++i) {
+    codeExtraInformation.includeFiles.push_back(
+        includeFilesElement.GetChild(i).GetStringValue());
+  }
+}
+
 }  // namespace gd
@@ -560,6 +560,23 @@ class GD_CORE_API InstructionMetadata : public gd::AbstractFunctionMetadata {
    */
   InstructionMetadata &GetCodeExtraInformation() { return *this; }
 
+  /**
+   * \brief Serialize the metadata, including the information about code
+   * generation, so that it can be restored without declaring the instruction
+   * again.
+   *
+   * \note The custom code generator (if any) can't be serialized.
+   */
+  void SerializeTo(SerializerElement &element) const;
+
+  /**
+   * \brief Unserialize the metadata.
+   *
+   * \note The custom code generator (if any) is kept, so that it can be set
+   * before or after unserializing.
+   */
+  void UnserializeFrom(const SerializerElement &element);
+
   std::vector<ParameterMetadata> parameters;
 
  private:
@@ -11,11 +11,13 @@
 #include "GDCore/Extensions/Metadata/EffectMetadata.h"
 #include "GDCore/Extensions/Metadata/InstructionMetadata.h"
 #include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Metadata/PlatformMetadataIndex.h"
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/Project/Layout.h"  // For GetTypeOfObject and GetTypeOfBehavior
 #include "GDCore/Project/ObjectsContainersList.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/InternedString.h"
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
 
 using namespace std;
@@ -29,16 +31,39 @@ gd::InstructionMetadata MetadataProvider::badInstructionMetadata;
 gd::ExpressionMetadata MetadataProvider::badExpressionMetadata;
 gd::PlatformExtension MetadataProvider::badExtension;
 
+namespace {
+/**
+ * Search metadata in the index of the platform using \a find. Extensions not
+ * created yet that could declare \a type are created first, even if it's
+ * already declared by another extension, as the metadata of the extension
+ * added first are used.
+ */
+template <class T, class Finder>
+ExtensionAndMetadata<T> FindMetadata(const gd::Platform& platform,
+                                     const gd::String& type,
+                                     Finder find,
+                                     const gd::PlatformExtension& badExtension,
+                                     const T& badMetadata) {
+  platform.DeclareLazyExtensionsForType(type);
+
+  // Keep the index alive while it's used, as another thread could replace it.
+  auto index = platform.GetMetadataIndex();
+  const ExtensionAndMetadata<T>* found = find(*index);
+  return found ? *found : ExtensionAndMetadata<T>(badExtension, badMetadata);
+}
+}  // namespace
+
 ExtensionAndMetadata<BehaviorMetadata>
 MetadataProvider::GetExtensionAndBehaviorMetadata(const gd::Platform& platform,
                                                   gd::String behaviorType) {
-  for (auto& extension : platform.GetAllPlatformExtensions()) {
-    if (extension->HasBehavior(behaviorType))
-      return ExtensionAndMetadata<BehaviorMetadata>(
-          *extension, extension->GetBehaviorMetadata(behaviorType));
-  }
-
-  return ExtensionAndMetadata<BehaviorMetadata>(badExtension, badBehaviorMetadata);
+  return FindMetadata(
+      platform,
+      behaviorType,
+      [&behaviorType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.behaviors, behaviorType);
+      },
+      badExtension,
+      badBehaviorMetadata);
 }
 
 const BehaviorMetadata& MetadataProvider::GetBehaviorMetadata(
@@ -49,16 +74,14 @@ const BehaviorMetadata& MetadataProvider::GetBehaviorMetadata(
 ExtensionAndMetadata<ObjectMetadata>
 MetadataProvider::GetExtensionAndObjectMetadata(const gd::Platform& platform,
                                                 gd::String objectType) {
-  for (auto& extension : platform.GetAllPlatformExtensions()) {
-    auto objectsTypes = extension->GetExtensionObjectsTypes();
-    for (std::size_t j = 0; j < objectsTypes.size(); ++j) {
-      if (objectsTypes[j] == objectType)
-        return ExtensionAndMetadata<ObjectMetadata>(
-            *extension, extension->GetObjectMetadata(objectType));
-    }
-  }
-
-  return ExtensionAndMetadata<ObjectMetadata>(badExtension, badObjectInfo);
+  return FindMetadata(
+      platform,
+      objectType,
+      [&objectType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.objects, objectType);
+      },
+      badExtension,
+      badObjectInfo);
 }
 
 const ObjectMetadata& MetadataProvider::GetObjectMetadata(
@@ -69,16 +92,14 @@ const ObjectMetadata& MetadataProvider::GetObjectMetadata(
 ExtensionAndMetadata<EffectMetadata>
 MetadataProvider::GetExtensionAndEffectMetadata(const gd::Platform& platform,
                                                 gd::String type) {
-  for (auto& extension : platform.GetAllPlatformExtensions()) {
-    auto objectsTypes = extension->GetExtensionEffectTypes();
-    for (std::size_t j = 0; j < objectsTypes.size(); ++j) {
-      if (objectsTypes[j] == type)
-        return ExtensionAndMetadata<EffectMetadata>(
-            *extension, extension->GetEffectMetadata(type));
-    }
-  }
-
-  return ExtensionAndMetadata<EffectMetadata>(badExtension, badEffectMetadata);
+  return FindMetadata(
+      platform,
+      type,
+      [&type](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.effects, type);
+      },
+      badExtension,
+      badEffectMetadata);
 }
 
 const EffectMetadata& MetadataProvider::GetEffectMetadata(
@@ -89,34 +110,14 @@ const EffectMetadata& MetadataProvider::GetEffectMetadata(
 ExtensionAndMetadata<InstructionMetadata>
 MetadataProvider::GetExtensionAndActionMetadata(const gd::Platform& platform,
                                                 gd::String actionType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allActions = extension->GetAllActions();
-    if (allActions.find(actionType) != allActions.end())
-      return ExtensionAndMetadata<InstructionMetadata>(
-          *extension, allActions.find(actionType)->second);
-
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    for (const gd::String& extObjectType : objects) {
-      const auto& allObjectsActions =
-          extension->GetAllActionsForObject(extObjectType);
-      if (allObjectsActions.find(actionType) != allObjectsActions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allObjectsActions.find(actionType)->second);
-    }
-
-    const auto& autos = extension->GetBehaviorsTypes();
-    for (std::size_t j = 0; j < autos.size(); ++j) {
-      const auto& allAutosActions =
-          extension->GetAllActionsForBehavior(autos[j]);
-      if (allAutosActions.find(actionType) != allAutosActions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allAutosActions.find(actionType)->second);
-    }
-  }
-
-  return ExtensionAndMetadata<InstructionMetadata>(badExtension,
-                                                   badInstructionMetadata);
+  return FindMetadata(
+      platform,
+      actionType,
+      [&actionType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.actions, actionType);
+      },
+      badExtension,
+      badInstructionMetadata);
 }
 
 const gd::InstructionMetadata& MetadataProvider::GetActionMetadata(
@@ -124,37 +125,35 @@ const gd::InstructionMetadata& MetadataProvider::GetActionMetadata(
   return GetExtensionAndActionMetadata(platform, actionType).GetMetadata();
 }
 
+ExtensionAndMetadata<InstructionMetadata>
+MetadataProvider::GetExtensionAndActionMetadata(
+    const gd::Platform& platform, const gd::InternedString& actionType) {
+  return FindMetadata(
+      platform,
+      actionType.GetString(),
+      [&actionType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.actions, actionType);
+      },
+      badExtension,
+      badInstructionMetadata);
+}
+
+const gd::InstructionMetadata& MetadataProvider::GetActionMetadata(
+    const gd::Platform& platform, const gd::InternedString& actionType) {
+  return GetExtensionAndActionMetadata(platform, actionType).GetMetadata();
+}
+
 ExtensionAndMetadata<InstructionMetadata>
 MetadataProvider::GetExtensionAndConditionMetadata(const gd::Platform& platform,
                                                    gd::String conditionType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allConditions = extension->GetAllConditions();
-    if (allConditions.find(conditionType) != allConditions.end())
-      return ExtensionAndMetadata<InstructionMetadata>(
-          *extension, allConditions.find(conditionType)->second);
-
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    for (const gd::String& extObjectType : objects) {
-      const auto& allObjectsConditions =
-          extension->GetAllConditionsForObject(extObjectType);
-      if (allObjectsConditions.find(conditionType) != allObjectsConditions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allObjectsConditions.find(conditionType)->second);
-    }
-
-    const auto& autos = extension->GetBehaviorsTypes();
-    for (std::size_t j = 0; j < autos.size(); ++j) {
-      const auto& allAutosConditions =
-          extension->GetAllConditionsForBehavior(autos[j]);
-      if (allAutosConditions.find(conditionType) != allAutosConditions.end())
-        return ExtensionAndMetadata<InstructionMetadata>(
-            *extension, allAutosConditions.find(conditionType)->second);
-    }
-  }
-
-  return ExtensionAndMetadata<InstructionMetadata>(badExtension,
-                                                   badInstructionMetadata);
+  return FindMetadata(
+      platform,
+      conditionType,
+      [&conditionType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.conditions, conditionType);
+      },
+      badExtension,
+      badInstructionMetadata);
 }
 
 const gd::InstructionMetadata& MetadataProvider::GetConditionMetadata(
@@ -163,32 +162,50 @@ const gd::InstructionMetadata& MetadataProvider::GetConditionMetadata(
       .GetMetadata();
 }
 
+ExtensionAndMetadata<InstructionMetadata>
+MetadataProvider::GetExtensionAndConditionMetadata(
+    const gd::Platform& platform, const gd::InternedString& conditionType) {
+  return FindMetadata(
+      platform,
+      conditionType.GetString(),
+      [&conditionType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.conditions, conditionType);
+      },
+      badExtension,
+      badInstructionMetadata);
+}
+
+const gd::InstructionMetadata& MetadataProvider::GetConditionMetadata(
+    const gd::Platform& platform, const gd::InternedString& conditionType) {
+  return GetExtensionAndConditionMetadata(platform, conditionType)
+      .GetMetadata();
+}
+
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndObjectExpressionMetadata(
     const gd::Platform& platform, gd::String objectType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    if (find(objects.begin(), objects.end(), objectType) != objects.end()) {
-      const auto& allObjectExpressions =
-          extension->GetAllExpressionsForObject(objectType);
-      if (allObjectExpressions.find(exprType) != allObjectExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allObjectExpressions.find(exprType)->second);
-    }
-  }
+  auto extensionAndMetadata = FindMetadata(
+      platform,
+      objectType,
+      [&objectType, &exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.objectsExpressions, objectType, exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
+  if (!IsBadExpressionMetadata(extensionAndMetadata.GetMetadata()))
+    return extensionAndMetadata;
 
   // Then check base
-  for (auto& extension : extensions) {
-    const auto& allObjectExpressions =
-        extension->GetAllExpressionsForObject("");
-    if (allObjectExpressions.find(exprType) != allObjectExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allObjectExpressions.find(exprType)->second);
-  }
-
-  return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
-                                                  badExpressionMetadata);
+  return FindMetadata(
+      platform,
+      "",
+      [&exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.objectsExpressions, "", exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetObjectExpressionMetadata(
@@ -200,28 +217,28 @@ const gd::ExpressionMetadata& MetadataProvider::GetObjectExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndBehaviorExpressionMetadata(
     const gd::Platform& platform, gd::String autoType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    if (extension->HasBehavior(autoType)) {
-      const auto& allAutoExpressions =
-          extension->GetAllExpressionsForBehavior(autoType);
-      if (allAutoExpressions.find(exprType) != allAutoExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allAutoExpressions.find(exprType)->second);
-    }
-  }
+  auto extensionAndMetadata = FindMetadata(
+      platform,
+      autoType,
+      [&autoType, &exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.behaviorsExpressions, autoType, exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
+  if (!IsBadExpressionMetadata(extensionAndMetadata.GetMetadata()))
+    return extensionAndMetadata;
 
   // Then check base
-  for (auto& extension : extensions) {
-    const auto& allAutoExpressions =
-        extension->GetAllExpressionsForBehavior("");
-    if (allAutoExpressions.find(exprType) != allAutoExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allAutoExpressions.find(exprType)->second);
-  }
-
-  return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
-                                                  badExpressionMetadata);
+  return FindMetadata(
+      platform,
+      "",
+      [&exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.behaviorsExpressions, "", exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetBehaviorExpressionMetadata(
@@ -233,16 +250,14 @@ const gd::ExpressionMetadata& MetadataProvider::GetBehaviorExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndExpressionMetadata(
     const gd::Platform& platform, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allExpr = extension->GetAllExpressions();
-    if (allExpr.find(exprType) != allExpr.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allExpr.find(exprType)->second);
-  }
-
-  return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
-                                                  badExpressionMetadata);
+  return FindMetadata(
+      platform,
+      exprType,
+      [&exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.expressions, exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetExpressionMetadata(
@@ -253,30 +268,28 @@ const gd::ExpressionMetadata& MetadataProvider::GetExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndObjectStrExpressionMetadata(
     const gd::Platform& platform, gd::String objectType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& objects = extension->GetExtensionObjectsTypes();
-    if (find(objects.begin(), objects.end(), objectType) != objects.end()) {
-      const auto& allObjectStrExpressions =
-          extension->GetAllStrExpressionsForObject(objectType);
-      if (allObjectStrExpressions.find(exprType) !=
-          allObjectStrExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allObjectStrExpressions.find(exprType)->second);
-    }
-  }
+  auto extensionAndMetadata = FindMetadata(
+      platform,
+      objectType,
+      [&objectType, &exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.objectsStrExpressions, objectType, exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
+  if (!IsBadExpressionMetadata(extensionAndMetadata.GetMetadata()))
+    return extensionAndMetadata;
 
   // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& allObjectStrExpressions =
-        extension->GetAllStrExpressionsForObject("");
-    if (allObjectStrExpressions.find(exprType) != allObjectStrExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allObjectStrExpressions.find(exprType)->second);
-  }
-
-  return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
-                                                  badExpressionMetadata);
+  return FindMetadata(
+      platform,
+      "",
+      [&exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.objectsStrExpressions, "", exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetObjectStrExpressionMetadata(
@@ -289,30 +302,28 @@ const gd::ExpressionMetadata& MetadataProvider::GetObjectStrExpressionMetadata(
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndBehaviorStrExpressionMetadata(
     const gd::Platform& platform, gd::String autoType, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    if (extension->HasBehavior(autoType)) {
-      const auto& allBehaviorStrExpressions =
-          extension->GetAllStrExpressionsForBehavior(autoType);
-      if (allBehaviorStrExpressions.find(exprType) !=
-          allBehaviorStrExpressions.end())
-        return ExtensionAndMetadata<ExpressionMetadata>(
-            *extension, allBehaviorStrExpressions.find(exprType)->second);
-    }
-  }
+  auto extensionAndMetadata = FindMetadata(
+      platform,
+      autoType,
+      [&autoType, &exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.behaviorsStrExpressions, autoType, exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
+  if (!IsBadExpressionMetadata(extensionAndMetadata.GetMetadata()))
+    return extensionAndMetadata;
 
   // Then check in functions of "Base object".
-  for (auto& extension : extensions) {
-    const auto& allBehaviorStrExpressions =
-        extension->GetAllStrExpressionsForBehavior("");
-    if (allBehaviorStrExpressions.find(exprType) !=
-        allBehaviorStrExpressions.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allBehaviorStrExpressions.find(exprType)->second);
-  }
-
-  return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
-                                                  badExpressionMetadata);
+  return FindMetadata(
+      platform,
+      "",
+      [&exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(
+            index.behaviorsStrExpressions, "", exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
 }
 
 const gd::ExpressionMetadata&
@@ -327,16 +338,14 @@ MetadataProvider::GetBehaviorStrExpressionMetadata(const gd::Platform& platform,
 ExtensionAndMetadata<ExpressionMetadata>
 MetadataProvider::GetExtensionAndStrExpressionMetadata(
     const gd::Platform& platform, gd::String exprType) {
-  auto& extensions = platform.GetAllPlatformExtensions();
-  for (auto& extension : extensions) {
-    const auto& allExpr = extension->GetAllStrExpressions();
-    if (allExpr.find(exprType) != allExpr.end())
-      return ExtensionAndMetadata<ExpressionMetadata>(
-          *extension, allExpr.find(exprType)->second);
-  }
-
-  return ExtensionAndMetadata<ExpressionMetadata>(badExtension,
-                                                  badExpressionMetadata);
+  return FindMetadata(
+      platform,
+      exprType,
+      [&exprType](const PlatformMetadataIndex& index) {
+        return PlatformMetadataIndex::Find(index.strExpressions, exprType);
+      },
+      badExtension,
+      badExpressionMetadata);
 }
 
 const gd::ExpressionMetadata& MetadataProvider::GetStrExpressionMetadata(
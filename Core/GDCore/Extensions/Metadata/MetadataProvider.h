@@ -13,6 +13,7 @@ class ObjectMetadata;
 class EffectMetadata;
 class ExpressionMetadata;
 class ExpressionMetadata;
+class InternedString;
 class Platform;
 class PlatformExtension;
 class ObjectsContainersList;
@@ -89,6 +90,14 @@ class GD_CORE_API MetadataProvider {
   GetExtensionAndActionMetadata(const gd::Platform& platform,
                                 gd::String actionType);
 
+  /**
+   * Get the metadata of an action, and its associated extension, from its
+   * interned type (see gd::Instruction::GetInternedType).
+   */
+  static ExtensionAndMetadata<InstructionMetadata>
+  GetExtensionAndActionMetadata(const gd::Platform& platform,
+                                const gd::InternedString& actionType);
+
   /**
    * Get the metadata of a condition, and its associated extension.
    * Works for object, behaviors and static conditions.
@@ -97,6 +106,14 @@ class GD_CORE_API MetadataProvider {
   GetExtensionAndConditionMetadata(const gd::Platform& platform,
                                    gd::String conditionType);
 
+  /**
+   * Get the metadata of a condition, and its associated extension, from its
+   * interned type (see gd::Instruction::GetInternedType).
+   */
+  static ExtensionAndMetadata<InstructionMetadata>
+  GetExtensionAndConditionMetadata(const gd::Platform& platform,
+                                   const gd::InternedString& conditionType);
+
   /**
    * Get information about an expression, and its associated extension.
    * Works for free expressions.
@@ -174,6 +191,13 @@ class GD_CORE_API MetadataProvider {
   static const gd::InstructionMetadata& GetActionMetadata(
       const gd::Platform& platform, gd::String actionType);
 
+  /**
+   * Get the metadata of an action from its interned type (see
+   * gd::Instruction::GetInternedType).
+   */
+  static const gd::InstructionMetadata& GetActionMetadata(
+      const gd::Platform& platform, const gd::InternedString& actionType);
+
   /**
    * Get the metadata of a condition.
    * Works for object, behaviors and static conditions.
@@ -181,6 +205,13 @@ class GD_CORE_API MetadataProvider {
   static const gd::InstructionMetadata& GetConditionMetadata(
       const gd::Platform& platform, gd::String conditionType);
 
+  /**
+   * Get the metadata of a condition from its interned type (see
+   * gd::Instruction::GetInternedType).
+   */
+  static const gd::InstructionMetadata& GetConditionMetadata(
+      const gd::Platform& platform, const gd::InternedString& conditionType);
+
   /**
    * Get information about an expression from its type
    * Works for free expressions.
@@ -159,7 +159,7 @@ void ParameterMetadataTools::IterateOverParametersWithIndex(
     const gd::Platform &platform,
     const gd::ObjectsContainersList &objectsContainersList, FunctionCallNode &node,
     std::function<void(const gd::ParameterMetadata &parameterMetadata,
-                       std::unique_ptr<gd::ExpressionNode> &parameterNode,
+                       gd::ArenaUniquePtr<gd::ExpressionNode> &parameterNode,
                        size_t parameterIndex, const gd::String &lastObjectName)>
         fn) {
   gd::String lastObjectName = node.objectName;
@@ -8,6 +8,7 @@
 #include <vector>
 #include <memory>
 #include "GDCore/String.h"
+#include "GDCore/Tools/Arena.h"
 namespace gd {
 class Platform;
 class Project;
@@ -74,7 +75,7 @@ class GD_CORE_API ParameterMetadataTools {
       const gd::Platform &platform,
       const gd::ObjectsContainersList &objectsContainersList, FunctionCallNode &node,
       std::function<void(const gd::ParameterMetadata &parameterMetadata,
-                         std::unique_ptr<gd::ExpressionNode> &parameterNode,
+                         gd::ArenaUniquePtr<gd::ExpressionNode> &parameterNode,
                          size_t parameterIndex,
                          const gd::String &lastObjectName)>
           fn);
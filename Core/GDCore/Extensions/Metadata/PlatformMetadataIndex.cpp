@@ -0,0 +1,128 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Extensions/Metadata/PlatformMetadataIndex.h"
+
+#include <map>
+
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/EffectMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/String.h"
+
+namespace gd {
+
+template <class T>
+void PlatformMetadataIndex::AddMetadata(MetadataMap<T>& map,
+                                        const gd::String& type,
+                                        const gd::PlatformExtension& extension,
+                                        const T& metadata,
+                                        std::size_t rank) {
+  auto result = map.emplace(gd::InternedString(type),
+                            ExtensionAndMetadata<T>(extension, metadata));
+  // Keep the metadata of the first extension declaring the type, like when
+  // searching the extensions one by one.
+  if (!result.second &&
+      extensionsRanks[&result.first->second.GetExtension()] > rank)
+    result.first->second = ExtensionAndMetadata<T>(extension, metadata);
+}
+
+template <class T>
+void PlatformMetadataIndex::AddAllMetadata(
+    MetadataMap<T>& map,
+    const std::map<gd::String, T>& allMetadata,
+    const gd::PlatformExtension& extension,
+    std::size_t rank) {
+  for (const auto& it : allMetadata)
+    AddMetadata(map, it.first, extension, it.second, rank);
+}
+
+PlatformMetadataIndex::PlatformMetadataIndex(
+    const std::vector<std::shared_ptr<gd::PlatformExtension>>& extensions,
+    const std::vector<std::size_t>& ranks) {
+  for (std::size_t i = 0; i < extensions.size(); ++i)
+    AddExtension(*extensions[i], ranks[i]);
+}
+
+void PlatformMetadataIndex::AddExtension(gd::PlatformExtension& extension,
+                                         std::size_t rank) {
+  extensionsRanks[&extension] = rank;
+  const auto objectsTypes = extension.GetExtensionObjectsTypes();
+  const auto behaviorsTypes = extension.GetBehaviorsTypes();
+
+  for (const gd::String& objectType : objectsTypes) {
+    AddMetadata(objects,
+                objectType,
+                extension,
+                extension.GetObjectMetadata(objectType),
+                rank);
+  }
+  for (const gd::String& behaviorType : behaviorsTypes) {
+    AddMetadata(behaviors,
+                behaviorType,
+                extension,
+                extension.GetBehaviorMetadata(behaviorType),
+                rank);
+  }
+  for (const gd::String& effectType : extension.GetExtensionEffectTypes()) {
+    AddMetadata(effects,
+                effectType,
+                extension,
+                extension.GetEffectMetadata(effectType),
+                rank);
+  }
+
+  // Free instructions of an extension are found before the ones of its
+  // objects, and then before the ones of its behaviors.
+  AddAllMetadata(actions, extension.GetAllActions(), extension, rank);
+  AddAllMetadata(conditions, extension.GetAllConditions(), extension, rank);
+  for (const gd::String& objectType : objectsTypes) {
+    AddAllMetadata(
+        actions, extension.GetAllActionsForObject(objectType), extension, rank);
+    AddAllMetadata(conditions,
+                   extension.GetAllConditionsForObject(objectType),
+                   extension,
+                   rank);
+  }
+  for (const gd::String& behaviorType : behaviorsTypes) {
+    AddAllMetadata(actions,
+                   extension.GetAllActionsForBehavior(behaviorType),
+                   extension,
+                   rank);
+    AddAllMetadata(conditions,
+                   extension.GetAllConditionsForBehavior(behaviorType),
+                   extension,
+                   rank);
+  }
+
+  AddAllMetadata(expressions, extension.GetAllExpressions(), extension, rank);
+  AddAllMetadata(
+      strExpressions, extension.GetAllStrExpressions(), extension, rank);
+  for (const gd::String& objectType : objectsTypes) {
+    AddAllMetadata(objectsExpressions[gd::InternedString(objectType)],
+                   extension.GetAllExpressionsForObject(objectType),
+                   extension,
+                   rank);
+    AddAllMetadata(objectsStrExpressions[gd::InternedString(objectType)],
+                   extension.GetAllStrExpressionsForObject(objectType),
+                   extension,
+                   rank);
+  }
+  for (const gd::String& behaviorType : behaviorsTypes) {
+    AddAllMetadata(behaviorsExpressions[gd::InternedString(behaviorType)],
+                   extension.GetAllExpressionsForBehavior(behaviorType),
+                   extension,
+                   rank);
+    AddAllMetadata(behaviorsStrExpressions[gd::InternedString(behaviorType)],
+                   extension.GetAllStrExpressionsForBehavior(behaviorType),
+                   extension,
+                   rank);
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,149 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_PLATFORMMETADATAINDEX_H
+#define GDCORE_PLATFORMMETADATAINDEX_H
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/String.h"
+#include "GDCore/Tools/InternedString.h"
+namespace gd {
+class BehaviorMetadata;
+class ObjectMetadata;
+class EffectMetadata;
+class ExpressionMetadata;
+class InstructionMetadata;
+class PlatformExtension;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief An index of the metadata declared by the extensions of a platform,
+ * so that gd::MetadataProvider can find the metadata of an
+ * object/behavior/instruction/expression with a single hash lookup.
+ *
+ * Types are interned (see gd::InternedString), so that searching with the
+ * type of an instruction (see gd::Instruction::GetInternedType) only hashes
+ * and compares pointers.
+ *
+ * The index is built by gd::Platform from its extensions. The extensions
+ * created or added afterwards are added to a copy of the index, and the index
+ * is rebuilt when extensions are removed. When a type is declared by multiple
+ * extensions, the first extension added to the platform declaring it is used.
+ *
+ * \see gd::Platform::GetMetadataIndex
+ * \ingroup PlatformDefinition
+ */
+class GD_CORE_API PlatformMetadataIndex {
+ public:
+  template <class T>
+  using MetadataMap =
+      std::unordered_map<gd::InternedString, ExtensionAndMetadata<T>>;
+  template <class T>
+  using MetadataByTypeMap =
+      std::unordered_map<gd::InternedString, MetadataMap<T>>;
+
+  /**
+   * \brief Index the metadata of the given extensions.
+   *
+   * \param ranks The order in which each extension was added to the platform
+   * (see AddExtension).
+   */
+  PlatformMetadataIndex(
+      const std::vector<std::shared_ptr<gd::PlatformExtension>>& extensions,
+      const std::vector<std::size_t>& ranks);
+
+  /**
+   * \brief Add the metadata declared by an extension to the index.
+   *
+   * \param rank The order in which the extension was added to the platform:
+   * the types it declares replace the ones declared by extensions with a
+   * greater rank, and not the other ones.
+   */
+  void AddExtension(gd::PlatformExtension& extension, std::size_t rank);
+
+  /**
+   * \brief Return the metadata of the element with the given type, or nullptr
+   * if it does not exist.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const MetadataMap<T>& map,
+                                             const gd::InternedString& type) {
+    auto it = map.find(type);
+    return it != map.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * \brief Return the metadata of the element with the given type, or nullptr
+   * if it does not exist.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const MetadataMap<T>& map,
+                                             const gd::String& type) {
+    // A type which was never interned is not declared by any extension.
+    gd::InternedString internedType;
+    return gd::InternedString::FindInterned(type, internedType)
+               ? Find(map, internedType)
+               : nullptr;
+  }
+
+  /**
+   * \brief Return the metadata of the function \a type of the object or
+   * behavior with type \a ownerType, or nullptr if it does not exist.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const MetadataByTypeMap<T>& map,
+                                             const gd::String& ownerType,
+                                             const gd::String& type) {
+    gd::InternedString internedOwnerType;
+    if (!gd::InternedString::FindInterned(ownerType, internedOwnerType))
+      return nullptr;
+
+    auto it = map.find(internedOwnerType);
+    return it != map.end() ? Find(it->second, type) : nullptr;
+  }
+
+  MetadataMap<BehaviorMetadata> behaviors;
+  MetadataMap<ObjectMetadata> objects;
+  MetadataMap<EffectMetadata> effects;
+
+  /** Actions and conditions, whether they are free or belong to an object or a
+   * behavior. */
+  MetadataMap<InstructionMetadata> actions;
+  MetadataMap<InstructionMetadata> conditions;
+
+  MetadataMap<ExpressionMetadata> expressions;
+  MetadataMap<ExpressionMetadata> strExpressions;
+  MetadataByTypeMap<ExpressionMetadata> objectsExpressions;
+  MetadataByTypeMap<ExpressionMetadata> objectsStrExpressions;
+  MetadataByTypeMap<ExpressionMetadata> behaviorsExpressions;
+  MetadataByTypeMap<ExpressionMetadata> behaviorsStrExpressions;
+
+ private:
+  template <class T>
+  void AddMetadata(MetadataMap<T>& map,
+                   const gd::String& type,
+                   const gd::PlatformExtension& extension,
+                   const T& metadata,
+                   std::size_t rank);
+
+  template <class T>
+  void AddAllMetadata(MetadataMap<T>& map,
+                      const std::map<gd::String, T>& allMetadata,
+                      const gd::PlatformExtension& extension,
+                      std::size_t rank);
+
+  std::unordered_map<const gd::PlatformExtension*, std::size_t>
+      extensionsRanks;  ///< The rank of each indexed extension.
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_PLATFORMMETADATAINDEX_H
@@ -5,11 +5,17 @@
  */
 #include "Platform.h"
 
+#include <algorithm>
+
+#include "GDCore/Extensions/Metadata/PlatformMetadataIndex.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/Project/Object.h"
 #include "GDCore/Project/ObjectConfiguration.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/MakeUnique.h"
+#include "GDCore/Tools/VersionWrapper.h"
 
 using namespace std;
 
@@ -20,7 +26,10 @@ namespace gd {
 InstructionOrExpressionGroupMetadata
     Platform::badInstructionOrExpressionGroupMetadata;
 
-Platform::Platform() : enableExtensionLoadingLogs(false) {}
+Platform::Platform()
+    : extensionsAddedCount(0),
+      enableExtensionLoadingLogs(false),
+      lazyExtensionsCount(0) {}
 
 Platform::~Platform() {}
 
@@ -36,56 +45,278 @@ bool Platform::AddExtension(std::shared_ptr<gd::PlatformExtension> extension) {
   }
   if (enableExtensionLoadingLogs) std::cout << std::endl;
 
-  extensionsLoaded.push_back(extension);
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  auto snapshotIt = extensionsMetadataSnapshots.find(extension->GetName());
+  if (snapshotIt != extensionsMetadataSnapshots.end())
+    extension->UnserializeMetadataFrom(*snapshotIt->second);
+
+  InsertExtensions({extension}, {extensionsAddedCount++});
+  return true;
+}
+
+void Platform::InsertExtensions(
+    const std::vector<std::shared_ptr<gd::PlatformExtension>>& extensions,
+    const std::vector<std::size_t>& ranks) const {
+  // Add the metadata of the extensions to a copy of the index (if it's built),
+  // as the index can be used by other threads.
+  std::shared_ptr<const gd::PlatformMetadataIndex> index =
+      std::atomic_load(&metadataIndex);
+  std::shared_ptr<gd::PlatformMetadataIndex> newIndex;
+  if (index) newIndex = std::make_shared<gd::PlatformMetadataIndex>(*index);
+
+  for (std::size_t i = 0; i < extensions.size(); ++i) {
+    const std::shared_ptr<gd::PlatformExtension>& extension = extensions[i];
+    if (!extension) continue;
+
+    // Keep the extensions in the order they were added, whatever the order in
+    // which the lazy ones are created.
+    std::size_t position =
+        std::upper_bound(
+            extensionsLoadedRanks.begin(), extensionsLoadedRanks.end(), ranks[i]) -
+        extensionsLoadedRanks.begin();
+    extensionsLoaded.insert(extensionsLoaded.begin() + position, extension);
+    extensionsLoadedRanks.insert(extensionsLoadedRanks.begin() + position,
+                                 ranks[i]);
+
+    // Like when extensions are added one after the other, the creation
+    // functions and the groups of the last extension declaring them are used.
+    auto isDeclaredByNextExtensions =
+        [&](const std::function<bool(const gd::PlatformExtension&)>&
+                isDeclared) {
+          for (std::size_t j = position + 1; j < extensionsLoaded.size(); ++j) {
+            if (isDeclared(*extensionsLoaded[j])) return true;
+          }
+          return false;
+        };
+
+    // Load all creation/destruction functions for objects provided by the
+    // extension
+    vector<gd::String> objectsTypes = extension->GetExtensionObjectsTypes();
+    for (std::size_t j = 0; j < objectsTypes.size(); ++j) {
+      const gd::String& objectType = objectsTypes[j];
+      if (isDeclaredByNextExtensions(
+              [&objectType](const gd::PlatformExtension& nextExtension) {
+                vector<gd::String> nextObjectsTypes =
+                    nextExtension.GetExtensionObjectsTypes();
+                return std::find(nextObjectsTypes.begin(),
+                                 nextObjectsTypes.end(),
+                                 objectType) != nextObjectsTypes.end();
+              }))
+        continue;
+
+      creationFunctionTable[objectType] =
+          extension->GetObjectCreationFunctionPtr(objectType);
+    }
+
+    for (const auto& it :
+         extension->GetAllInstructionOrExpressionGroupMetadata()) {
+      if (isDeclaredByNextExtensions(
+              [&it](const gd::PlatformExtension& nextExtension) {
+                return nextExtension.GetAllInstructionOrExpressionGroupMetadata()
+                           .count(it.first) != 0;
+              }))
+        continue;
 
-  // Load all creation/destruction functions for objects provided by the
-  // extension
-  vector<gd::String> objectsTypes = extension->GetExtensionObjectsTypes();
-  for (std::size_t i = 0; i < objectsTypes.size(); ++i) {
-    creationFunctionTable[objectsTypes[i]] =
-        extension->GetObjectCreationFunctionPtr(objectsTypes[i]);
+      instructionOrExpressionGroupMetadata[it.first] = it.second;
+    }
+
+    if (newIndex) newIndex->AddExtension(*extension, ranks[i]);
   }
 
-  for (const auto& it :
-       extension->GetAllInstructionOrExpressionGroupMetadata()) {
-    instructionOrExpressionGroupMetadata[it.first] = it.second;
+  std::atomic_store(&metadataIndex,
+                    std::shared_ptr<const gd::PlatformMetadataIndex>(newIndex));
+}
+
+void Platform::AddLazyExtension(
+    const gd::String& name,
+    std::function<std::shared_ptr<PlatformExtension>()> createExtension) {
+  if (IsExtensionLoaded(name)) RemoveExtension(name);
+
+  LazyExtension lazyExtension;
+  lazyExtension.name = name;
+  lazyExtension.createExtension = createExtension;
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  AddLazyExtensionLocked(lazyExtension, nullptr);
+}
+
+void Platform::AddLazyExtension(
+    const gd::String& name,
+    const std::vector<gd::String>& declaredTypes,
+    std::function<std::shared_ptr<PlatformExtension>()> createExtension) {
+  if (IsExtensionLoaded(name)) RemoveExtension(name);
+
+  LazyExtension lazyExtension;
+  lazyExtension.name = name;
+  lazyExtension.createExtension = createExtension;
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  AddLazyExtensionLocked(lazyExtension, &declaredTypes);
+}
+
+void Platform::AddLazyExtension(
+    const gd::String& name,
+    std::function<std::shared_ptr<PlatformExtension>()> createExtension,
+    std::function<std::shared_ptr<PlatformExtension>(const SerializerElement&)>
+        createExtensionFromSnapshot) {
+  if (IsExtensionLoaded(name)) RemoveExtension(name);
+
+  LazyExtension lazyExtension;
+  lazyExtension.name = name;
+  lazyExtension.createExtension = createExtension;
+  lazyExtension.createExtensionFromSnapshot = createExtensionFromSnapshot;
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  AddLazyExtensionLocked(lazyExtension, nullptr);
+}
+
+void Platform::AddLazyExtensionLocked(
+    LazyExtension& lazyExtension,
+    const std::vector<gd::String>* declaredTypes) {
+  lazyExtension.rank = extensionsAddedCount++;
+  lazyExtension.nameSpace =
+      PlatformExtension::HasNameSpace(lazyExtension.name)
+          ? lazyExtension.name + PlatformExtension::GetNamespaceSeparator()
+          : "";
+
+  std::vector<gd::String> snapshotTypes;
+  auto snapshotIt = extensionsMetadataSnapshots.find(lazyExtension.name);
+  if (!declaredTypes && snapshotIt != extensionsMetadataSnapshots.end()) {
+    snapshotTypes =
+        PlatformExtension::GetTypesDeclaredInMetadata(*snapshotIt->second);
+    declaredTypes = &snapshotTypes;
   }
+  lazyExtension.hasDeclaredTypes = declaredTypes != nullptr;
+  if (declaredTypes)
+    lazyExtension.declaredTypes.insert(declaredTypes->begin(),
+                                       declaredTypes->end());
 
-  return true;
+  lazyExtensions.push_back(lazyExtension);
+  lazyExtensionsCount.fetch_add(1, std::memory_order_release);
 }
 
-void Platform::RemoveExtension(const gd::String& name) {
-  // Unload all creation/destruction functions for objects provided by the
-  // extension
-  for (std::size_t i = 0; i < extensionsLoaded.size(); ++i) {
-    auto& extension = extensionsLoaded[i];
-    if (extension->GetName() == name) {
-      vector<gd::String> objectsTypes = extension->GetExtensionObjectsTypes();
-      for (std::size_t i = 0; i < objectsTypes.size(); ++i) {
-        creationFunctionTable.erase(objectsTypes[i]);
+bool Platform::CanDeclareType(const LazyExtension& lazyExtension,
+                              const gd::String& type) {
+  if (lazyExtension.hasDeclaredTypes)
+    return lazyExtension.declaredTypes.count(type) != 0;
+
+  // Extensions without namespace can declare any type.
+  const std::string& nameSpace = lazyExtension.nameSpace.Raw();
+  return type.Raw().compare(0, nameSpace.size(), nameSpace) == 0;
+}
+
+bool Platform::DeclareLazyExtensionsIf(
+    const std::function<bool(const LazyExtension&)>& shouldDeclare) const {
+  if (lazyExtensionsCount.load(std::memory_order_acquire) == 0) return false;
+
+  // Extensions are created by one thread at a time, so that other threads
+  // wait for the extensions being created before searching them. They are
+  // created without holding extensionsMutex, as they can search (and create)
+  // the other extensions.
+  std::lock_guard<std::recursive_mutex> creationLock(extensionsCreationMutex);
+  std::vector<LazyExtension> extensionsToCreate;
+  {
+    std::lock_guard<std::mutex> lock(extensionsMutex);
+    for (std::size_t i = 0; i < lazyExtensions.size();) {
+      if (!shouldDeclare(lazyExtensions[i])) {
+        ++i;
+        continue;
       }
+
+      extensionsToCreate.push_back(lazyExtensions[i]);
+      auto snapshotIt =
+          extensionsMetadataSnapshots.find(lazyExtensions[i].name);
+      if (snapshotIt != extensionsMetadataSnapshots.end())
+        extensionsToCreate.back().metadataSnapshot = snapshotIt->second;
+      lazyExtensions.erase(lazyExtensions.begin() + i);
     }
   }
+  if (extensionsToCreate.empty()) return false;
+
+  std::vector<std::shared_ptr<gd::PlatformExtension>> createdExtensions;
+  std::vector<std::size_t> ranks;
+  for (const auto& lazyExtension : extensionsToCreate) {
+    createdExtensions.push_back(
+        lazyExtension.metadataSnapshot &&
+                lazyExtension.createExtensionFromSnapshot
+            ? lazyExtension.createExtensionFromSnapshot(
+                  *lazyExtension.metadataSnapshot)
+            : lazyExtension.createExtension());
+    ranks.push_back(lazyExtension.rank);
+  }
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  InsertExtensions(createdExtensions, ranks);
+  lazyExtensionsCount.fetch_sub(extensionsToCreate.size(),
+                                std::memory_order_release);
+  return true;
+}
+
+bool Platform::DeclareLazyExtensionsForType(const gd::String& type) const {
+  return DeclareLazyExtensionsIf(
+      [&type](const LazyExtension& lazyExtension) {
+        return CanDeclareType(lazyExtension, type);
+      });
+}
+
+void Platform::DeclareLazyExtensions() const {
+  DeclareLazyExtensionsIf(
+      [](const LazyExtension& lazyExtension) { return true; });
+}
 
-  extensionsLoaded.erase(
-      remove_if(extensionsLoaded.begin(),
-                extensionsLoaded.end(),
-                [&name](std::shared_ptr<PlatformExtension> extension) {
-                  return extension->GetName() == name;
+void Platform::RemoveExtension(const gd::String& name) {
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  std::size_t lazyExtensionsSize = lazyExtensions.size();
+  lazyExtensions.erase(
+      remove_if(lazyExtensions.begin(),
+                lazyExtensions.end(),
+                [&name](const LazyExtension& lazyExtension) {
+                  return lazyExtension.name == name;
                 }),
-      extensionsLoaded.end());
+      lazyExtensions.end());
+  lazyExtensionsCount.fetch_sub(lazyExtensionsSize - lazyExtensions.size(),
+                                std::memory_order_release);
+
+  for (std::size_t i = 0; i < extensionsLoaded.size();) {
+    auto& extension = extensionsLoaded[i];
+    if (extension->GetName() != name) {
+      ++i;
+      continue;
+    }
+
+    // Unload all creation/destruction functions for objects provided by the
+    // extension
+    vector<gd::String> objectsTypes = extension->GetExtensionObjectsTypes();
+    for (std::size_t j = 0; j < objectsTypes.size(); ++j) {
+      creationFunctionTable.erase(objectsTypes[j]);
+    }
+
+    extensionsLoaded.erase(extensionsLoaded.begin() + i);
+    extensionsLoadedRanks.erase(extensionsLoadedRanks.begin() + i);
+  }
+  std::atomic_store(&metadataIndex,
+                    std::shared_ptr<const gd::PlatformMetadataIndex>());
 }
 
 bool Platform::IsExtensionLoaded(const gd::String& name) const {
+  std::lock_guard<std::mutex> lock(extensionsMutex);
   for (std::size_t i = 0; i < extensionsLoaded.size(); ++i) {
     if (extensionsLoaded[i]->GetName() == name) return true;
   }
+  for (std::size_t i = 0; i < lazyExtensions.size(); ++i) {
+    if (lazyExtensions[i].name == name) return true;
+  }
 
   return false;
 }
 
 std::shared_ptr<gd::PlatformExtension> Platform::GetExtension(
     const gd::String& name) const {
+  DeclareLazyExtensionsIf([&name](const LazyExtension& lazyExtension) {
+    return lazyExtension.name == name;
+  });
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
   for (std::size_t i = 0; i < extensionsLoaded.size(); ++i) {
     if (extensionsLoaded[i]->GetName() == name) return extensionsLoaded[i];
   }
@@ -93,8 +324,91 @@ std::shared_ptr<gd::PlatformExtension> Platform::GetExtension(
   return std::shared_ptr<gd::PlatformExtension>();
 }
 
+std::vector<std::shared_ptr<gd::PlatformExtension>>
+Platform::GetAllPlatformExtensions() const {
+  DeclareLazyExtensions();
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  return extensionsLoaded;
+}
+
+std::shared_ptr<const gd::PlatformMetadataIndex> Platform::GetMetadataIndex()
+    const {
+  std::shared_ptr<const gd::PlatformMetadataIndex> index =
+      std::atomic_load(&metadataIndex);
+  if (index) return index;
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  index = std::atomic_load(&metadataIndex);
+  if (!index) {
+    index = std::make_shared<gd::PlatformMetadataIndex>(extensionsLoaded,
+                                                        extensionsLoadedRanks);
+    std::atomic_store(&metadataIndex, index);
+  }
+
+  return index;
+}
+
+void Platform::InvalidateMetadataIndex() {
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  std::atomic_store(&metadataIndex,
+                    std::shared_ptr<const gd::PlatformMetadataIndex>());
+}
+
+void Platform::SerializeMetadataTo(SerializerElement& element) const {
+  element.SetAttribute("version", gd::VersionWrapper::FullString());
+  SerializerElement& extensionsElement = element.AddChild("extensions");
+  extensionsElement.ConsiderAsArrayOf("extension");
+  for (const auto& extension : GetAllPlatformExtensions()) {
+    extension->SerializeMetadataTo(extensionsElement.AddChild("extension"));
+  }
+}
+
+bool Platform::UnserializeMetadataFrom(const SerializerElement& element) {
+  if (element.GetStringAttribute("version") != gd::VersionWrapper::FullString())
+    return false;
+
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  const SerializerElement& extensionsElement = element.GetChild("extensions");
+  extensionsElement.ConsiderAsArrayOf("extension");
+  for (std::size_t i = 0; i < extensionsElement.GetChildrenCount(); ++i) {
+    auto extensionElement =
+        std::make_shared<const SerializerElement>(extensionsElement.GetChild(i));
+    gd::String name = extensionElement->GetStringAttribute("name");
+    extensionsMetadataSnapshots[name] = extensionElement;
+
+    for (auto& lazyExtension : lazyExtensions) {
+      if (lazyExtension.name == name && !lazyExtension.hasDeclaredTypes) {
+        std::vector<gd::String> declaredTypes =
+            PlatformExtension::GetTypesDeclaredInMetadata(*extensionElement);
+        lazyExtension.declaredTypes.insert(declaredTypes.begin(),
+                                           declaredTypes.end());
+        lazyExtension.hasDeclaredTypes = true;
+      }
+    }
+  }
+
+  return true;
+}
+
+void Platform::RemoveMetadataSnapshots() {
+  std::lock_guard<std::mutex> lock(extensionsMutex);
+  extensionsMetadataSnapshots.clear();
+}
+
 std::unique_ptr<gd::ObjectConfiguration> Platform::CreateObjectConfiguration(
     gd::String type) const {
+  std::unique_lock<std::mutex> lock(extensionsMutex, std::defer_lock);
+  if (lazyExtensionsCount.load(std::memory_order_acquire) > 0) {
+    // Extensions can be created by other threads while the object is created.
+    lock.lock();
+    if (creationFunctionTable.find(type) == creationFunctionTable.end()) {
+      lock.unlock();
+      DeclareLazyExtensionsForType(type);
+      lock.lock();
+    }
+  }
+
   if (creationFunctionTable.find(type) == creationFunctionTable.end()) {
     gd::LogWarning("Tried to create an object with an unknown type: " + type
               + " for platform " + GetName() + "!");
@@ -114,6 +428,13 @@ std::unique_ptr<gd::ObjectConfiguration> Platform::CreateObjectConfiguration(
 #if defined(GD_IDE_ONLY)
 std::shared_ptr<gd::BaseEvent> Platform::CreateEvent(
     const gd::String& eventType) const {
+  std::unique_lock<std::mutex> lock(extensionsMutex, std::defer_lock);
+  if (lazyExtensionsCount.load(std::memory_order_acquire) > 0) {
+    DeclareLazyExtensionsForType(eventType);
+    // Extensions can be created by other threads while the event is created.
+    lock.lock();
+  }
+
   for (std::size_t i = 0; i < extensionsLoaded.size(); ++i) {
     std::shared_ptr<gd::BaseEvent> event =
         extensionsLoaded[i]->CreateEvent(eventType);
@@ -122,6 +443,24 @@ std::shared_ptr<gd::BaseEvent> Platform::CreateEvent(
 
   return std::shared_ptr<gd::BaseEvent>();
 }
+
+gd::EventMetadata* Platform::GetEventMetadata(
+    const gd::String& eventType) const {
+  std::unique_lock<std::mutex> lock(extensionsMutex, std::defer_lock);
+  if (lazyExtensionsCount.load(std::memory_order_acquire) > 0) {
+    DeclareLazyExtensionsForType(eventType);
+    lock.lock();
+  }
+
+  for (std::size_t i = 0; i < extensionsLoaded.size(); ++i) {
+    std::map<gd::String, gd::EventMetadata>& allEvents =
+        extensionsLoaded[i]->GetAllEvents();
+    auto it = allEvents.find(eventType);
+    if (it != allEvents.end()) return &it->second;
+  }
+
+  return nullptr;
+}
 #endif
 
 }  // namespace gd
@@ -6,8 +6,12 @@
 
 #ifndef GDCORE_PLATFORM_H
 #define GDCORE_PLATFORM_H
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 
 #include "GDCore/Extensions/Metadata/InstructionOrExpressionGroupMetadata.h"
@@ -21,8 +25,11 @@ class Behavior;
 class BehaviorMetadata;
 class ObjectMetadata;
 class BaseEvent;
+class EventMetadata;
 class BehaviorsSharedData;
 class PlatformExtension;
+class PlatformMetadataIndex;
+class SerializerElement;
 class LayoutEditorCanvas;
 class ProjectExporter;
 }  // namespace gd
@@ -96,6 +103,81 @@ class GD_CORE_API Platform {
    */
   virtual bool AddExtension(std::shared_ptr<PlatformExtension> extension);
 
+  /**
+   * \brief Add an extension to the platform, which is only created (i.e: its
+   * metadata are only declared) when it's first needed.
+   *
+   * The extension is created when one of the types it can declare is searched
+   * (see DeclareLazyExtensionsForType), when it's requested by its name, or
+   * when all the extensions are listed.
+   *
+   * \param name The name of the extension. It must be the name declared by
+   * the extension, as it's used to know the namespace of its types.
+   * \param createExtension The function creating the extension.
+   *
+   * \note The extension is added without calling AddExtension.
+   * \note If a metadata snapshot of the extension was given to
+   * UnserializeMetadataFrom, the types it declares are read from it.
+   */
+  void AddLazyExtension(
+      const gd::String& name,
+      std::function<std::shared_ptr<PlatformExtension>()> createExtension);
+
+  /**
+   * \brief Add an extension to the platform, which is only created when one of
+   * the given types is searched, when it's requested by its name, or when all
+   * the extensions are listed.
+   *
+   * \param name The name of the extension.
+   * \param declaredTypes The types of the instructions, expressions, objects,
+   * behaviors, effects and events declared by the extension.
+   * \param createExtension The function creating the extension.
+   */
+  void AddLazyExtension(
+      const gd::String& name,
+      const std::vector<gd::String>& declaredTypes,
+      std::function<std::shared_ptr<PlatformExtension>()> createExtension);
+
+  /**
+   * \brief Add an extension to the platform, which is only created when it's
+   * first needed (see the other overloads), and which is built from its
+   * metadata snapshot if one was given to UnserializeMetadataFrom.
+   *
+   * \param name The name of the extension.
+   * \param createExtension The function creating the extension, declaring its
+   * metadata in code. Only called if there is no snapshot of the extension.
+   * \param createExtensionFromSnapshot The function creating the extension
+   * from the snapshot of its metadata, without declaring them in code: it must
+   * call gd::PlatformExtension::UnserializeMetadataFrom and then only declare
+   * what can't be serialized (objects, behaviors and events, custom code
+   * generators, pure functions, dependencies...).
+   */
+  void AddLazyExtension(
+      const gd::String& name,
+      std::function<std::shared_ptr<PlatformExtension>()> createExtension,
+      std::function<std::shared_ptr<PlatformExtension>(
+          const SerializerElement& metadataSnapshot)>
+          createExtensionFromSnapshot);
+
+  /**
+   * \brief Create the extensions added with AddLazyExtension that can declare
+   * the given instruction/expression/object/behavior/effect/event type.
+   *
+   * If the types declared by an extension are known (see AddLazyExtension and
+   * UnserializeMetadataFrom), it's only created if it declares \a type.
+   * Otherwise, it's created if it prefixes its types by the namespace of
+   * \a type, or if it's a builtin extension without namespace.
+   *
+   * \return true if at least one extension was created.
+   */
+  bool DeclareLazyExtensionsForType(const gd::String& type) const;
+
+  /**
+   * \brief Create all the extensions added with AddLazyExtension that are
+   * not created yet.
+   */
+  void DeclareLazyExtensions() const;
+
   /**
    * \brief Return true if an extension with the specified name is loaded
    */
@@ -108,13 +190,16 @@ class GD_CORE_API Platform {
   std::shared_ptr<PlatformExtension> GetExtension(const gd::String& name) const;
 
   /**
-   * \brief Get all extensions loaded for the platform.
-   * @return Vector of Shared pointer containing all extensions
+   * \brief Get all extensions loaded for the platform, in the order they were
+   * added.
+   * \note All the extensions added with AddLazyExtension are created. To search
+   * the metadata of a type, prefer gd::MetadataProvider or GetEventMetadata,
+   * which only create the extensions declaring it.
+   * @return A copy of the vector of the extensions, so that it can be iterated
+   * while extensions are created by other threads.
    */
-  const std::vector<std::shared_ptr<gd::PlatformExtension>>&
-  GetAllPlatformExtensions() const {
-    return extensionsLoaded;
-  };
+  std::vector<std::shared_ptr<gd::PlatformExtension>>
+  GetAllPlatformExtensions() const;
 
   /**
    * \brief Remove an extension from the platform.
@@ -130,12 +215,81 @@ class GD_CORE_API Platform {
    */
   const InstructionOrExpressionGroupMetadata& GetInstructionOrExpressionGroupMetadata(
       const gd::String& name) const {
+    DeclareLazyExtensions();
     auto it = instructionOrExpressionGroupMetadata.find(name);
     if (it == instructionOrExpressionGroupMetadata.end())
       return badInstructionOrExpressionGroupMetadata;
 
     return it->second;
   }
+
+  /**
+   * \brief Return the index of the metadata declared by the extensions, used
+   * by gd::MetadataProvider to find metadata without searching in every
+   * extension.
+   *
+   * The index is built when first requested. The extensions created or added
+   * afterwards are added to a copy of the index, and it's built again after
+   * extensions are removed. The returned index stays valid even if another
+   * thread creates an extension in the meantime.
+   */
+  std::shared_ptr<const gd::PlatformMetadataIndex> GetMetadataIndex() const;
+
+  /**
+   * \brief Discard the index of the metadata, so that it's built again when
+   * next requested.
+   *
+   * \note Must be called if metadata are declared in an extension after it was
+   * added to the platform.
+   */
+  void InvalidateMetadataIndex();
+  ///@}
+
+  /** \name Metadata snapshot
+   * Member functions used to save the metadata declared by the extensions,
+   * so that they can be restored instead of being declared in code.
+   */
+  ///@{
+  /**
+   * \brief Serialize the information and the metadata of the actions,
+   * conditions, expressions and effects of all the extensions of the platform.
+   *
+   * The element can be saved in a compact form with gd::Serializer::ToBinary,
+   * and restored with UnserializeMetadataFrom. It's tagged with the version of
+   * GDevelop, as metadata change with it.
+   *
+   * \note Extensions added with AddLazyExtension are created.
+   * \see gd::PlatformExtension::SerializeMetadataTo
+   */
+  void SerializeMetadataTo(SerializerElement& element) const;
+
+  /**
+   * \brief Use the metadata serialized with SerializeMetadataTo for the
+   * extensions of the platform.
+   *
+   * Extensions added with AddLazyExtension and a function creating them from
+   * their snapshot are built from it, without declaring their metadata in
+   * code. The types declared by the other lazy extensions are read from it,
+   * so that only the extensions declaring a searched type are created.
+   *
+   * The metadata of an extension added later with AddExtension are declared
+   * in the extension as soon as it's added. Extensions already created are
+   * left untouched, as their metadata are already declared.
+   *
+   * \return false if the snapshot was saved by another version of GDevelop,
+   * in which case it's not used.
+   * \see gd::PlatformExtension::UnserializeMetadataFrom
+   */
+  bool UnserializeMetadataFrom(const SerializerElement& element);
+
+  /**
+   * \brief Stop using the snapshots given to UnserializeMetadataFrom to build
+   * the extensions, for example because the strings they contain are not
+   * translated in the new language of the editor.
+   *
+   * The types declared by the lazy extensions already added are still used.
+   */
+  void RemoveMetadataSnapshots();
   ///@}
 
   /** \name Factory method
@@ -155,6 +309,12 @@ class GD_CORE_API Platform {
    */
   std::shared_ptr<gd::BaseEvent> CreateEvent(const gd::String& type) const;
 
+  /**
+   * \brief Get the metadata of the event of given type.
+   * \return nullptr if no extension declares the event.
+   */
+  gd::EventMetadata* GetEventMetadata(const gd::String& type) const;
+
   ///@}
 
   /**
@@ -166,14 +326,63 @@ class GD_CORE_API Platform {
   };
 
  private:
-  std::vector<std::shared_ptr<PlatformExtension>>
-      extensionsLoaded;  ///< Extensions of the platform
-  std::map<gd::String, CreateFunPtr>
+  struct LazyExtension;
+  void InsertExtensions(
+      const std::vector<std::shared_ptr<PlatformExtension>>& extensions,
+      const std::vector<std::size_t>& ranks) const;
+  void AddLazyExtensionLocked(LazyExtension& lazyExtension,
+                              const std::vector<gd::String>* declaredTypes);
+  bool DeclareLazyExtensionsIf(
+      const std::function<bool(const LazyExtension&)>& shouldDeclare) const;
+  static bool CanDeclareType(const LazyExtension& lazyExtension,
+                             const gd::String& type);
+
+  // Extensions can be created lazily when metadata are searched, so the
+  // following members are mutable.
+  mutable std::vector<std::shared_ptr<PlatformExtension>>
+      extensionsLoaded;  ///< Extensions of the platform, in the order they
+                         ///< were added (even if created lazily).
+  mutable std::vector<std::size_t>
+      extensionsLoadedRanks;  ///< The rank of each extension of
+                              ///< extensionsLoaded.
+  std::size_t extensionsAddedCount;  ///< Used to rank the extensions in the
+                                     ///< order they are added.
+  mutable std::map<gd::String, CreateFunPtr>
       creationFunctionTable;  ///< Creation functions for objects
-  std::map<gd::String, InstructionOrExpressionGroupMetadata>
+  mutable std::map<gd::String, InstructionOrExpressionGroupMetadata>
       instructionOrExpressionGroupMetadata;
   static InstructionOrExpressionGroupMetadata badInstructionOrExpressionGroupMetadata;
   bool enableExtensionLoadingLogs;
+
+  struct LazyExtension {
+    gd::String name;
+    std::size_t rank;  ///< The order in which the extension was added.
+    gd::String nameSpace;  ///< The prefix of the types of the extension.
+    bool hasDeclaredTypes;  ///< true if declaredTypes are known.
+    std::set<gd::String> declaredTypes;
+    std::function<std::shared_ptr<PlatformExtension>()> createExtension;
+    std::function<std::shared_ptr<PlatformExtension>(const SerializerElement&)>
+        createExtensionFromSnapshot;  ///< Can be empty.
+    std::shared_ptr<const SerializerElement>
+        metadataSnapshot;  ///< Set when the extension is about to be created.
+  };
+  mutable std::vector<LazyExtension>
+      lazyExtensions;  ///< Extensions not created yet, see AddLazyExtension.
+  mutable std::atomic<std::size_t>
+      lazyExtensionsCount;  ///< The number of extensions not created yet, or
+                            ///< being created.
+  mutable std::shared_ptr<const gd::PlatformMetadataIndex>
+      metadataIndex;  ///< Built lazily, see GetMetadataIndex.
+  std::map<gd::String, std::shared_ptr<const SerializerElement>>
+      extensionsMetadataSnapshots;  ///< See UnserializeMetadataFrom.
+  mutable std::mutex extensionsMutex;  ///< Metadata can be searched (and
+                                       ///< extensions created) by multiple
+                                       ///< threads.
+  mutable std::recursive_mutex
+      extensionsCreationMutex;  ///< Held while lazy extensions are created,
+                                ///< without holding extensionsMutex, as
+                                ///< creating an extension can search the
+                                ///< other ones.
 };
 
 }  // namespace gd
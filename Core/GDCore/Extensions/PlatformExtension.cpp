@@ -20,6 +20,7 @@
 #include "GDCore/Project/Behavior.h"
 #include "GDCore/Project/ObjectConfiguration.h"
 #include "GDCore/Project/BehaviorsSharedData.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/Tools/Localization.h"
 
 namespace gd {
@@ -534,6 +535,240 @@ PlatformExtension::GetAllStrExpressionsForBehavior(gd::String autoType) {
   return badExpressionsMetadata;
 }
 
+namespace {
+template <class T>
+void SerializeAllMetadataTo(const std::map<gd::String, T>& allMetadata,
+                            gd::SerializerElement& element,
+                            const gd::String& childName) {
+  element.ConsiderAsArrayOf(childName);
+  for (const auto& it : allMetadata) {
+    gd::SerializerElement& metadataElement = element.AddChild(childName);
+    metadataElement.SetAttribute("type", it.first);
+    it.second.SerializeTo(metadataElement);
+  }
+}
+
+template <class T>
+void UnserializeAllMetadataFrom(const gd::SerializerElement& element,
+                                const gd::String& childName,
+                                std::map<gd::String, T>& allMetadata) {
+  element.ConsiderAsArrayOf(childName);
+  for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
+    const gd::SerializerElement& metadataElement = element.GetChild(i);
+    allMetadata[metadataElement.GetStringAttribute("type")].UnserializeFrom(
+        metadataElement);
+  }
+}
+
+/**
+ * \brief Serialize the instructions and expressions of an extension, an
+ * object or a behavior.
+ */
+void SerializeInstructionsAndExpressionsTo(
+    const std::map<gd::String, gd::InstructionMetadata>& actions,
+    const std::map<gd::String, gd::InstructionMetadata>& conditions,
+    const std::map<gd::String, gd::ExpressionMetadata>& expressions,
+    const std::map<gd::String, gd::ExpressionMetadata>& strExpressions,
+    gd::SerializerElement& element) {
+  SerializeAllMetadataTo(actions, element.AddChild("actions"), "action");
+  SerializeAllMetadataTo(
+      conditions, element.AddChild("conditions"), "condition");
+  SerializeAllMetadataTo(
+      expressions, element.AddChild("expressions"), "expression");
+  SerializeAllMetadataTo(
+      strExpressions, element.AddChild("strExpressions"), "expression");
+}
+
+void UnserializeInstructionsAndExpressionsFrom(
+    const gd::SerializerElement& element,
+    std::map<gd::String, gd::InstructionMetadata>& actions,
+    std::map<gd::String, gd::InstructionMetadata>& conditions,
+    std::map<gd::String, gd::ExpressionMetadata>& expressions,
+    std::map<gd::String, gd::ExpressionMetadata>& strExpressions) {
+  UnserializeAllMetadataFrom(element.GetChild("actions"), "action", actions);
+  UnserializeAllMetadataFrom(
+      element.GetChild("conditions"), "condition", conditions);
+  UnserializeAllMetadataFrom(
+      element.GetChild("expressions"), "expression", expressions);
+  UnserializeAllMetadataFrom(
+      element.GetChild("strExpressions"), "expression", strExpressions);
+}
+}  // namespace
+
+void PlatformExtension::SerializeMetadataTo(SerializerElement& element) const {
+  element.SetAttribute("name", name);
+  element.SetAttribute("fullName", fullname);
+  element.SetAttribute("description", informations);
+  element.SetAttribute("category", category);
+  element.SetAttribute("author", author);
+  element.SetAttribute("license", license);
+  element.SetAttribute("deprecated", deprecated);
+  element.SetAttribute("helpPath", helpPath);
+  element.SetAttribute("iconUrl", iconUrl);
+  SerializerElement& tagsElement = element.AddChild("tags");
+  tagsElement.ConsiderAsArrayOf("tag");
+  for (const auto& tag : tags) {
+    tagsElement.AddChild("tag").SetStringValue(tag);
+  }
+  SerializerElement& groupsElement = element.AddChild("groups");
+  groupsElement.ConsiderAsArrayOf("group");
+  for (const auto& it : instructionOrExpressionGroupMetadata) {
+    SerializerElement& groupElement = groupsElement.AddChild("group");
+    groupElement.SetAttribute("name", it.first);
+    groupElement.SetAttribute("icon", it.second.GetIcon());
+  }
+
+  SerializeInstructionsAndExpressionsTo(actionsInfos,
+                                        conditionsInfos,
+                                        expressionsInfos,
+                                        strExpressionsInfos,
+                                        element);
+  SerializeAllMetadataTo(effectsMetadata, element.AddChild("effects"), "effect");
+
+  SerializerElement& objectsElement = element.AddChild("objects");
+  objectsElement.ConsiderAsArrayOf("object");
+  for (const auto& it : objectsInfos) {
+    SerializerElement& objectElement = objectsElement.AddChild("object");
+    objectElement.SetAttribute("type", it.first);
+    const ObjectMetadata& objectMetadata = it.second;
+    SerializeInstructionsAndExpressionsTo(objectMetadata.actionsInfos,
+                                          objectMetadata.conditionsInfos,
+                                          objectMetadata.expressionsInfos,
+                                          objectMetadata.strExpressionsInfos,
+                                          objectElement);
+  }
+
+  SerializerElement& behaviorsElement = element.AddChild("behaviors");
+  behaviorsElement.ConsiderAsArrayOf("behavior");
+  for (const auto& it : behaviorsInfo) {
+    SerializerElement& behaviorElement = behaviorsElement.AddChild("behavior");
+    behaviorElement.SetAttribute("type", it.first);
+    const BehaviorMetadata& behaviorMetadata = it.second;
+    SerializeInstructionsAndExpressionsTo(behaviorMetadata.actionsInfos,
+                                          behaviorMetadata.conditionsInfos,
+                                          behaviorMetadata.expressionsInfos,
+                                          behaviorMetadata.strExpressionsInfos,
+                                          behaviorElement);
+  }
+
+  SerializerElement& eventsElement = element.AddChild("events");
+  eventsElement.ConsiderAsArrayOf("event");
+  for (const auto& it : eventsInfos) {
+    eventsElement.AddChild("event").SetAttribute("type", it.first);
+  }
+}
+
+void PlatformExtension::UnserializeMetadataFrom(
+    const SerializerElement& element) {
+  SetExtensionInformation(element.GetStringAttribute("name"),
+                          element.GetStringAttribute("fullName"),
+                          element.GetStringAttribute("description"),
+                          element.GetStringAttribute("author"),
+                          element.GetStringAttribute("license"));
+  category = element.GetStringAttribute("category");
+  deprecated = element.GetBoolAttribute("deprecated");
+  helpPath = element.GetStringAttribute("helpPath");
+  iconUrl = element.GetStringAttribute("iconUrl");
+  tags.clear();
+  const SerializerElement& tagsElement = element.GetChild("tags");
+  tagsElement.ConsiderAsArrayOf("tag");
+  for (std::size_t i = 0; i < tagsElement.GetChildrenCount(); ++i) {
+    tags.push_back(tagsElement.GetChild(i).GetStringValue());
+  }
+  const SerializerElement& groupsElement = element.GetChild("groups");
+  groupsElement.ConsiderAsArrayOf("group");
+  for (std::size_t i = 0; i < groupsElement.GetChildrenCount(); ++i) {
+    const SerializerElement& groupElement = groupsElement.GetChild(i);
+    AddInstructionOrExpressionGroupMetadata(
+        groupElement.GetStringAttribute("name"))
+        .SetIcon(groupElement.GetStringAttribute("icon"));
+  }
+
+  UnserializeInstructionsAndExpressionsFrom(element,
+                                            actionsInfos,
+                                            conditionsInfos,
+                                            expressionsInfos,
+                                            strExpressionsInfos);
+  UnserializeAllMetadataFrom(
+      element.GetChild("effects"), "effect", effectsMetadata);
+
+  const SerializerElement& objectsElement = element.GetChild("objects");
+  objectsElement.ConsiderAsArrayOf("object");
+  for (std::size_t i = 0; i < objectsElement.GetChildrenCount(); ++i) {
+    const SerializerElement& objectElement = objectsElement.GetChild(i);
+    auto it = objectsInfos.find(objectElement.GetStringAttribute("type"));
+    if (it == objectsInfos.end()) continue;
+
+    ObjectMetadata& objectMetadata = it->second;
+    UnserializeInstructionsAndExpressionsFrom(objectElement,
+                                              objectMetadata.actionsInfos,
+                                              objectMetadata.conditionsInfos,
+                                              objectMetadata.expressionsInfos,
+                                              objectMetadata.strExpressionsInfos);
+  }
+
+  const SerializerElement& behaviorsElement = element.GetChild("behaviors");
+  behaviorsElement.ConsiderAsArrayOf("behavior");
+  for (std::size_t i = 0; i < behaviorsElement.GetChildrenCount(); ++i) {
+    const SerializerElement& behaviorElement = behaviorsElement.GetChild(i);
+    auto it = behaviorsInfo.find(behaviorElement.GetStringAttribute("type"));
+    if (it == behaviorsInfo.end()) continue;
+
+    BehaviorMetadata& behaviorMetadata = it->second;
+    UnserializeInstructionsAndExpressionsFrom(
+        behaviorElement,
+        behaviorMetadata.actionsInfos,
+        behaviorMetadata.conditionsInfos,
+        behaviorMetadata.expressionsInfos,
+        behaviorMetadata.strExpressionsInfos);
+  }
+}
+
+namespace {
+void AddTypesDeclaredIn(const gd::SerializerElement& element,
+                        const gd::String& childName,
+                        std::vector<gd::String>& types) {
+  element.ConsiderAsArrayOf(childName);
+  for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
+    types.push_back(element.GetChild(i).GetStringAttribute("type"));
+  }
+}
+
+void AddInstructionsTypesDeclaredIn(const gd::SerializerElement& element,
+                                    std::vector<gd::String>& types) {
+  AddTypesDeclaredIn(element.GetChild("actions"), "action", types);
+  AddTypesDeclaredIn(element.GetChild("conditions"), "condition", types);
+}
+}  // namespace
+
+std::vector<gd::String> PlatformExtension::GetTypesDeclaredInMetadata(
+    const SerializerElement& element) {
+  std::vector<gd::String> types;
+  AddInstructionsTypesDeclaredIn(element, types);
+  AddTypesDeclaredIn(element.GetChild("expressions"), "expression", types);
+  AddTypesDeclaredIn(element.GetChild("strExpressions"), "expression", types);
+  AddTypesDeclaredIn(element.GetChild("effects"), "effect", types);
+  AddTypesDeclaredIn(element.GetChild("events"), "event", types);
+
+  const SerializerElement& objectsElement = element.GetChild("objects");
+  objectsElement.ConsiderAsArrayOf("object");
+  for (std::size_t i = 0; i < objectsElement.GetChildrenCount(); ++i) {
+    const SerializerElement& objectElement = objectsElement.GetChild(i);
+    types.push_back(objectElement.GetStringAttribute("type"));
+    AddInstructionsTypesDeclaredIn(objectElement, types);
+  }
+
+  const SerializerElement& behaviorsElement = element.GetChild("behaviors");
+  behaviorsElement.ConsiderAsArrayOf("behavior");
+  for (std::size_t i = 0; i < behaviorsElement.GetChildrenCount(); ++i) {
+    const SerializerElement& behaviorElement = behaviorsElement.GetChild(i);
+    types.push_back(behaviorElement.GetStringAttribute("type"));
+    AddInstructionsTypesDeclaredIn(behaviorElement, types);
+  }
+
+  return types;
+}
+
 gd::BaseEventSPtr PlatformExtension::CreateEvent(
     const gd::String& eventType) const {
   if (eventsInfos.find(eventType) != eventsInfos.end()) {
@@ -577,6 +812,15 @@ gd::BehaviorsSharedData* PlatformExtension::GetBehaviorSharedDatas(
 }
 
 void PlatformExtension::SetNameSpace(gd::String nameSpace_) {
+  if (!HasNameSpace(name)) {
+    nameSpace = "";
+    return;
+  }
+
+  nameSpace = nameSpace_ + GetNamespaceSeparator();
+}
+
+bool PlatformExtension::HasNameSpace(const gd::String& name) {
   // Most of the builtin extensions do not have namespace
   if (name == "Sprite" || name == "BuiltinObject" || name == "BuiltinAudio" ||
       name == "BuiltinMouse" || name == "BuiltinKeyboard" ||
@@ -591,11 +835,10 @@ void PlatformExtension::SetNameSpace(gd::String nameSpace_) {
       name == "Effects" ||      // Well-known effects are not namespaced.
       name == "CommonDialogs")  // New name for BuiltinInterface
   {
-    nameSpace = "";
-    return;
+    return false;
   }
 
-  nameSpace = nameSpace_ + GetNamespaceSeparator();
+  return true;
 }
 
 std::vector<gd::String> PlatformExtension::GetBuiltinExtensionsNames() {
@@ -38,6 +38,7 @@ class BehaviorsSharedData;
 class Behavior;
 class Object;
 class ObjectConfiguration;
+class SerializerElement;
 }  // namespace gd
 
 typedef std::function<std::unique_ptr<gd::ObjectConfiguration>()>
@@ -620,6 +621,45 @@ class GD_CORE_API PlatformExtension {
   GetAllInstructionOrExpressionGroupMetadata() const {
     return instructionOrExpressionGroupMetadata;
   }
+
+  /**
+   * \brief Serialize the information of the extension (name, description,
+   * groups of instructions...) and the metadata of its actions, conditions,
+   * expressions and effects, including the ones of its objects and behaviors.
+   *
+   * Objects, behaviors and events themselves are not serialized, as they are
+   * created by functions given in code: only their types are. Dependencies
+   * and properties of the extension are not serialized either.
+   *
+   * \see gd::Platform::SerializeMetadataTo
+   */
+  void SerializeMetadataTo(SerializerElement &element) const;
+
+  /**
+   * \brief Set the information of the extension and declare the actions,
+   * conditions, expressions and effects serialized with SerializeMetadataTo,
+   * instead of declaring them in code.
+   *
+   * The instructions and expressions of an object or a behavior are only
+   * declared if the object or behavior is already declared by the extension.
+   * Custom code generators and pure functions set in code on instructions or
+   * expressions that are already declared are kept: as they can't be
+   * serialized, they must be set again after the metadata are declared.
+   */
+  void UnserializeMetadataFrom(const SerializerElement &element);
+
+  /**
+   * \brief Return the types of the instructions, expressions, objects,
+   * behaviors, effects and events declared in metadata serialized with
+   * SerializeMetadataTo.
+   *
+   * Instructions of objects and behaviors are included, but not their
+   * expressions, which are searched by the type of the object or behavior.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  static std::vector<gd::String> GetTypesDeclaredInMetadata(
+      const SerializerElement &element);
   ///@}
 
   /**
@@ -634,6 +674,13 @@ class GD_CORE_API PlatformExtension {
    */
   static gd::String GetNamespaceSeparator() { return "::"; }
 
+  /**
+   * \brief Return false if the extension with the given name is a builtin
+   * extension which instructions/expressions/objects/behaviors are not
+   * prefixed by the name of the extension.
+   */
+  static bool HasNameSpace(const gd::String &extensionName);
+
   static gd::String GetEventsFunctionFullType(const gd::String &extensionName,
                                               const gd::String &functionName);
 
@@ -5,6 +5,10 @@
  */
 
 #include "AbstractFileSystem.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "GDCore/CommonTools.h"
 #include "GDCore/String.h"
 
@@ -18,4 +22,83 @@ gd::String gd::AbstractFileSystem::NormalizeSeparator(gd::String filename) {
   return filename.FindAndReplace("\\", "/");
 }
 
+AbstractFileSystem::FileReader::~FileReader() {}
+
+AbstractFileSystem::FileWriter::~FileWriter() {}
+
+namespace {
+
+/**
+ * \brief Read a file whose whole content was read with ReadFile.
+ */
+class StringFileReader : public AbstractFileSystem::FileReader {
+ public:
+  StringFileReader(gd::String content_)
+      : content(std::move(content_)), offset(0){};
+  virtual ~StringFileReader(){};
+
+  virtual std::size_t Read(char* buffer, std::size_t bufferSize) override {
+    const std::string& raw = static_cast<const gd::String&>(content).Raw();
+    if (offset >= raw.size()) {
+      // The file was entirely consumed, release its content.
+      content = gd::String();
+      offset = 0;
+      return 0;
+    }
+
+    std::size_t readSize = std::min(bufferSize, raw.size() - offset);
+    memcpy(buffer, raw.data() + offset, readSize);
+    offset += readSize;
+    return readSize;
+  }
+
+ private:
+  gd::String content;
+  std::size_t offset;
+};
+
+/**
+ * \brief Write a file with WriteToFile once all its content is known.
+ */
+class StringFileWriter : public AbstractFileSystem::FileWriter {
+ public:
+  StringFileWriter(gd::AbstractFileSystem& fs_, const gd::String& file_)
+      : fs(fs_), file(file_), closed(false){};
+  virtual ~StringFileWriter(){};
+
+  virtual bool Write(const char* data, std::size_t size) override {
+    if (closed) return false;
+
+    content.Raw().append(data, size);
+    return true;
+  }
+
+  virtual bool Close() override {
+    if (closed) return false;
+
+    closed = true;
+    bool success = fs.WriteToFile(file, content);
+    content = gd::String();
+    return success;
+  }
+
+ private:
+  gd::AbstractFileSystem& fs;
+  gd::String file;
+  gd::String content;
+  bool closed;
+};
+
+}  // namespace
+
+std::unique_ptr<AbstractFileSystem::FileReader>
+AbstractFileSystem::OpenFileForReading(const gd::String& file) {
+  return std::unique_ptr<FileReader>(new StringFileReader(ReadFile(file)));
+}
+
+std::unique_ptr<AbstractFileSystem::FileWriter>
+AbstractFileSystem::OpenFileForWriting(const gd::String& file) {
+  return std::unique_ptr<FileWriter>(new StringFileWriter(*this, file));
+}
+
 }  // namespace gd
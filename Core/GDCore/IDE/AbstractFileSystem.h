@@ -6,6 +6,7 @@
 
 #ifndef GDCORE_ABSTRACTFILESYSTEM
 #define GDCORE_ABSTRACTFILESYSTEM
+#include <memory>
 #include <vector>
 #include "GDCore/String.h"
 
@@ -113,6 +114,69 @@ class GD_CORE_API AbstractFileSystem {
    */
   virtual gd::String ReadFile(const gd::String& file) = 0;
 
+  /**
+   * \brief A file opened for reading by parts, see OpenFileForReading.
+   */
+  class GD_CORE_API FileReader {
+   public:
+    virtual ~FileReader();
+
+    /**
+     * \brief Read the next bytes of the file into \a buffer.
+     * \return The number of bytes read, 0 if the end of the file is reached.
+     */
+    virtual std::size_t Read(char* buffer, std::size_t bufferSize) = 0;
+  };
+
+  /**
+   * \brief A file opened for writing by parts, see OpenFileForWriting.
+   */
+  class GD_CORE_API FileWriter {
+   public:
+    virtual ~FileWriter();
+
+    /**
+     * \brief Append \a size bytes to the file.
+     * \return true if the operation succeeded.
+     */
+    virtual bool Write(const char* data, std::size_t size) = 0;
+
+    /**
+     * \brief Finish writing the file. Nothing can be written after this.
+     * \return true if the whole file was written successfully.
+     */
+    virtual bool Close() = 0;
+  };
+
+  /**
+   * \brief Open a file to read its content by parts.
+   *
+   * This is used to stream large files (see gd::Serializer::FromJSONFile)
+   * without keeping a full copy of them in memory. Each reader has its own
+   * state, so several files can be read at the same time.
+   *
+   * \note The default implementation reads the whole file using ReadFile
+   * and keeps it in the reader until it has been entirely consumed. File
+   * systems able to read a part of a file should override this method.
+   */
+  virtual std::unique_ptr<FileReader> OpenFileForReading(
+      const gd::String& file);
+
+  /**
+   * \brief Open a file (creating or truncating it) to write its content by
+   * parts.
+   *
+   * This is used to stream large files (see gd::FileWriteStream) without
+   * building their whole content in memory. Each writer has its own state,
+   * so several files can be written at the same time.
+   *
+   * \note The default implementation keeps the content in the writer and
+   * writes the whole file using WriteToFile when it is closed. File systems
+   * able to write a file by parts should override this method.
+   */
+  virtual std::unique_ptr<FileWriter> OpenFileForWriting(
+      const gd::String& file);
+
   /**
    * \brief Return a vector containing the files in the specified path
    *
@@ -125,6 +189,7 @@ class GD_CORE_API AbstractFileSystem {
 
  protected:
   AbstractFileSystem(){};
+
 };
 
 }  // namespace gd
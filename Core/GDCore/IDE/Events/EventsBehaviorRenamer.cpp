@@ -11,6 +11,7 @@
 
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
@@ -103,9 +104,9 @@ bool EventsBehaviorRenamer::DoVisitInstruction(gd::Instruction& instruction,
                                                bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
 
   gd::ParameterMetadataTools::IterateOverParametersWithIndex(
       instruction.GetParameters(),
@@ -124,7 +125,9 @@ bool EventsBehaviorRenamer::DoVisitInstruction(gd::Instruction& instruction,
             }
           }
         } else {
-          auto node = parameterValue.GetRootNode();
+          // Parse a new tree, as the one returned by GetRootNode must not be
+          // modified.
+          auto node = ExpressionParser2().ParseExpression(parameterValue.GetPlainString());
           if (node) {
             ExpressionBehaviorRenamer renamer(objectName,
                                               oldBehaviorName,
@@ -143,9 +143,9 @@ bool EventsContextAnalyzer::DoVisitInstruction(gd::Instruction& instruction,
                                                bool isCondition) {
   const gd::InstructionMetadata& instrInfo =
       isCondition ? MetadataProvider::GetConditionMetadata(
-                        platform, instruction.GetType())
+                        platform, instruction.GetInternedType())
                   : MetadataProvider::GetActionMetadata(platform,
-                                                        instruction.GetType());
+                                                        instruction.GetInternedType());
 
   gd::ParameterMetadataTools::IterateOverParameters(
       instruction.GetParameters(),
@@ -23,9 +23,9 @@ bool EventsLeaderboardsLister::DoVisitInstruction(gd::Instruction& instruction,
                                                   bool isCondition) {
   const gd::InstructionMetadata& instrInfo =
       isCondition ? MetadataProvider::GetConditionMetadata(
-                        project.GetCurrentPlatform(), instruction.GetType())
+                        project.GetCurrentPlatform(), instruction.GetInternedType())
                   : MetadataProvider::GetActionMetadata(
-                        project.GetCurrentPlatform(), instruction.GetType());
+                        project.GetCurrentPlatform(), instruction.GetInternedType());
 
   for (int i = 0; i < instruction.GetParametersCount() &&
                   i < instrInfo.GetParametersCount();
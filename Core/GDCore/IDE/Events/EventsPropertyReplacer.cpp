@@ -13,6 +13,7 @@
 
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
@@ -204,9 +205,9 @@ bool EventsPropertyReplacer::DoVisitInstruction(gd::Instruction& instruction,
                                                 bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
   bool shouldDeleteInstruction = false;
 
   gd::ParameterMetadataTools::IterateOverParametersWithIndex(
@@ -223,7 +224,10 @@ bool EventsPropertyReplacer::DoVisitInstruction(gd::Instruction& instruction,
             !gd::ParameterMetadata::IsExpression("string", type))
           return;  // Not an expression that can contain properties.
 
-        auto node = parameterValue.GetRootNode();
+        // Parse a new tree, as the one returned by GetRootNode must not be
+        // modified.
+        auto node = ExpressionParser2().ParseExpression(
+            parameterValue.GetPlainString());
         if (node) {
           ExpressionPropertyReplacer renamer(platform,
                                              GetProjectScopedContainers(),
@@ -253,7 +257,9 @@ bool EventsPropertyReplacer::DoVisitEventExpression(
       !gd::ParameterMetadata::IsExpression("string", type))
     return false;  // Not an expression that can contain properties.
 
-  auto node = expression.GetRootNode();
+  // Parse a new tree, as the one returned by GetRootNode must not be
+  // modified.
+  auto node = ExpressionParser2().ParseExpression(expression.GetPlainString());
   if (node) {
     ExpressionPropertyReplacer renamer(platform,
                                        GetProjectScopedContainers(),
@@ -11,6 +11,7 @@
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
@@ -304,7 +305,7 @@ bool EventsRefactorer::RenameObjectInActions(const gd::Platform& platform,
 
   for (std::size_t aId = 0; aId < actions.size(); ++aId) {
     const gd::InstructionMetadata& instrInfos =
-        MetadataProvider::GetActionMetadata(platform, actions[aId].GetType());
+        MetadataProvider::GetActionMetadata(platform, actions[aId].GetInternedType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Replace object's name in parameters
       if (gd::ParameterMetadata::IsObject(instrInfos.parameters[pNb].GetType()) &&
@@ -313,7 +314,7 @@ bool EventsRefactorer::RenameObjectInActions(const gd::Platform& platform,
       // Replace object's name in expressions
       else if (ParameterMetadata::IsExpression(
                    "number", instrInfos.parameters[pNb].GetType())) {
-        auto node = actions[aId].GetParameter(pNb).GetRootNode();
+        auto node = ExpressionParser2().ParseExpression(actions[aId].GetParameter(pNb).GetPlainString());
 
         if (ExpressionObjectRenamer::Rename(platform, projectScopedContainers, "number", *node, oldName, newName)) {
           actions[aId].SetParameter(
@@ -323,7 +324,7 @@ bool EventsRefactorer::RenameObjectInActions(const gd::Platform& platform,
       // Replace object's name in text expressions
       else if (ParameterMetadata::IsExpression(
                    "string", instrInfos.parameters[pNb].GetType())) {
-        auto node = actions[aId].GetParameter(pNb).GetRootNode();
+        auto node = ExpressionParser2().ParseExpression(actions[aId].GetParameter(pNb).GetPlainString());
 
         if (ExpressionObjectRenamer::Rename(platform, projectScopedContainers, "string", *node, oldName, newName)) {
           actions[aId].SetParameter(
@@ -356,7 +357,7 @@ bool EventsRefactorer::RenameObjectInConditions(
   for (std::size_t cId = 0; cId < conditions.size(); ++cId) {
     const gd::InstructionMetadata& instrInfos =
         MetadataProvider::GetConditionMetadata(platform,
-                                               conditions[cId].GetType());
+                                               conditions[cId].GetInternedType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Replace object's name in parameters
       if (gd::ParameterMetadata::IsObject(instrInfos.parameters[pNb].GetType()) &&
@@ -365,7 +366,7 @@ bool EventsRefactorer::RenameObjectInConditions(
       // Replace object's name in expressions
       else if (ParameterMetadata::IsExpression(
                    "number", instrInfos.parameters[pNb].GetType())) {
-        auto node = conditions[cId].GetParameter(pNb).GetRootNode();
+        auto node = ExpressionParser2().ParseExpression(conditions[cId].GetParameter(pNb).GetPlainString());
 
         if (ExpressionObjectRenamer::Rename(platform, projectScopedContainers, "number", *node, oldName, newName)) {
           conditions[cId].SetParameter(
@@ -375,7 +376,7 @@ bool EventsRefactorer::RenameObjectInConditions(
       // Replace object's name in text expressions
       else if (ParameterMetadata::IsExpression(
                    "string", instrInfos.parameters[pNb].GetType())) {
-        auto node = conditions[cId].GetParameter(pNb).GetRootNode();
+        auto node = ExpressionParser2().ParseExpression(conditions[cId].GetParameter(pNb).GetPlainString());
 
         if (ExpressionObjectRenamer::Rename(platform, projectScopedContainers, "string", *node, oldName, newName)) {
           conditions[cId].SetParameter(
@@ -412,7 +413,7 @@ bool EventsRefactorer::RenameObjectInEventParameters(
   // Replace object's name in expressions
   else if (ParameterMetadata::IsExpression("number",
                                            parameterMetadata.GetType())) {
-    auto node = expression.GetRootNode();
+    auto node = ExpressionParser2().ParseExpression(expression.GetPlainString());
 
     if (ExpressionObjectRenamer::Rename(platform, projectScopedContainers, "number", *node, oldName, newName)) {
       expression = ExpressionParser2NodePrinter::PrintNode(*node);
@@ -421,7 +422,7 @@ bool EventsRefactorer::RenameObjectInEventParameters(
   // Replace object's name in text expressions
   else if (ParameterMetadata::IsExpression("string",
                                            parameterMetadata.GetType())) {
-    auto node = expression.GetRootNode();
+    auto node = ExpressionParser2().ParseExpression(expression.GetPlainString());
 
     if (ExpressionObjectRenamer::Rename(platform, projectScopedContainers, "string", *node, oldName, newName)) {
       expression = ExpressionParser2NodePrinter::PrintNode(*node);
@@ -484,7 +485,7 @@ bool EventsRefactorer::RemoveObjectInActions(const gd::Platform& platform,
     bool deleteMe = false;
 
     const gd::InstructionMetadata& instrInfos =
-        MetadataProvider::GetActionMetadata(platform, actions[aId].GetType());
+        MetadataProvider::GetActionMetadata(platform, actions[aId].GetInternedType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Find object's name in parameters
       if (gd::ParameterMetadata::IsObject(instrInfos.parameters[pNb].GetType()) &&
@@ -542,7 +543,7 @@ bool EventsRefactorer::RemoveObjectInConditions(
 
     const gd::InstructionMetadata& instrInfos =
         MetadataProvider::GetConditionMetadata(platform,
-                                               conditions[cId].GetType());
+                                               conditions[cId].GetInternedType());
     for (std::size_t pNb = 0; pNb < instrInfos.parameters.size(); ++pNb) {
       // Find object's name in parameters
       if (gd::ParameterMetadata::IsObject(instrInfos.parameters[pNb].GetType()) &&
@@ -973,9 +974,9 @@ bool EventsRefactorer::SearchStringInFormattedText(const gd::Platform& platform,
                                                    bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
   gd::String completeSentence =
       gd::InstructionSentenceFormatter::Get()->GetFullText(instruction,
                                                            metadata);
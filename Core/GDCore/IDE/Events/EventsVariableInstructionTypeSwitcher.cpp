@@ -35,9 +35,9 @@ bool EventsVariableInstructionTypeSwitcher::DoVisitInstruction(gd::Instruction&
                                                 bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
 
   gd::ParameterMetadataTools::IterateOverParametersWithIndex(
       instruction.GetParameters(),
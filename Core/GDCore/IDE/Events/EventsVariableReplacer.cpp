@@ -13,6 +13,7 @@
 
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
@@ -419,9 +420,9 @@ bool EventsVariableReplacer::DoVisitInstruction(gd::Instruction& instruction,
                                                 bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
   bool shouldDeleteInstruction = false;
 
   gd::ParameterMetadataTools::IterateOverParametersWithIndex(
@@ -438,7 +439,10 @@ bool EventsVariableReplacer::DoVisitInstruction(gd::Instruction& instruction,
             !gd::ParameterMetadata::IsExpression("string", type))
           return;  // Not an expression that can contain variables.
 
-        auto node = parameterValue.GetRootNode();
+        // Parse a new tree, as the one returned by GetRootNode must not be
+        // modified.
+        auto node = ExpressionParser2().ParseExpression(
+            parameterValue.GetPlainString());
         if (node) {
           ExpressionVariableReplacer renamer(platform,
                                              GetProjectScopedContainers(),
@@ -470,7 +474,9 @@ bool EventsVariableReplacer::DoVisitEventExpression(
       !gd::ParameterMetadata::IsExpression("string", type))
     return false;  // Not an expression that can contain variables.
 
-  auto node = expression.GetRootNode();
+  // Parse a new tree, as the one returned by GetRootNode must not be
+  // modified.
+  auto node = ExpressionParser2().ParseExpression(expression.GetPlainString());
   if (node) {
     ExpressionVariableReplacer renamer(platform,
                                        GetProjectScopedContainers(),
@@ -396,8 +396,8 @@ class GD_CORE_API ExpressionValidator : public ExpressionParser2NodeWorker {
                   const ExpressionParserLocation &location, bool isFatal = true,
                   const gd::String &actualValue = "",
                   const gd::String &objectName = "") {
-    auto diagnostic = gd::make_unique<ExpressionParserError>(
-        type, message, location, actualValue, objectName);
+    auto diagnostic = gd::MakeArenaUnique<ExpressionParserError>(
+        nullptr, type, message, location, actualValue, objectName);
     allErrors.push_back(diagnostic.get());
     if (isFatal) {
       fatalErrors.push_back(diagnostic.get());
@@ -463,7 +463,7 @@ class GD_CORE_API ExpressionValidator : public ExpressionParser2NodeWorker {
 
   std::vector<ExpressionParserError*> fatalErrors;
   std::vector<ExpressionParserError*> allErrors;
-  std::vector<std::unique_ptr<ExpressionParserError>> supplementalErrors;
+  std::vector<ArenaUniquePtr<ExpressionParserError>> supplementalErrors;
   Type childType; ///< The type "discovered" down the tree and passed up.
   Type parentType; ///< The type "required" by the top of the tree.
   bool forbidsUsageOfBracketsBecauseParentIsObject;
@@ -11,6 +11,7 @@
 
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
@@ -76,7 +77,7 @@ class GD_CORE_API ExpressionParameterMover
   void OnVisitObjectFunctionNameNode(ObjectFunctionNameNode& node) override {}
   void OnVisitFunctionCallNode(FunctionCallNode& node) override {
     auto moveParameter =
-        [this](std::vector<std::unique_ptr<gd::ExpressionNode>>& parameters, int firstWrittenParameterIndex) {
+        [this](std::vector<gd::ArenaUniquePtr<gd::ExpressionNode>>& parameters, int firstWrittenParameterIndex) {
           size_t newExpressionIndex = newIndex - firstWrittenParameterIndex;
           size_t oldExpressionIndex = oldIndex - firstWrittenParameterIndex;
 
@@ -140,9 +141,9 @@ bool ExpressionsParameterMover::DoVisitInstruction(gd::Instruction& instruction,
                                                    bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
 
   for (std::size_t pNb = 0; pNb < metadata.parameters.size() &&
                             pNb < instruction.GetParametersCount();
@@ -150,7 +151,9 @@ bool ExpressionsParameterMover::DoVisitInstruction(gd::Instruction& instruction,
     const gd::String& type = metadata.parameters[pNb].GetType();
     const gd::Expression& expression = instruction.GetParameter(pNb);
 
-    auto node = expression.GetRootNode();
+    // Parse a new tree, as the one returned by GetRootNode must not be
+    // modified.
+    auto node = ExpressionParser2().ParseExpression(expression.GetPlainString());
     if (node) {
       ExpressionParameterMover mover(GetProjectScopedContainers(),
                                      behaviorType,
@@ -11,6 +11,7 @@
 
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Events/Parsers/ExpressionParser2NodeWorker.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
@@ -147,16 +148,18 @@ bool ExpressionsRenamer::DoVisitInstruction(gd::Instruction& instruction,
                                             bool isCondition) {
   const auto& metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
 
   for (std::size_t pNb = 0; pNb < metadata.parameters.size() &&
                             pNb < instruction.GetParametersCount();
        ++pNb) {
     const gd::Expression& expression = instruction.GetParameter(pNb);
 
-    auto node = expression.GetRootNode();
+    // Parse a new tree, as the one returned by GetRootNode must not be
+    // modified.
+    auto node = ExpressionParser2().ParseExpression(expression.GetPlainString());
     if (node) {
       ExpressionFunctionRenamer renamer(GetProjectScopedContainers(),
                                         behaviorType,
@@ -83,7 +83,7 @@ protected:
     gd::ParameterMetadataTools::IterateOverParametersWithIndex(
         platform, projectScopedContainers.GetObjectsContainersList(), node,
         [&](const gd::ParameterMetadata &parameterMetadata,
-            std::unique_ptr<gd::ExpressionNode> &parameterNode,
+            gd::ArenaUniquePtr<gd::ExpressionNode> &parameterNode,
             size_t parameterIndex, const gd::String &lastObjectName) {
           if (parameterMetadata.GetType() == "layer") {
             if (parameterNode->location.GetEndPosition() -
@@ -141,9 +141,9 @@ bool ProjectElementRenamer::DoVisitInstruction(gd::Instruction &instruction,
                                                bool isCondition) {
   const auto &metadata = isCondition
                              ? gd::MetadataProvider::GetConditionMetadata(
-                                   platform, instruction.GetType())
+                                   platform, instruction.GetInternedType())
                              : gd::MetadataProvider::GetActionMetadata(
-                                   platform, instruction.GetType());
+                                   platform, instruction.GetInternedType());
 
   gd::String lastLayerName;
   gd::ParameterMetadataTools::IterateOverParametersWithIndex(
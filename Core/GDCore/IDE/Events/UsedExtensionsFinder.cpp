@@ -54,9 +54,9 @@ bool UsedExtensionsFinder::DoVisitInstruction(gd::Instruction& instruction,
                                               bool isCondition) {
   auto metadata =
       isCondition ? gd::MetadataProvider::GetExtensionAndConditionMetadata(
-                        project.GetCurrentPlatform(), instruction.GetType())
+                        project.GetCurrentPlatform(), instruction.GetInternedType())
                   : gd::MetadataProvider::GetExtensionAndActionMetadata(
-                        project.GetCurrentPlatform(), instruction.GetType());
+                        project.GetCurrentPlatform(), instruction.GetInternedType());
   result.GetUsedExtensions().insert(metadata.GetExtension().GetName());
   for (auto&& includeFile : metadata.GetMetadata().GetIncludeFiles()) {
     result.GetUsedIncludeFiles().insert(includeFile);
@@ -0,0 +1,54 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/IDE/FileWriteStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gd {
+
+FileWriteStream::FileWriteStream(gd::AbstractFileSystem& fs_,
+                                 const gd::String& filename_,
+                                 std::size_t bufferSize)
+    : writer(fs_.OpenFileForWriting(filename_)),
+      buffer(bufferSize),
+      current(0),
+      success(true),
+      closed(false) {}
+
+FileWriteStream::~FileWriteStream() {
+  if (!closed) Close();
+}
+
+void FileWriteStream::Write(const char* data, std::size_t size) {
+  while (size > 0) {
+    if (current == buffer.size()) Flush();
+
+    std::size_t writtenSize = std::min(size, buffer.size() - current);
+    memcpy(buffer.data() + current, data, writtenSize);
+    current += writtenSize;
+    data += writtenSize;
+    size -= writtenSize;
+  }
+}
+
+void FileWriteStream::Flush() {
+  if (current == 0) return;
+
+  if (!writer->Write(buffer.data(), current)) success = false;
+  current = 0;
+}
+
+bool FileWriteStream::Close() {
+  if (closed) return success;
+
+  Flush();
+  if (!writer->Close()) success = false;
+  closed = true;
+  return success;
+}
+
+}  // namespace gd
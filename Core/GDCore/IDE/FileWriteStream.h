@@ -0,0 +1,81 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_FILEWRITESTREAM_H
+#define GDCORE_FILEWRITESTREAM_H
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief Write a file by chunks, using a gd::AbstractFileSystem.
+ *
+ * Written data is buffered and sent to the file system (see
+ * gd::AbstractFileSystem::OpenFileForWriting) each time the buffer is full, so
+ * that
+ * large files can be written without building their whole content in memory.
+ *
+ * This can be used as an output stream for gd::Serializer::ToJSON.
+ *
+ * \ingroup IDE
+ */
+class GD_CORE_API FileWriteStream {
+ public:
+  typedef char Ch;
+
+  FileWriteStream(gd::AbstractFileSystem& fs,
+                  const gd::String& filename,
+                  std::size_t bufferSize = 64 * 1024);
+  ~FileWriteStream();
+
+  /**
+   * \brief Write a character.
+   */
+  void Put(Ch c) {
+    if (current == buffer.size()) Flush();
+    buffer[current++] = c;
+  }
+
+  /**
+   * \brief Write a string.
+   */
+  void Write(const gd::String& str) { Write(str.Raw().data(), str.Raw().size()); }
+
+  /**
+   * \brief Write \a size bytes.
+   */
+  void Write(const char* data, std::size_t size);
+
+  /**
+   * \brief Send the buffered data to the file system.
+   */
+  void Flush();
+
+  /**
+   * \brief Flush the data and finish writing the file.
+   *
+   * \return true if the whole file was written successfully.
+   */
+  bool Close();
+
+ private:
+  FileWriteStream(const FileWriteStream&) = delete;
+  FileWriteStream& operator=(const FileWriteStream&) = delete;
+
+  std::unique_ptr<gd::AbstractFileSystem::FileWriter> writer;
+  std::vector<Ch> buffer;
+  std::size_t current;  ///< The number of bytes in the buffer.
+  bool success;         ///< false if a chunk could not be written.
+  bool closed;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_FILEWRITESTREAM_H
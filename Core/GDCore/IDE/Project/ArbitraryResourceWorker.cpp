@@ -213,9 +213,9 @@ bool ResourceWorkerInEventsWorker::DoVisitInstruction(gd::Instruction& instructi
   const auto& platform = project.GetCurrentPlatform();
   const auto& metadata = isCondition
                               ? gd::MetadataProvider::GetConditionMetadata(
-                                    platform, instruction.GetType())
+                                    platform, instruction.GetInternedType())
                               : gd::MetadataProvider::GetActionMetadata(
-                                    platform, instruction.GetType());
+                                    platform, instruction.GetInternedType());
 
   gd::ParameterMetadataTools::IterateOverParametersWithIndex(
       instruction.GetParameters(),
@@ -12,8 +12,15 @@ namespace gd {
 
 SceneNameMangler *SceneNameMangler::_singleton = nullptr;
 
+namespace {
+std::mutex singletonMutex;
+}
+
 const gd::String &SceneNameMangler::GetMangledSceneName(
     const gd::String &sceneName) {
+  // References to the memoized names stay valid when other names are added,
+  // so they can be returned after the lock is released.
+  std::lock_guard<std::mutex> lock(mangledSceneNamesMutex);
   auto it = mangledSceneNames.find(sceneName);
   if (it != mangledSceneNames.end()) {
     return it->second;
@@ -43,12 +50,14 @@ const gd::String &SceneNameMangler::GetMangledSceneName(
 }
 
 SceneNameMangler *SceneNameMangler::Get() {
+  std::lock_guard<std::mutex> lock(singletonMutex);
   if (nullptr == _singleton) _singleton = new SceneNameMangler;
 
   return (static_cast<SceneNameMangler *>(_singleton));
 }
 
 void SceneNameMangler::DestroySingleton() {
+  std::lock_guard<std::mutex> lock(singletonMutex);
   if (nullptr != _singleton) {
     delete _singleton;
     _singleton = nullptr;
@@ -6,6 +6,7 @@
 
 #ifndef SCENENAMEMANGLER_H
 #define SCENENAMEMANGLER_H
+#include <mutex>
 #include <unordered_map>
 #include "GDCore/String.h"
 
@@ -26,6 +27,9 @@ class GD_CORE_API SceneNameMangler {
    *
    * The mangled name is memoized as this is intensively used during project
    * export and events code generation.
+   *
+   * \note This can be called concurrently from multiple threads (for example
+   * when layouts are unserialized in parallel).
    */
   const gd::String& GetMangledSceneName(const gd::String& sceneName);
 
@@ -39,6 +43,7 @@ class GD_CORE_API SceneNameMangler {
 
   std::unordered_map<gd::String, gd::String>
       mangledSceneNames;  ///< Memoized results of mangling
+  std::mutex mangledSceneNamesMutex;  ///< Protects mangledSceneNames.
 };
 
 }  // namespace gd
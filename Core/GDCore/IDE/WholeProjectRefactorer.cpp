@@ -1517,6 +1517,7 @@ void WholeProjectRefactorer::DoRenameObject(
 
 void WholeProjectRefactorer::ObjectRemovedInLayout(
     gd::Project &project, gd::Layout &layout, const gd::String &objectName) {
+  layout.SetDirty();
   auto projectScopedContainers = gd::ProjectScopedContainers::
       MakeNewProjectScopedContainersForProjectAndLayout(project, layout);
 
@@ -1543,6 +1544,7 @@ void WholeProjectRefactorer::ObjectOrGroupRenamedInLayout(
   if (oldName == newName || newName.empty() || oldName.empty())
     return;
 
+  layout.SetDirty();
   auto projectScopedContainers = gd::ProjectScopedContainers::
       MakeNewProjectScopedContainersForProjectAndLayout(project, layout);
 
@@ -1634,6 +1636,7 @@ void WholeProjectRefactorer::RenameLayer(gd::Project &project,
   if (oldName == newName || newName.empty() || oldName.empty())
     return;
 
+  layout.SetDirty();
   gd::ProjectElementRenamer projectElementRenamer(project.GetCurrentPlatform(),
                                                   "layer", oldName, newName);
   gd::ProjectBrowserHelper::ExposeLayoutEventsAndExternalEvents(
@@ -1655,6 +1658,7 @@ void WholeProjectRefactorer::RenameLayerEffect(gd::Project &project,
                                                const gd::String &newName) {
   if (oldName == newName || newName.empty() || oldName.empty())
     return;
+  layout.SetDirty();
   gd::ProjectElementRenamer projectElementRenamer(
       project.GetCurrentPlatform(), "layerEffectName", oldName, newName);
   projectElementRenamer.SetLayerConstraint(layer.GetName());
@@ -1669,6 +1673,7 @@ void WholeProjectRefactorer::RenameObjectAnimation(gd::Project &project,
                                                    const gd::String &newName) {
   if (oldName == newName || newName.empty() || oldName.empty())
     return;
+  layout.SetDirty();
   gd::ProjectElementRenamer projectElementRenamer(
       project.GetCurrentPlatform(), "objectAnimationName", oldName, newName);
   projectElementRenamer.SetObjectConstraint(object.GetName());
@@ -1683,6 +1688,7 @@ void WholeProjectRefactorer::RenameObjectPoint(gd::Project &project,
                                                const gd::String &newName) {
   if (oldName == newName || newName.empty() || oldName.empty())
     return;
+  layout.SetDirty();
   gd::ProjectElementRenamer projectElementRenamer(
       project.GetCurrentPlatform(), "objectPointName", oldName, newName);
   projectElementRenamer.SetObjectConstraint(object.GetName());
@@ -1697,6 +1703,7 @@ void WholeProjectRefactorer::RenameObjectEffect(gd::Project &project,
                                                 const gd::String &newName) {
   if (oldName == newName || newName.empty() || oldName.empty())
     return;
+  layout.SetDirty();
   gd::ProjectElementRenamer projectElementRenamer(
       project.GetCurrentPlatform(), "objectEffectName", oldName, newName);
   projectElementRenamer.SetObjectConstraint(object.GetName());
@@ -1807,6 +1814,7 @@ void WholeProjectRefactorer::RemoveLayer(gd::Project &project,
   if (layerName.empty())
     return;
 
+  layout.SetDirty();
   layout.GetInitialInstances().RemoveAllInstancesOnLayer(layerName);
 
   std::vector<gd::String> externalLayoutsNames =
@@ -1824,6 +1832,7 @@ void WholeProjectRefactorer::MergeLayers(gd::Project &project,
   if (originLayerName == targetLayerName || originLayerName.empty())
     return;
 
+  layout.SetDirty();
   layout.GetInitialInstances().MoveInstancesToLayer(originLayerName,
                                                     targetLayerName);
 
@@ -10,6 +10,7 @@
 #include <memory>
 #include "GDCore/Serialization/Serializer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/InternedString.h"
 
 namespace gd {
 class PropertyDescriptor;
@@ -34,7 +35,7 @@ class GD_CORE_API BehaviorConfigurationContainer {
   BehaviorConfigurationContainer() : folded(false){};
   BehaviorConfigurationContainer(const gd::String& name_,
                                  const gd::String& type_)
-      : name(name_), type(type_), folded(false){};
+      : name(name_), type(gd::InternedString(type_)), folded(false){};
   virtual ~BehaviorConfigurationContainer();
   virtual BehaviorConfigurationContainer* Clone() const { return new BehaviorConfigurationContainer(*this); }
 
@@ -51,12 +52,14 @@ class GD_CORE_API BehaviorConfigurationContainer {
   /**
    * \brief Return the type of the behavior
    */
-  const gd::String& GetTypeName() const { return type; }
+  const gd::String& GetTypeName() const { return type.GetString(); }
 
   /**
    * \brief Set the type of the behavior.
    */
-  void SetTypeName(const gd::String& type_) { type = type_; };
+  void SetTypeName(const gd::String& type_) {
+    type = gd::InternedString(type_);
+  };
 
   /**
    * \brief Called when the IDE wants to know about the custom properties of the
@@ -155,8 +158,8 @@ protected:
 
  private:
   gd::String name;  ///< Name of the behavior
-  gd::String type;  ///< The type of the behavior that is represented. Usually
-                    ///< in the form "ExtensionName::BehaviorTypeName"
+  gd::InternedString type;  ///< The type of the behavior that is represented.
+                            ///< Usually in the form "ExtensionName::BehaviorTypeName"
 
   gd::SerializerElement content;  // Storage for the behavior properties
   bool folded;
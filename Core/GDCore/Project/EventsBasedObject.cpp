@@ -24,7 +24,7 @@ EventsBasedObject::~EventsBasedObject() {}
 EventsBasedObject::EventsBasedObject(const gd::EventsBasedObject &_eventBasedObject)
         : AbstractEventsBasedEntity(_eventBasedObject) {
   // TODO Add a copy constructor in ObjectsContainer.
-  initialObjects = gd::Clone(_eventBasedObject.initialObjects);
+  CopyObjectsFrom(_eventBasedObject);
   objectGroups = _eventBasedObject.objectGroups;
 }
 
@@ -34,6 +34,7 @@ EventsFunctionsExtension& EventsFunctionsExtension::operator=(
 }
 
 void EventsFunctionsExtension::Init(const gd::EventsFunctionsExtension& other) {
+  SetDirty();
   version = other.version;
   extensionNamespace = other.extensionNamespace;
   shortDescription = other.shortDescription;
@@ -104,6 +105,7 @@ void EventsFunctionsExtension::UnserializeFrom(
 
 void EventsFunctionsExtension::UnserializeExtensionDeclarationFrom(
     gd::Project& project, const SerializerElement& element) {
+  SetDirty();
   version = element.GetStringAttribute("version");
   extensionNamespace = element.GetStringAttribute("extensionNamespace");
   shortDescription = element.GetStringAttribute("shortDescription");
@@ -181,6 +183,7 @@ void EventsFunctionsExtension::UnserializeExtensionDeclarationFrom(
 void EventsFunctionsExtension::UnserializeExtensionImplementationFrom(
     gd::Project& project,
     const SerializerElement& element) {
+  SetDirty();
   UnserializeEventsFunctionsFrom(project, element.GetChild("eventsFunctions"));
   eventsBasedBehaviors.UnserializeElementsFrom(
       "eventsBasedBehavior", project, element.GetChild("eventsBasedBehaviors"));
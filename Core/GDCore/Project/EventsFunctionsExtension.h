@@ -13,6 +13,7 @@
 #include "GDCore/Project/EventsFunctionsContainer.h"
 #include "GDCore/Project/VariablesContainer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/DirtyFlag.h"
 #include "GDCore/Tools/SerializableWithNameList.h"
 namespace gd {
 class SerializerElement;
@@ -52,12 +53,14 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
 
   const gd::String& GetVersion() const { return version; };
   EventsFunctionsExtension& SetVersion(const gd::String& version_) {
+    SetDirty();
     version = version_;
     return *this;
   }
 
   const gd::String& GetNamespace() const { return extensionNamespace; };
   EventsFunctionsExtension& SetNamespace(const gd::String& namespace_) {
+    SetDirty();
     extensionNamespace = namespace_;
     return *this;
   }
@@ -65,42 +68,54 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
   const gd::String& GetShortDescription() const { return shortDescription; };
   EventsFunctionsExtension& SetShortDescription(
       const gd::String& shortDescription_) {
+    SetDirty();
     shortDescription = shortDescription_;
     return *this;
   }
 
   const gd::String& GetDescription() const { return description; };
   EventsFunctionsExtension& SetDescription(const gd::String& description_) {
+    SetDirty();
     description = description_;
     return *this;
   }
 
   const gd::String& GetName() const { return name; };
   EventsFunctionsExtension& SetName(const gd::String& name_) {
+    SetDirty();
     name = name_;
     return *this;
   }
 
   const gd::String& GetFullName() const { return fullName; };
   EventsFunctionsExtension& SetFullName(const gd::String& fullName_) {
+    SetDirty();
     fullName = fullName_;
     return *this;
   }
 
   const gd::String& GetCategory() const { return category; };
   EventsFunctionsExtension& SetCategory(const gd::String& category_) {
+    SetDirty();
     category = category_;
     return *this;
   }
 
   const std::vector<gd::String>& GetTags() const { return tags; };
-  std::vector<gd::String>& GetTags() { return tags; };
+  std::vector<gd::String>& GetTags() {
+    SetDirty();
+    return tags;
+  };
 
   const std::vector<gd::String>& GetAuthorIds() const { return authorIds; };
-  std::vector<gd::String>& GetAuthorIds() { return authorIds; };
+  std::vector<gd::String>& GetAuthorIds() {
+    SetDirty();
+    return authorIds;
+  };
 
   const gd::String& GetAuthor() const { return author; };
   EventsFunctionsExtension& SetAuthor(const gd::String& author_) {
+    SetDirty();
     author = author_;
     return *this;
   }
@@ -108,12 +123,14 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
   const gd::String& GetPreviewIconUrl() const { return previewIconUrl; };
   EventsFunctionsExtension& SetPreviewIconUrl(
       const gd::String& previewIconUrl_) {
+    SetDirty();
     previewIconUrl = previewIconUrl_;
     return *this;
   }
 
   const gd::String& GetIconUrl() const { return iconUrl; };
   EventsFunctionsExtension& SetIconUrl(const gd::String& iconUrl_) {
+    SetDirty();
     iconUrl = iconUrl_;
     return *this;
   }
@@ -129,6 +146,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * documentation root.
    */
   EventsFunctionsExtension& SetHelpPath(const gd::String& helpPath_) {
+    SetDirty();
     helpPath = helpPath_;
     return *this;
   }
@@ -137,6 +155,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * \brief Return a reference to the list of the events based behaviors.
    */
   gd::SerializableWithNameList<EventsBasedBehavior>& GetEventsBasedBehaviors() {
+    SetDirty();
     return eventsBasedBehaviors;
   }
 
@@ -152,6 +171,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * \brief Return a reference to the list of the events based objects.
    */
   gd::SerializableWithNameList<EventsBasedObject>& GetEventsBasedObjects() {
+    SetDirty();
     return eventsBasedObjects;
   }
 
@@ -171,6 +191,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    */
   virtual void SetOrigin(const gd::String& originName_,
                          const gd::String& originIdentifier_) {
+    SetDirty();
     originName = originName_;
     originIdentifier = originIdentifier_;
   }
@@ -188,6 +209,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * \brief Adds a new dependency.
    */
   gd::DependencyMetadata& AddDependency() {
+    SetDirty();
     gd::DependencyMetadata dependency;
     dependencies.push_back(dependency);
     return dependencies.back();
@@ -197,6 +219,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * \brief Adds a new dependency.
    */
   void RemoveDependencyAt(size_t index) {
+    SetDirty();
     dependencies.erase(dependencies.begin() + index);
   };
 
@@ -204,6 +227,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * \brief Returns the list of dependencies.
    */
   std::vector<gd::DependencyMetadata>& GetAllDependencies() {
+    SetDirty();
     return dependencies;
   };
 
@@ -233,7 +257,10 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * Return the global variables of the extension (variables scoped to the
    * entire game lifetime).
    */
-  inline gd::VariablesContainer& GetGlobalVariables() { return globalVariables; }
+  inline gd::VariablesContainer& GetGlobalVariables() {
+    SetDirty();
+    return globalVariables;
+  }
 
   /**
    * Return the global variables of the extension (variables scoped to the
@@ -247,7 +274,10 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
    * Return the global variables of the extension (variables scoped to the
    * lifetime of a scene).
    */
-  inline gd::VariablesContainer& GetSceneVariables() { return sceneVariables; }
+  inline gd::VariablesContainer& GetSceneVariables() {
+    SetDirty();
+    return sceneVariables;
+  }
 
   ///@}
 
@@ -280,6 +310,20 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
   void UnserializeExtensionImplementationFrom(
       gd::Project& project,
       const gd::SerializerElement& element);
+
+  /**
+   * \brief Mark the extension as modified (or not) since it was last
+   * serialized by gd::Project::SerializeTo.
+   *
+   * \see gd::Project::SetIncrementalSerializationEnabled
+   */
+  void SetDirty(bool dirty = true) const { dirtyFlag.SetDirty(dirty); }
+
+  /**
+   * \brief Return true if the extension was modified since it was last
+   * serialized by gd::Project::SerializeTo.
+   */
+  bool IsDirty() const { return dirtyFlag.IsDirty(); }
   ///@}
 
   /** \name Lifecycle event functions
@@ -336,6 +380,7 @@ class GD_CORE_API EventsFunctionsExtension : public EventsFunctionsContainer {
   
   gd::VariablesContainer globalVariables;
   gd::VariablesContainer sceneVariables;
+  mutable gd::DirtyFlag dirtyFlag;
 };
 
 }  // namespace gd
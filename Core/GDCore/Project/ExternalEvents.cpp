@@ -22,6 +22,7 @@ ExternalEvents& ExternalEvents::operator=(const ExternalEvents& rhs) {
 }
 
 void ExternalEvents::Init(const ExternalEvents& externalEvents) {
+  SetDirty();
   name = externalEvents.GetName();
   associatedScene = externalEvents.GetAssociatedLayout();
   lastChangeTimeStamp = externalEvents.GetLastChangeTimeStamp();
@@ -38,6 +39,7 @@ void ExternalEvents::SerializeTo(SerializerElement& element) const {
 
 void ExternalEvents::UnserializeFrom(gd::Project& project,
                                      const SerializerElement& element) {
+  SetDirty();
   name = element.GetStringAttribute("name", "", "Name");
   associatedScene =
       element.GetStringAttribute("associatedLayout", "", "AssociatedScene");
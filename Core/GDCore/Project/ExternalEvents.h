@@ -11,6 +11,7 @@
 
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/DirtyFlag.h"
 namespace gd {
 class BaseEvent;
 }
@@ -48,7 +49,10 @@ class GD_CORE_API ExternalEvents {
   /**
    * \brief Change external events name
    */
-  virtual void SetName(const gd::String& name_) { name = name_; };
+  virtual void SetName(const gd::String& name_) {
+    SetDirty();
+    name = name_;
+  };
 
   /**
    * \brief Get the layout associated with external events.
@@ -64,6 +68,7 @@ class GD_CORE_API ExternalEvents {
    * \brief Set the layout associated with external events.
    */
   virtual void SetAssociatedLayout(const gd::String& name_) {
+    SetDirty();
     associatedScene = name_;
   };
 
@@ -93,7 +98,10 @@ class GD_CORE_API ExternalEvents {
   /**
    * \brief Get the events.
    */
-  virtual gd::EventsList& GetEvents() { return events; }
+  virtual gd::EventsList& GetEvents() {
+    SetDirty();
+    return events;
+  }
 
   /**
    * \brief Serialize external events.
@@ -106,11 +114,26 @@ class GD_CORE_API ExternalEvents {
   virtual void UnserializeFrom(gd::Project& project,
                                const SerializerElement& element);
 
+  /**
+   * \brief Mark the external events as modified (or not) since it was last
+   * serialized by gd::Project::SerializeTo.
+   *
+   * \see gd::Project::SetIncrementalSerializationEnabled
+   */
+  void SetDirty(bool dirty = true) const { dirtyFlag.SetDirty(dirty); }
+
+  /**
+   * \brief Return true if the external events was modified since it was last
+   * serialized by gd::Project::SerializeTo.
+   */
+  bool IsDirty() const { return dirtyFlag.IsDirty(); }
+
  private:
   gd::String name;
   gd::String associatedScene;
   time_t lastChangeTimeStamp;  ///< Time of the last build
   gd::EventsList events;       ///< List of events
+  mutable gd::DirtyFlag dirtyFlag;
 
   /**
    * Initialize from another ExternalEvents. Used by copy-ctor and assign-op.
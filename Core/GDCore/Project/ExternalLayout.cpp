@@ -14,6 +14,7 @@
 namespace gd {
 
 void ExternalLayout::UnserializeFrom(const SerializerElement& element) {
+  SetDirty();
   name = element.GetStringAttribute("name", "", "Name");
   instances.UnserializeFrom(element.GetChild("instances", 0, "Instances"));
   editorSettings.UnserializeFrom(element.GetChild("editionSettings"));
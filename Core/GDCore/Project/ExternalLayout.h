@@ -10,6 +10,7 @@
 
 #include "GDCore/Project/InitialInstancesContainer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/DirtyFlag.h"
 namespace gd {
 class SerializerElement;
 }
@@ -39,7 +40,10 @@ class GD_CORE_API ExternalLayout {
   /**
    * \brief Change the name of the external layout.
    */
-  void SetName(const gd::String& name_) { name = name_; }
+  void SetName(const gd::String& name_) {
+    SetDirty();
+    name = name_;
+  }
 
   /**
    * \brief Return the container storing initial instances.
@@ -51,7 +55,10 @@ class GD_CORE_API ExternalLayout {
   /**
    * \brief Return the container storing initial instances.
    */
-  gd::InitialInstancesContainer& GetInitialInstances() { return instances; }
+  gd::InitialInstancesContainer& GetInitialInstances() {
+    SetDirty();
+    return instances;
+  }
 
   /**
    * \brief Get the user settings for the IDE.
@@ -63,7 +70,10 @@ class GD_CORE_API ExternalLayout {
   /**
    * \brief Get the user settings for the IDE.
    */
-  gd::EditorSettings& GetAssociatedEditorSettings() { return editorSettings; }
+  gd::EditorSettings& GetAssociatedEditorSettings() {
+    SetDirty();
+    return editorSettings;
+  }
 
   /**
    * \brief Get the name of the layout last used to edit the external layout.
@@ -73,7 +83,10 @@ class GD_CORE_API ExternalLayout {
   /**
    * \brief Set the name of the layout used to edit the external layout.
    */
-  void SetAssociatedLayout(const gd::String& name) { associatedLayout = name; }
+  void SetAssociatedLayout(const gd::String& name) {
+    SetDirty();
+    associatedLayout = name;
+  }
 
   /** \name Serialization
    */
@@ -87,6 +100,20 @@ class GD_CORE_API ExternalLayout {
    * \brief Unserialize the external layout.
    */
   void UnserializeFrom(const SerializerElement& element);
+
+  /**
+   * \brief Mark the external layout as modified (or not) since it was last
+   * serialized by gd::Project::SerializeTo.
+   *
+   * \see gd::Project::SetIncrementalSerializationEnabled
+   */
+  void SetDirty(bool dirty = true) const { dirtyFlag.SetDirty(dirty); }
+
+  /**
+   * \brief Return true if the external layout was modified since it was last
+   * serialized by gd::Project::SerializeTo.
+   */
+  bool IsDirty() const { return dirtyFlag.IsDirty(); }
   ///@}
 
  private:
@@ -94,6 +121,7 @@ class GD_CORE_API ExternalLayout {
   gd::InitialInstancesContainer instances;
   gd::EditorSettings editorSettings;
   gd::String associatedLayout;
+  mutable gd::DirtyFlag dirtyFlag;
 };
 
 /**
@@ -62,6 +62,7 @@ Layout::Layout()
 }
 
 void Layout::SetName(const gd::String& name_) {
+  SetDirty();
   name = name_;
   mangledName = gd::SceneNameMangler::Get()->GetMangledSceneName(name);
 };
@@ -88,6 +89,7 @@ const gd::BehaviorsSharedData& Layout::GetBehaviorSharedData(
 
 gd::BehaviorsSharedData& Layout::GetBehaviorSharedData(
     const gd::String& behaviorName) {
+  SetDirty();
   auto it = behaviorsSharedData.find(behaviorName);
   if (it != behaviorsSharedData.end()) return *it->second;
 
@@ -100,6 +102,7 @@ Layout::GetAllBehaviorSharedData() const {
 }
 
 gd::Layer& Layout::GetLayer(const gd::String& name) {
+  SetDirty();
   std::vector<gd::Layer>::iterator layer =
       find_if(initialLayers.begin(),
               initialLayers.end(),
@@ -121,7 +124,10 @@ const gd::Layer& Layout::GetLayer(const gd::String& name) const {
   return badLayer;
 }
 
-gd::Layer& Layout::GetLayer(std::size_t index) { return initialLayers[index]; }
+gd::Layer& Layout::GetLayer(std::size_t index) {
+  SetDirty();
+  return initialLayers[index];
+}
 
 const gd::Layer& Layout::GetLayer(std::size_t index) const {
   return initialLayers[index];
@@ -143,6 +149,7 @@ std::size_t Layout::GetLayerPosition(const gd::String& name) const {
 }
 
 void Layout::InsertNewLayer(const gd::String& name, std::size_t position) {
+  SetDirty();
   gd::Layer newLayer;
   newLayer.SetName(name);
   if (position < initialLayers.size())
@@ -152,6 +159,7 @@ void Layout::InsertNewLayer(const gd::String& name, std::size_t position) {
 }
 
 void Layout::InsertLayer(const gd::Layer& layer, std::size_t position) {
+  SetDirty();
   if (position < initialLayers.size())
     initialLayers.insert(initialLayers.begin() + position, layer);
   else
@@ -159,6 +167,7 @@ void Layout::InsertLayer(const gd::Layer& layer, std::size_t position) {
 }
 
 void Layout::RemoveLayer(const gd::String& name) {
+  SetDirty();
   std::vector<gd::Layer>::iterator layer =
       find_if(initialLayers.begin(),
               initialLayers.end(),
@@ -170,6 +179,7 @@ void Layout::RemoveLayer(const gd::String& name) {
 
 void Layout::SwapLayers(std::size_t firstLayerIndex,
                         std::size_t secondLayerIndex) {
+  SetDirty();
   if (firstLayerIndex >= initialLayers.size() ||
       secondLayerIndex >= initialLayers.size())
     return;
@@ -179,6 +189,7 @@ void Layout::SwapLayers(std::size_t firstLayerIndex,
 }
 
 void Layout::MoveLayer(std::size_t oldIndex, std::size_t newIndex) {
+  SetDirty();
   if (oldIndex >= initialLayers.size() || newIndex >= initialLayers.size())
     return;
 
@@ -188,6 +199,7 @@ void Layout::MoveLayer(std::size_t oldIndex, std::size_t newIndex) {
 }
 
 void Layout::UpdateBehaviorsSharedData(gd::Project& project) {
+  SetDirty();
   std::vector<gd::String> allBehaviorsTypes;
   std::vector<gd::String> allBehaviorsNames;
 
@@ -336,6 +348,7 @@ void Layout::UnserializeLayersFrom(const SerializerElement& element) {
 
 void Layout::UnserializeFrom(gd::Project& project,
                              const SerializerElement& element) {
+  SetDirty();
   SetBackgroundColor(element.GetIntAttribute("r"),
                      element.GetIntAttribute("v"),
                      element.GetIntAttribute("b"));
@@ -407,6 +420,7 @@ void Layout::UnserializeFrom(gd::Project& project,
 }
 
 void Layout::Init(const Layout& other) {
+  SetDirty();
   SetName(other.name);
   backgroundColorR = other.backgroundColorR;
   backgroundColorG = other.backgroundColorG;
@@ -419,7 +433,7 @@ void Layout::Init(const Layout& other) {
   initialLayers = other.initialLayers;
   variables = other.GetVariables();
 
-  initialObjects = gd::Clone(other.initialObjects);
+  CopyObjectsFrom(other);
 
   behaviorsSharedData.clear();
   for (const auto& it : other.behaviorsSharedData) {
@@ -17,6 +17,7 @@
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/VariablesContainer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/DirtyFlag.h"
 #include "GDCore/IDE/Dialogs/LayoutEditorCanvas/EditorSettings.h"
 
 namespace gd {
@@ -72,6 +73,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * Set the background color
    */
   void SetBackgroundColor(unsigned int r, unsigned int g, unsigned int b) {
+    SetDirty();
     backgroundColorR = r;
     backgroundColorG = g;
     backgroundColorB = b;
@@ -100,7 +102,10 @@ class GD_CORE_API Layout : public ObjectsContainer {
   /**
    * Set scene window default title
    */
-  void SetWindowDefaultTitle(const gd::String& title_) { title = title_; };
+  void SetWindowDefaultTitle(const gd::String& title_) {
+    SetDirty();
+    title = title_;
+  };
 
   ///@}
 
@@ -120,6 +125,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * Return the container storing initial instances.
    */
   gd::InitialInstancesContainer& GetInitialInstances() {
+    SetDirty();
     return initialInstances;
   }
   ///@}
@@ -137,7 +143,10 @@ class GD_CORE_API Layout : public ObjectsContainer {
   /**
    * Get the events of the layout
    */
-  gd::EventsList& GetEvents() { return events; }
+  gd::EventsList& GetEvents() {
+    SetDirty();
+    return events;
+  }
 
   ///@}
 
@@ -158,7 +167,10 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * Provide access to the gd::VariablesContainer member containing the layout
    * variables \see gd::VariablesContainer
    */
-  inline gd::VariablesContainer& GetVariables() { return variables; }
+  inline gd::VariablesContainer& GetVariables() {
+    SetDirty();
+    return variables;
+  }
 
   ///@}
 
@@ -297,6 +309,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * \see gd::EditorSettings
    */
   gd::EditorSettings& GetAssociatedEditorSettings() {
+    SetDirty();
     return editorSettings;
   }
 
@@ -307,6 +320,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * Set if the input must be disabled when window lose focus.
    */
   void DisableInputWhenFocusIsLost(bool disable = true) {
+    SetDirty();
     disableInputWhenNotFocused = disable;
   }
 
@@ -319,6 +333,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * Set if the objects z-order are sorted using the standard method
    */
   void SetStandardSortMethod(bool enable = true) {
+    SetDirty();
     standardSortMethod = enable;
   }
 
@@ -331,6 +346,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * Set if the scene must stop all the sounds being played when it is launched.
    */
   void SetStopSoundsOnStartup(bool enable = true) {
+    SetDirty();
     stopSoundsOnStartup = enable;
   }
 
@@ -354,6 +370,20 @@ class GD_CORE_API Layout : public ObjectsContainer {
    * \brief Unserialize the layout.
    */
   void UnserializeFrom(gd::Project& project, const SerializerElement& element);
+
+  /**
+   * \brief Mark the layout as modified (or not) since it was last
+   * serialized by gd::Project::SerializeTo.
+   *
+   * \see gd::Project::SetIncrementalSerializationEnabled
+   */
+  void SetDirty(bool dirty = true) const { dirtyFlag.SetDirty(dirty); }
+
+  /**
+   * \brief Return true if the layout was modified since it was last
+   * serialized by gd::Project::SerializeTo.
+   */
+  bool IsDirty() const { return dirtyFlag.IsDirty(); }
 ///@}
 
 // TODO: GD C++ Platform specific code below
@@ -367,6 +397,12 @@ class GD_CORE_API Layout : public ObjectsContainer {
    */
   void SetProfiler(BaseProfiler* profiler_) { profiler = profiler_; };
 
+ protected:
+  /**
+   * \brief Mark the layout as dirty when its objects can be modified.
+   */
+  virtual void MarkObjectsAsModified() override { SetDirty(); };
+
  private:
   gd::String name;         ///< Scene name
   gd::String mangledName;  ///< The scene name mangled by SceneNameMangler
@@ -394,6 +430,7 @@ class GD_CORE_API Layout : public ObjectsContainer {
 
   EventsList events;  ///< Scene events
   gd::EditorSettings editorSettings;
+  mutable gd::DirtyFlag dirtyFlag;
 
 // TODO: GD C++ Platform specific code below
 
@@ -41,7 +41,7 @@ Object::Object(const gd::String& name_,
 
 void Object::Init(const gd::Object& object) {
   persistentUuid = object.persistentUuid;
-  name = object.name;
+  SetName(object.name);
   assetStoreId = object.assetStoreId;
   objectVariables = object.objectVariables;
   effectsContainer = object.effectsContainer;
@@ -54,6 +54,15 @@ void Object::Init(const gd::Object& object) {
   configuration = object.configuration->Clone();
 }
 
+void Object::SetName(const gd::String& name_) {
+  if (name_ == name) return;
+
+  name = name_;
+  std::shared_ptr<std::atomic<std::size_t>> generation =
+      std::atomic_load(&namesGeneration);
+  if (generation) generation->fetch_add(1, std::memory_order_release);
+}
+
 gd::ObjectConfiguration& Object::GetConfiguration() {
   return *configuration;
 }
@@ -136,7 +145,7 @@ void Object::UnserializeFrom(gd::Project& project,
 
   SetType(element.GetStringAttribute("type"));
   assetStoreId = element.GetStringAttribute("assetStoreId");
-  name = element.GetStringAttribute("name", name, "nom");
+  SetName(element.GetStringAttribute("name", name, "nom"));
 
   objectVariables.UnserializeFrom(
       element.GetChild("variables", 0, "Variables"));
@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
@@ -55,7 +56,7 @@ class GD_CORE_API Object {
   /**
    * Copy constructor. Calls Init().
    */
-  Object(const gd::Object& object) { Init(object); };
+  Object(const gd::Object& object) : name(object.name) { Init(object); };
 
   /**
    * Assignment operator. Calls Init().
@@ -96,7 +97,7 @@ class GD_CORE_API Object {
 
   /** \brief Change the name of the object with the name passed as parameter.
    */
-  void SetName(const gd::String& name_) { name = name_; };
+  void SetName(const gd::String& name_);
 
   /** \brief Return the name of the object.
    */
@@ -246,6 +247,17 @@ class GD_CORE_API Object {
   Object& ClearPersistentUuid();
   ///@}
 
+  /**
+   * \brief Set the counter to increment each time the object is renamed.
+   *
+   * Used by gd::ObjectsContainer to know when the names of its objects must be
+   * indexed again. Copies of the object don't share the counter.
+   */
+  void SetNamesGeneration(
+      std::shared_ptr<std::atomic<std::size_t>> namesGeneration_) {
+    std::atomic_store(&namesGeneration, namesGeneration_);
+  };
+
  protected:
   gd::String name;          ///< The full name of the object
   gd::String assetStoreId;  ///< The ID of the asset if the object comes from
@@ -270,6 +282,9 @@ class GD_CORE_API Object {
    * behaviors and it must be a deep copy.
    */
   void Init(const gd::Object& object);
+
+  std::shared_ptr<std::atomic<std::size_t>>
+      namesGeneration;  ///< See SetNamesGeneration. Can be null.
 };
 
 /**
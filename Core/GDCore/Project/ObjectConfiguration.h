@@ -15,6 +15,7 @@
 #include "GDCore/Project/ResourcesManager.h"
 #include "GDCore/Project/VariablesContainer.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/InternedString.h"
 #include "GDCore/Tools/MakeUnique.h"
 namespace gd {
 class PropertyDescriptor;
@@ -62,12 +63,12 @@ class GD_CORE_API ObjectConfiguration {
   /** \brief Change the type of the object.
    */
   void SetType(const gd::String& type_) {
-    type = type_;
+    type = gd::InternedString(type_);
   }
 
   /** \brief Return the type of the object.
    */
-  const gd::String& GetType() const { return type; }
+  const gd::String& GetType() const { return type.GetString(); }
 
   /** \name Object properties
    * Reading and updating object configuration properties
@@ -170,8 +171,8 @@ class GD_CORE_API ObjectConfiguration {
   ///@}
 
  protected:
-  gd::String type; ///< Which type of object is represented by this
-                   ///< configuration.
+  gd::InternedString type; ///< Which type of object is represented by this
+                           ///< configuration.
 
   /**
    * \brief Derived object configuration can redefine this method to load
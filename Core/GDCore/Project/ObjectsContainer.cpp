@@ -12,10 +12,15 @@
 #include "GDCore/Project/ObjectFolderOrObject.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/Tools/PolymorphicClone.h"
 
 namespace gd {
 
-ObjectsContainer::ObjectsContainer() {
+gd::Object ObjectsContainer::badObject(
+    "", "", gd::make_unique<gd::ObjectConfiguration>());
+
+ObjectsContainer::ObjectsContainer()
+    : namesGeneration(std::make_shared<std::atomic<std::size_t>>(0)) {
   rootFolder = gd::make_unique<gd::ObjectFolderOrObject>("__ROOT");
 }
 
@@ -33,10 +38,12 @@ void ObjectsContainer::SerializeFoldersTo(SerializerElement& element) const {
 
 void ObjectsContainer::UnserializeFoldersFrom(
     gd::Project& project, const SerializerElement& element) {
+  MarkObjectsAsModified();
   rootFolder->UnserializeFrom(project, element, *this);
 }
 
 void ObjectsContainer::AddMissingObjectsInRootFolder() {
+  MarkObjectsAsModified();
   for (std::size_t i = 0; i < initialObjects.size(); ++i) {
     if (!rootFolder->HasObjectNamed(initialObjects[i]->GetName())) {
       rootFolder->InsertObject(&(*initialObjects[i]));
@@ -46,7 +53,9 @@ void ObjectsContainer::AddMissingObjectsInRootFolder() {
 
 void ObjectsContainer::UnserializeObjectsFrom(
     gd::Project& project, const SerializerElement& element) {
+  MarkObjectsAsModified();
   initialObjects.clear();
+  InvalidateObjectsPositions();
   element.ConsiderAsArrayOf("object", "Objet");
   for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
     const SerializerElement& objectElement = element.GetChild(i);
@@ -57,6 +66,7 @@ void ObjectsContainer::UnserializeObjectsFrom(
 
     if (newObject) {
       newObject->UnserializeFrom(project, objectElement);
+      newObject->SetNamesGeneration(namesGeneration);
       initialObjects.push_back(std::move(newObject));
     } else
       std::cout << "WARNING: Unknown object type \"" << type << "\""
@@ -64,38 +74,122 @@ void ObjectsContainer::UnserializeObjectsFrom(
   }
 }
 
+void ObjectsContainer::CopyObjectsFrom(const ObjectsContainer& other) {
+  initialObjects = gd::Clone(other.initialObjects);
+  for (std::size_t i = 0; i < initialObjects.size(); ++i)
+    initialObjects[i]->SetNamesGeneration(namesGeneration);
+  InvalidateObjectsPositions();
+}
+
+std::shared_ptr<const ObjectsContainer::ObjectsPositions>
+ObjectsContainer::GetObjectsPositions() const {
+  // Read the generation before indexing the names, so that the index is built
+  // again if an object is renamed in the meantime.
+  const std::size_t generation =
+      namesGeneration->load(std::memory_order_acquire);
+  std::shared_ptr<const ObjectsPositions> index =
+      std::atomic_load(&objectsPositions);
+  if (index && index->objectsCount == initialObjects.size() &&
+      index->namesGeneration == generation)
+    return index;
+
+  auto newIndex = std::make_shared<ObjectsPositions>();
+  newIndex->objectsCount = initialObjects.size();
+  newIndex->namesGeneration = generation;
+  newIndex->hasDuplicatedNames = false;
+  newIndex->positions.reserve(initialObjects.size());
+  for (std::size_t i = 0; i < initialObjects.size(); ++i) {
+    // Keep the first object having the name, like when searching the objects
+    // one by one.
+    if (!newIndex->positions.emplace(initialObjects[i]->GetName(), i).second)
+      newIndex->hasDuplicatedNames = true;
+  }
+
+  std::atomic_store(&objectsPositions, newIndex);
+  return newIndex;
+}
+
+ObjectsContainer::ObjectsPositions*
+ObjectsContainer::GetUpdatableObjectsPositions() {
+  if (objectsPositions &&
+      objectsPositions->objectsCount == initialObjects.size() &&
+      objectsPositions->namesGeneration ==
+          namesGeneration->load(std::memory_order_acquire) &&
+      !objectsPositions->hasDuplicatedNames)
+    return objectsPositions.get();
+
+  InvalidateObjectsPositions();
+  return nullptr;
+}
+
+void ObjectsContainer::InvalidateObjectsPositions() {
+  std::atomic_store(&objectsPositions, std::shared_ptr<ObjectsPositions>());
+}
+
+void ObjectsContainer::InsertObjectPosition(gd::Object& object,
+                                            std::size_t position) {
+  object.SetNamesGeneration(namesGeneration);
+
+  ObjectsPositions* index = GetUpdatableObjectsPositions();
+  if (!index) return;
+  const gd::String& name = object.GetName();
+  if (index->positions.find(name) != index->positions.end()) {
+    // Let the index be built again to know which object is the first one
+    // having the name.
+    InvalidateObjectsPositions();
+    return;
+  }
+
+  // Objects are usually appended: no position to shift then.
+  if (position < index->objectsCount) {
+    for (auto& it : index->positions) {
+      if (it.second >= position) it.second++;
+    }
+  }
+  index->positions.emplace(name, position);
+  index->objectsCount++;
+}
+
+void ObjectsContainer::RemoveObjectPosition(std::size_t position) {
+  ObjectsPositions* index = GetUpdatableObjectsPositions();
+  if (!index) return;
+
+  index->positions.erase(initialObjects[position]->GetName());
+  if (position + 1 < index->objectsCount) {
+    for (auto& it : index->positions) {
+      if (it.second > position) it.second--;
+    }
+  }
+  index->objectsCount--;
+}
+
 bool ObjectsContainer::HasObjectNamed(const gd::String& name) const {
-  return (find_if(initialObjects.begin(),
-                  initialObjects.end(),
-                  [&](const std::unique_ptr<gd::Object>& object) {
-                    return object->GetName() == name;
-                  }) != initialObjects.end());
+  return GetObjectPosition(name) != gd::String::npos;
 }
 gd::Object& ObjectsContainer::GetObject(const gd::String& name) {
-  return *(*find_if(initialObjects.begin(),
-                    initialObjects.end(),
-                    [&](const std::unique_ptr<gd::Object>& object) {
-                      return object->GetName() == name;
-                    }));
+  MarkObjectsAsModified();
+  std::size_t position = GetObjectPosition(name);
+  if (position == gd::String::npos) return badObject;
+
+  return *initialObjects[position];
 }
 const gd::Object& ObjectsContainer::GetObject(const gd::String& name) const {
-  return *(*find_if(initialObjects.begin(),
-                    initialObjects.end(),
-                    [&](const std::unique_ptr<gd::Object>& object) {
-                      return object->GetName() == name;
-                    }));
+  std::size_t position = GetObjectPosition(name);
+  if (position == gd::String::npos) return badObject;
+
+  return *initialObjects[position];
 }
 gd::Object& ObjectsContainer::GetObject(std::size_t index) {
+  MarkObjectsAsModified();
   return *initialObjects[index];
 }
 const gd::Object& ObjectsContainer::GetObject(std::size_t index) const {
   return *initialObjects[index];
 }
 std::size_t ObjectsContainer::GetObjectPosition(const gd::String& name) const {
-  for (std::size_t i = 0; i < initialObjects.size(); ++i) {
-    if (initialObjects[i]->GetName() == name) return i;
-  }
-  return gd::String::npos;
+  std::shared_ptr<const ObjectsPositions> index = GetObjectsPositions();
+  auto it = index->positions.find(name);
+  return it != index->positions.end() ? it->second : gd::String::npos;
 }
 std::size_t ObjectsContainer::GetObjectsCount() const {
   return initialObjects.size();
@@ -104,10 +198,12 @@ gd::Object& ObjectsContainer::InsertNewObject(const gd::Project& project,
                                               const gd::String& objectType,
                                               const gd::String& name,
                                               std::size_t position) {
+  MarkObjectsAsModified();
+  if (position > initialObjects.size()) position = initialObjects.size();
+  std::unique_ptr<gd::Object> object = project.CreateObject(objectType, name);
+  InsertObjectPosition(*object, position);
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
-      position < initialObjects.size() ? initialObjects.begin() + position
-                                       : initialObjects.end(),
-      project.CreateObject(objectType, name))));
+      initialObjects.begin() + position, std::move(object))));
 
   rootFolder->InsertObject(&newlyCreatedObject);
 
@@ -120,8 +216,11 @@ gd::Object& ObjectsContainer::InsertNewObjectInFolder(
     const gd::String& name,
     gd::ObjectFolderOrObject& objectFolderOrObject,
     std::size_t position) {
+  MarkObjectsAsModified();
+  std::unique_ptr<gd::Object> object = project.CreateObject(objectType, name);
+  InsertObjectPosition(*object, initialObjects.size());
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
-      initialObjects.end(), project.CreateObject(objectType, name))));
+      initialObjects.end(), std::move(object))));
 
   objectFolderOrObject.InsertObject(&newlyCreatedObject, position);
 
@@ -130,35 +229,37 @@ gd::Object& ObjectsContainer::InsertNewObjectInFolder(
 
 gd::Object& ObjectsContainer::InsertObject(const gd::Object& object,
                                            std::size_t position) {
+  MarkObjectsAsModified();
+  if (position > initialObjects.size()) position = initialObjects.size();
+  std::unique_ptr<gd::Object> newObject(object.Clone());
+  InsertObjectPosition(*newObject, position);
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
-      position < initialObjects.size() ? initialObjects.begin() + position
-                                       : initialObjects.end(),
-      std::unique_ptr<gd::Object>(object.Clone()))));
+      initialObjects.begin() + position, std::move(newObject))));
 
   return newlyCreatedObject;
 }
 
 void ObjectsContainer::MoveObject(std::size_t oldIndex, std::size_t newIndex) {
+  MarkObjectsAsModified();
   if (oldIndex >= initialObjects.size() || newIndex >= initialObjects.size())
     return;
 
+  RemoveObjectPosition(oldIndex);
   std::unique_ptr<gd::Object> object = std::move(initialObjects[oldIndex]);
   initialObjects.erase(initialObjects.begin() + oldIndex);
+  InsertObjectPosition(*object, newIndex);
   initialObjects.insert(initialObjects.begin() + newIndex, std::move(object));
 }
 
 void ObjectsContainer::RemoveObject(const gd::String& name) {
-  std::vector<std::unique_ptr<gd::Object>>::iterator objectIt =
-      find_if(initialObjects.begin(),
-              initialObjects.end(),
-              [&](const std::unique_ptr<gd::Object>& object) {
-                return object->GetName() == name;
-              });
-  if (objectIt == initialObjects.end()) return;
+  MarkObjectsAsModified();
+  std::size_t position = GetObjectPosition(name);
+  if (position == gd::String::npos) return;
 
   rootFolder->RemoveRecursivelyObjectNamed(name);
 
-  initialObjects.erase(objectIt);
+  RemoveObjectPosition(position);
+  initialObjects.erase(initialObjects.begin() + position);
 }
 
 void ObjectsContainer::MoveObjectFolderOrObjectToAnotherContainerInFolder(
@@ -166,19 +267,20 @@ void ObjectsContainer::MoveObjectFolderOrObjectToAnotherContainerInFolder(
     gd::ObjectsContainer& newContainer,
     gd::ObjectFolderOrObject& newParentFolder,
     std::size_t newPosition) {
+  MarkObjectsAsModified();
+  newContainer.MarkObjectsAsModified();
   if (objectFolderOrObject.IsFolder() || !newParentFolder.IsFolder()) return;
 
-  std::vector<std::unique_ptr<gd::Object>>::iterator objectIt = find_if(
-      initialObjects.begin(),
-      initialObjects.end(),
-      [&objectFolderOrObject](std::unique_ptr<gd::Object>& object) {
-        return object->GetName() == objectFolderOrObject.GetObject().GetName();
-      });
-  if (objectIt == initialObjects.end()) return;
+  std::size_t position =
+      GetObjectPosition(objectFolderOrObject.GetObject().GetName());
+  if (position == gd::String::npos) return;
 
-  std::unique_ptr<gd::Object> object = std::move(*objectIt);
-  initialObjects.erase(objectIt);
+  RemoveObjectPosition(position);
+  std::unique_ptr<gd::Object> object = std::move(initialObjects[position]);
+  initialObjects.erase(initialObjects.begin() + position);
 
+  newContainer.InsertObjectPosition(*object,
+                                    newContainer.initialObjects.size());
   newContainer.initialObjects.push_back(std::move(object));
 
   objectFolderOrObject.GetParent().MoveObjectFolderOrObjectToAnotherFolder(
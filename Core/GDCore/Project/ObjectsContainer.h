@@ -5,7 +5,9 @@
  */
 #ifndef GDCORE_OBJECTSCONTAINER_H
 #define GDCORE_OBJECTSCONTAINER_H
+#include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "GDCore/String.h"
 #include "GDCore/Project/ObjectGroupsContainer.h"
@@ -53,11 +55,17 @@ class GD_CORE_API ObjectsContainer {
 
   /**
    * \brief Return a reference to the object called \a name.
+   *
+   * \note If no object has this name, a reference to a bad object (without
+   * name nor type) is returned: check HasObjectNamed first.
    */
   Object& GetObject(const gd::String& name);
 
   /**
    * \brief Return a reference to the object called \a name.
+   *
+   * \note If no object has this name, a reference to a bad object (without
+   * name nor type) is returned: check HasObjectNamed first.
    */
   const gd::Object& GetObject(const gd::String& name) const;
 
@@ -154,8 +162,16 @@ class GD_CORE_API ObjectsContainer {
 
   /**
    * Provide a raw access to the vector containing the objects
+   *
+   * \note The index of the names of the objects is built again after the next
+   * call to this method, as the vector can be modified. But the objects
+   * inserted directly in the vector are not known by the container: renaming
+   * them later won't update the index (call GetObjects again after renaming
+   * them, or use InsertObject instead).
    */
   std::vector<std::unique_ptr<gd::Object> >& GetObjects() {
+    MarkObjectsAsModified();
+    InvalidateObjectsPositions();
     return initialObjects;
   }
 
@@ -175,6 +191,7 @@ class GD_CORE_API ObjectsContainer {
   std::vector<const ObjectFolderOrObject*> GetAllObjectFolderOrObjects() const;
 
   gd::ObjectFolderOrObject& GetRootFolder() {
+      MarkObjectsAsModified();
       return *rootFolder;
   }
 
@@ -214,7 +231,10 @@ class GD_CORE_API ObjectsContainer {
   /**
    * \brief Return a reference to the project's objects groups.
    */
-  ObjectGroupsContainer& GetObjectGroups() { return objectGroups; }
+  ObjectGroupsContainer& GetObjectGroups() {
+    MarkObjectsAsModified();
+    return objectGroups;
+  }
 
   /**
    * \brief Return a const reference to the project's objects groups.
@@ -224,12 +244,87 @@ class GD_CORE_API ObjectsContainer {
   ///@}
 
  protected:
+  /**
+   * \brief Called when the objects, their groups or their folders can be
+   * modified: by a modifier of the container, or through a reference returned
+   * by one of its non-const accessors.
+   *
+   * Containers can override it to know when they must be saved again (see
+   * gd::Layout::SetDirty).
+   */
+  virtual void MarkObjectsAsModified(){};
+
+  /**
+   * \brief Replace the objects by copies of the objects of \a other (their
+   * groups and folders are not copied).
+   */
+  void CopyObjectsFrom(const ObjectsContainer& other);
+
+  /**
+   * \brief Discard the index of the names of the objects, so that it's built
+   * again when next needed.
+   *
+   * \note Must be called when initialObjects is modified without using the
+   * methods of this class.
+   */
+  void InvalidateObjectsPositions();
+
   std::vector<std::unique_ptr<gd::Object> >
       initialObjects;  ///< Objects contained.
   gd::ObjectGroupsContainer objectGroups;
 
  private:
+  /**
+   * \brief The positions of the objects in initialObjects, indexed by their
+   * names.
+   */
+  struct ObjectsPositions {
+    std::unordered_map<gd::String, std::size_t> positions;
+    std::size_t objectsCount;     ///< The number of indexed objects.
+    std::size_t namesGeneration;  ///< The value of namesGeneration.
+    bool hasDuplicatedNames;  ///< If true, the position of the first object
+                              ///< having a name is indexed.
+  };
+
+  /**
+   * \brief Return the index of the names of the objects, built if it's not
+   * up to date.
+   *
+   * Objects can be searched by multiple threads: a new index is built and
+   * atomically swapped, so that the returned index stays valid even if
+   * another thread builds the index again in the meantime.
+   */
+  std::shared_ptr<const ObjectsPositions> GetObjectsPositions() const;
+
+  /**
+   * \brief Return the index of the names of the objects if it's up to date
+   * and can be updated in place after a change of initialObjects, or nullptr
+   * (the index is then discarded and will be built again when needed).
+   *
+   * \warning The index is modified in place: like initialObjects, it must not
+   * be used by another thread while the container is modified.
+   */
+  ObjectsPositions* GetUpdatableObjectsPositions();
+
+  /**
+   * \brief Update the index of the names of the objects before \a object is
+   * inserted at \a position in initialObjects.
+   */
+  void InsertObjectPosition(gd::Object& object, std::size_t position);
+
+  /**
+   * \brief Update the index of the names of the objects before the object at
+   * \a position is removed from initialObjects.
+   */
+  void RemoveObjectPosition(std::size_t position);
+
   std::unique_ptr<gd::ObjectFolderOrObject> rootFolder;
+  static gd::Object badObject;  ///< Returned when an object is not found.
+  mutable std::shared_ptr<ObjectsPositions>
+      objectsPositions;  ///< Built lazily, see GetObjectsPositions.
+  std::shared_ptr<std::atomic<std::size_t>>
+      namesGeneration;  ///< Incremented when an object of the container is
+                        ///< renamed (see gd::Object::SetNamesGeneration).
 };
 
 }  // namespace gd
@@ -11,6 +11,7 @@
 
 #include <cctype>
 #include <fstream>
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -37,6 +38,7 @@
 #include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/ParallelFor.h"
 #include "GDCore/Tools/PolymorphicClone.h"
 #include "GDCore/Tools/UUID/UUID.h"
 #include "GDCore/Tools/VersionWrapper.h"
@@ -76,7 +78,10 @@ Project::Project()
       gdMajorVersion(gd::VersionWrapper::Major()),
       gdMinorVersion(gd::VersionWrapper::Minor()),
       gdBuildVersion(gd::VersionWrapper::Build()),
-      variables(gd::VariablesContainer::SourceType::Global) {}
+      variables(gd::VariablesContainer::SourceType::Global),
+      lazyUnserialization(false),
+      unserializationThreadsCount(1),
+      incrementalSerialization(false) {}
 
 Project::~Project() {}
 
@@ -268,15 +273,26 @@ bool Project::HasLayoutNamed(const gd::String& name) const {
                   bind2nd(gd::LayoutHasName(), name)) != scenes.end());
 }
 gd::Layout& Project::GetLayout(const gd::String& name) {
-  return *(*find_if(
+  gd::Layout& layout = *(*find_if(
       scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name)));
+  UnserializeLayoutIfNeeded(layout);
+  // The layout can be modified using the returned reference.
+  layout.SetDirty();
+  return layout;
 }
 const gd::Layout& Project::GetLayout(const gd::String& name) const {
-  return *(*find_if(
+  gd::Layout& layout = *(*find_if(
       scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name)));
+  UnserializeLayoutIfNeeded(layout);
+  return layout;
+}
+gd::Layout& Project::GetLayout(std::size_t index) {
+  UnserializeLayoutIfNeeded(*scenes[index]);
+  scenes[index]->SetDirty();
+  return *scenes[index];
 }
-gd::Layout& Project::GetLayout(std::size_t index) { return *scenes[index]; }
 const gd::Layout& Project::GetLayout(std::size_t index) const {
+  UnserializeLayoutIfNeeded(*scenes[index]);
   return *scenes[index];
 }
 std::size_t Project::GetLayoutPosition(const gd::String& name) const {
@@ -321,6 +337,7 @@ void Project::RemoveLayout(const gd::String& name) {
       find_if(scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name));
   if (scene == scenes.end()) return;
 
+  layoutsToUnserialize.erase(scene->get());
   scenes.erase(scene);
 }
 
@@ -331,20 +348,30 @@ bool Project::HasExternalEventsNamed(const gd::String& name) const {
           externalEvents.end());
 }
 gd::ExternalEvents& Project::GetExternalEvents(const gd::String& name) {
-  return *(*find_if(externalEvents.begin(),
-                    externalEvents.end(),
-                    bind2nd(gd::ExternalEventsHasName(), name)));
+  gd::ExternalEvents& events =
+      *(*find_if(externalEvents.begin(),
+                 externalEvents.end(),
+                 bind2nd(gd::ExternalEventsHasName(), name)));
+  UnserializeExternalEventsIfNeeded(events);
+  events.SetDirty();
+  return events;
 }
 const gd::ExternalEvents& Project::GetExternalEvents(
     const gd::String& name) const {
-  return *(*find_if(externalEvents.begin(),
-                    externalEvents.end(),
-                    bind2nd(gd::ExternalEventsHasName(), name)));
+  gd::ExternalEvents& events =
+      *(*find_if(externalEvents.begin(),
+                 externalEvents.end(),
+                 bind2nd(gd::ExternalEventsHasName(), name)));
+  UnserializeExternalEventsIfNeeded(events);
+  return events;
 }
 gd::ExternalEvents& Project::GetExternalEvents(std::size_t index) {
+  UnserializeExternalEventsIfNeeded(*externalEvents[index]);
+  externalEvents[index]->SetDirty();
   return *externalEvents[index];
 }
 const gd::ExternalEvents& Project::GetExternalEvents(std::size_t index) const {
+  UnserializeExternalEventsIfNeeded(*externalEvents[index]);
   return *externalEvents[index];
 }
 std::size_t Project::GetExternalEventsPosition(const gd::String& name) const {
@@ -386,6 +413,7 @@ void Project::RemoveExternalEvents(const gd::String& name) {
               bind2nd(gd::ExternalEventsHasName(), name));
   if (events == externalEvents.end()) return;
 
+  externalEventsToUnserialize.erase(events->get());
   externalEvents.erase(events);
 }
 
@@ -453,20 +481,30 @@ bool Project::HasExternalLayoutNamed(const gd::String& name) const {
           externalLayouts.end());
 }
 gd::ExternalLayout& Project::GetExternalLayout(const gd::String& name) {
-  return *(*find_if(externalLayouts.begin(),
-                    externalLayouts.end(),
-                    bind2nd(gd::ExternalLayoutHasName(), name)));
+  gd::ExternalLayout& externalLayout =
+      *(*find_if(externalLayouts.begin(),
+                 externalLayouts.end(),
+                 bind2nd(gd::ExternalLayoutHasName(), name)));
+  UnserializeExternalLayoutIfNeeded(externalLayout);
+  externalLayout.SetDirty();
+  return externalLayout;
 }
 const gd::ExternalLayout& Project::GetExternalLayout(
     const gd::String& name) const {
-  return *(*find_if(externalLayouts.begin(),
-                    externalLayouts.end(),
-                    bind2nd(gd::ExternalLayoutHasName(), name)));
+  gd::ExternalLayout& externalLayout =
+      *(*find_if(externalLayouts.begin(),
+                 externalLayouts.end(),
+                 bind2nd(gd::ExternalLayoutHasName(), name)));
+  UnserializeExternalLayoutIfNeeded(externalLayout);
+  return externalLayout;
 }
 gd::ExternalLayout& Project::GetExternalLayout(std::size_t index) {
+  UnserializeExternalLayoutIfNeeded(*externalLayouts[index]);
+  externalLayouts[index]->SetDirty();
   return *externalLayouts[index];
 }
 const gd::ExternalLayout& Project::GetExternalLayout(std::size_t index) const {
+  UnserializeExternalLayoutIfNeeded(*externalLayouts[index]);
   return *externalLayouts[index];
 }
 std::size_t Project::GetExternalLayoutPosition(const gd::String& name) const {
@@ -508,6 +546,7 @@ void Project::RemoveExternalLayout(const gd::String& name) {
               bind2nd(gd::ExternalLayoutHasName(), name));
   if (externalLayout == externalLayouts.end()) return;
 
+  externalLayoutsToUnserialize.erase(externalLayout->get());
   externalLayouts.erase(externalLayout);
 }
 
@@ -532,12 +571,14 @@ bool Project::HasEventsFunctionsExtensionNamed(const gd::String& name) const {
 }
 gd::EventsFunctionsExtension& Project::GetEventsFunctionsExtension(
     const gd::String& name) {
-  return *(*find_if(
+  gd::EventsFunctionsExtension& extension = *(*find_if(
       eventsFunctionsExtensions.begin(),
       eventsFunctionsExtensions.end(),
       [&name](const std::unique_ptr<gd::EventsFunctionsExtension>& extension) {
         return extension->GetName() == name;
       }));
+  extension.SetDirty();
+  return extension;
 }
 const gd::EventsFunctionsExtension& Project::GetEventsFunctionsExtension(
     const gd::String& name) const {
@@ -550,6 +591,7 @@ const gd::EventsFunctionsExtension& Project::GetEventsFunctionsExtension(
 }
 gd::EventsFunctionsExtension& Project::GetEventsFunctionsExtension(
     std::size_t index) {
+  eventsFunctionsExtensions[index]->SetDirty();
   return *eventsFunctionsExtensions[index];
 }
 const gd::EventsFunctionsExtension& Project::GetEventsFunctionsExtension(
@@ -847,7 +889,13 @@ void Project::UnserializeFrom(const SerializerElement& element) {
 
   GetVariables().UnserializeFrom(element.GetChild("variables", 0, "Variables"));
 
+  // Layouts, external events and external layouts are independent: they are
+  // created in order, then unserialized (possibly in parallel) once they all
+  // exist.
+  std::vector<std::function<void()>> unserializationTasks;
+
   scenes.clear();
+  layoutsToUnserialize.clear();
   const SerializerElement& layoutsElement =
       element.GetChild("layouts", 0, "Scenes");
   layoutsElement.ConsiderAsArrayOf("layout", "Scene");
@@ -856,11 +904,17 @@ void Project::UnserializeFrom(const SerializerElement& element) {
 
     gd::Layout& layout = InsertNewLayout(
         layoutElement.GetStringAttribute("name", "", "nom"), -1);
-    layout.UnserializeFrom(*this, layoutElement);
+    if (lazyUnserialization)
+      layoutsToUnserialize[&layout] = layoutsElement.GetSharedChild(i);
+    else
+      unserializationTasks.push_back([this, &layout, &layoutElement]() {
+        layout.UnserializeFrom(*this, layoutElement);
+      });
   }
   SetFirstLayout(element.GetChild("firstLayout").GetStringValue());
 
   externalEvents.clear();
+  externalEventsToUnserialize.clear();
   const SerializerElement& externalEventsElement =
       element.GetChild("externalEvents", 0, "ExternalEvents");
   externalEventsElement.ConsiderAsArrayOf("externalEvents", "ExternalEvents");
@@ -871,10 +925,18 @@ void Project::UnserializeFrom(const SerializerElement& element) {
     gd::ExternalEvents& externalEvents = InsertNewExternalEvents(
         externalEventElement.GetStringAttribute("name", "", "Name"),
         GetExternalEventsCount());
-    externalEvents.UnserializeFrom(*this, externalEventElement);
+    if (lazyUnserialization)
+      externalEventsToUnserialize[&externalEvents] =
+          externalEventsElement.GetSharedChild(i);
+    else
+      unserializationTasks.push_back(
+          [this, &externalEvents, &externalEventElement]() {
+            externalEvents.UnserializeFrom(*this, externalEventElement);
+          });
   }
 
   externalLayouts.clear();
+  externalLayoutsToUnserialize.clear();
   const SerializerElement& externalLayoutsElement =
       element.GetChild("externalLayouts", 0, "ExternalLayouts");
   externalLayoutsElement.ConsiderAsArrayOf("externalLayout", "ExternalLayout");
@@ -882,11 +944,25 @@ void Project::UnserializeFrom(const SerializerElement& element) {
     const SerializerElement& externalLayoutElement =
         externalLayoutsElement.GetChild(i);
 
-    gd::ExternalLayout& newExternalLayout =
-        InsertNewExternalLayout("", GetExternalLayoutsCount());
-    newExternalLayout.UnserializeFrom(externalLayoutElement);
+    gd::ExternalLayout& newExternalLayout = InsertNewExternalLayout(
+        externalLayoutElement.GetStringAttribute("name", "", "Name"),
+        GetExternalLayoutsCount());
+    if (lazyUnserialization)
+      externalLayoutsToUnserialize[&newExternalLayout] =
+          externalLayoutsElement.GetSharedChild(i);
+    else
+      unserializationTasks.push_back(
+          [&newExternalLayout, &externalLayoutElement]() {
+            newExternalLayout.UnserializeFrom(externalLayoutElement);
+          });
   }
 
+  gd::ParallelFor(unserializationTasks.size(),
+                  unserializationThreadsCount,
+                  [&unserializationTasks](std::size_t i) {
+                    unserializationTasks[i]();
+                  });
+
   externalSourceFiles.clear();
   const SerializerElement& externalSourceFilesElement =
       element.GetChild("externalSourceFiles", 0, "ExternalSourceFiles");
@@ -901,6 +977,55 @@ void Project::UnserializeFrom(const SerializerElement& element) {
   }
 }
 
+template <class T>
+void Project::SerializeEntityTo(
+    const T& entity,
+    SerializerElement& parentElement,
+    const gd::String& childName,
+    std::unordered_map<const void*, std::shared_ptr<SerializerElement> >&
+        newSerializedElementsCache) const {
+  if (!incrementalSerialization) {
+    entity.SerializeTo(parentElement.AddChild(childName));
+    return;
+  }
+
+  auto it = serializedElementsCache.find(&entity);
+  std::shared_ptr<SerializerElement> entityElement;
+  if (!entity.IsDirty() && it != serializedElementsCache.end()) {
+    entityElement = it->second;
+  } else {
+    entityElement = std::make_shared<SerializerElement>();
+    entity.SerializeTo(*entityElement);
+  }
+
+  parentElement.AddSharedChild(childName, entityElement);
+  newSerializedElementsCache[&entity] = entityElement;
+  entity.SetDirty(false);
+}
+
+template <class T>
+void Project::SerializeLazyEntityTo(
+    const T& entity,
+    const std::unordered_map<const T*,
+                             std::shared_ptr<const gd::SerializerElement> >&
+        elementsToUnserialize,
+    SerializerElement& parentElement,
+    const gd::String& childName,
+    std::unordered_map<const void*, std::shared_ptr<SerializerElement> >&
+        newSerializedElementsCache) const {
+  auto it = elementsToUnserialize.find(&entity);
+  if (it == elementsToUnserialize.end()) {
+    SerializeEntityTo(
+        entity, parentElement, childName, newSerializedElementsCache);
+    return;
+  }
+
+  // The element is not modified by sharing it: it's copied if the parent
+  // element is then modified (see SerializerElement::AddSharedChild).
+  parentElement.AddSharedChild(
+      childName, std::const_pointer_cast<SerializerElement>(it->second));
+}
+
 void Project::SerializeTo(SerializerElement& element) const {
   SerializerElement& versionElement = element.AddChild("gdVersion");
   versionElement.SetAttribute("major", gd::VersionWrapper::Major());
@@ -994,7 +1119,11 @@ void Project::SerializeTo(SerializerElement& element) const {
   else
     std::cout << "ERROR: The project current platform is NULL.";
 
-  resourcesManager.SerializeTo(element.AddChild("resources"));
+  std::unordered_map<const void*, std::shared_ptr<SerializerElement> >
+      newSerializedElementsCache;
+
+  SerializeEntityTo(
+      resourcesManager, element, "resources", newSerializedElementsCache);
   SerializeObjectsTo(element.AddChild("objects"));
   SerializeFoldersTo(element.AddChild("objectsFolderStructure"));
   GetObjectGroups().SerializeTo(element.AddChild("objectsGroups"));
@@ -1003,29 +1132,41 @@ void Project::SerializeTo(SerializerElement& element) const {
   element.SetAttribute("firstLayout", firstLayout);
   gd::SerializerElement& layoutsElement = element.AddChild("layouts");
   layoutsElement.ConsiderAsArrayOf("layout");
-  for (std::size_t i = 0; i < GetLayoutsCount(); i++)
-    GetLayout(i).SerializeTo(layoutsElement.AddChild("layout"));
+  for (std::size_t i = 0; i < scenes.size(); i++)
+    SerializeLazyEntityTo(*scenes[i],
+                          layoutsToUnserialize,
+                          layoutsElement,
+                          "layout",
+                          newSerializedElementsCache);
 
   SerializerElement& externalEventsElement = element.AddChild("externalEvents");
   externalEventsElement.ConsiderAsArrayOf("externalEvents");
-  for (std::size_t i = 0; i < GetExternalEventsCount(); ++i)
-    GetExternalEvents(i).SerializeTo(
-        externalEventsElement.AddChild("externalEvents"));
+  for (std::size_t i = 0; i < externalEvents.size(); ++i)
+    SerializeLazyEntityTo(*externalEvents[i],
+                          externalEventsToUnserialize,
+                          externalEventsElement,
+                          "externalEvents",
+                          newSerializedElementsCache);
 
   SerializerElement& eventsFunctionsExtensionsElement =
       element.AddChild("eventsFunctionsExtensions");
   eventsFunctionsExtensionsElement.ConsiderAsArrayOf(
       "eventsFunctionsExtension");
   for (std::size_t i = 0; i < eventsFunctionsExtensions.size(); ++i)
-    eventsFunctionsExtensions[i]->SerializeTo(
-        eventsFunctionsExtensionsElement.AddChild("eventsFunctionsExtension"));
+    SerializeEntityTo(*eventsFunctionsExtensions[i],
+                      eventsFunctionsExtensionsElement,
+                      "eventsFunctionsExtension",
+                      newSerializedElementsCache);
 
   SerializerElement& externalLayoutsElement =
       element.AddChild("externalLayouts");
   externalLayoutsElement.ConsiderAsArrayOf("externalLayout");
   for (std::size_t i = 0; i < externalLayouts.size(); ++i)
-    externalLayouts[i]->SerializeTo(
-        externalLayoutsElement.AddChild("externalLayout"));
+    SerializeLazyEntityTo(*externalLayouts[i],
+                          externalLayoutsToUnserialize,
+                          externalLayoutsElement,
+                          "externalLayout",
+                          newSerializedElementsCache);
 
   SerializerElement& externalSourceFilesElement =
       element.AddChild("externalSourceFiles");
@@ -1033,6 +1174,9 @@ void Project::SerializeTo(SerializerElement& element) const {
   for (std::size_t i = 0; i < externalSourceFiles.size(); ++i)
     externalSourceFiles[i]->SerializeTo(
         externalSourceFilesElement.AddChild("sourceFile"));
+
+  // Only keep the elements of the entities still in the project.
+  serializedElementsCache.swap(newSerializedElementsCache);
 }
 
 bool Project::IsNameSafe(const gd::String& name) {
@@ -1122,6 +1266,42 @@ gd::SourceFile& Project::InsertNewSourceFile(const gd::String& name,
   return newlyInsertedSourceFile;
 }
 
+void Project::UnserializeLayoutIfNeeded(gd::Layout& layout) const {
+  if (layoutsToUnserialize.empty()) return;
+  auto it = layoutsToUnserialize.find(&layout);
+  if (it == layoutsToUnserialize.end()) return;
+
+  // Forget the element first, so that the layout is not unserialized again
+  // if it's accessed during its unserialization.
+  std::shared_ptr<const gd::SerializerElement> element = it->second;
+  layoutsToUnserialize.erase(it);
+
+  // Apart from the layout, the project is not modified by the unserialization.
+  layout.UnserializeFrom(const_cast<gd::Project&>(*this), *element);
+}
+
+void Project::UnserializeExternalEventsIfNeeded(
+    gd::ExternalEvents& events) const {
+  if (externalEventsToUnserialize.empty()) return;
+  auto it = externalEventsToUnserialize.find(&events);
+  if (it == externalEventsToUnserialize.end()) return;
+
+  std::shared_ptr<const gd::SerializerElement> element = it->second;
+  externalEventsToUnserialize.erase(it);
+  events.UnserializeFrom(const_cast<gd::Project&>(*this), *element);
+}
+
+void Project::UnserializeExternalLayoutIfNeeded(
+    gd::ExternalLayout& externalLayout) const {
+  if (externalLayoutsToUnserialize.empty()) return;
+  auto it = externalLayoutsToUnserialize.find(&externalLayout);
+  if (it == externalLayoutsToUnserialize.end()) return;
+
+  std::shared_ptr<const gd::SerializerElement> element = it->second;
+  externalLayoutsToUnserialize.erase(it);
+  externalLayout.UnserializeFrom(*element);
+}
+
 Project::Project(const Project& other) { Init(other); }
 
 Project& Project::operator=(const Project& other) {
@@ -1177,15 +1357,43 @@ void Project::Init(const gd::Project& game) {
 
   resourcesManager = game.resourcesManager;
 
-  initialObjects = gd::Clone(game.initialObjects);
+  CopyObjectsFrom(game);
 
   scenes = gd::Clone(game.scenes);
 
   externalEvents = gd::Clone(game.externalEvents);
 
   externalLayouts = gd::Clone(game.externalLayouts);
+
+  // Layouts not unserialized yet are unserialized from the same elements.
+  lazyUnserialization = game.lazyUnserialization;
+  unserializationThreadsCount = game.unserializationThreadsCount;
+  layoutsToUnserialize.clear();
+  for (std::size_t i = 0; i < scenes.size(); ++i) {
+    auto it = game.layoutsToUnserialize.find(game.scenes[i].get());
+    if (it != game.layoutsToUnserialize.end())
+      layoutsToUnserialize[scenes[i].get()] = it->second;
+  }
+  externalEventsToUnserialize.clear();
+  for (std::size_t i = 0; i < externalEvents.size(); ++i) {
+    auto it = game.externalEventsToUnserialize.find(
+        game.externalEvents[i].get());
+    if (it != game.externalEventsToUnserialize.end())
+      externalEventsToUnserialize[externalEvents[i].get()] = it->second;
+  }
+  externalLayoutsToUnserialize.clear();
+  for (std::size_t i = 0; i < externalLayouts.size(); ++i) {
+    auto it = game.externalLayoutsToUnserialize.find(
+        game.externalLayouts[i].get());
+    if (it != game.externalLayoutsToUnserialize.end())
+      externalLayoutsToUnserialize[externalLayouts[i].get()] = it->second;
+  }
   eventsFunctionsExtensions = gd::Clone(game.eventsFunctionsExtensions);
 
+  // Entities of the copy are new (so dirty): there is nothing to reuse.
+  incrementalSerialization = game.incrementalSerialization;
+  serializedElementsCache.clear();
+
   useExternalSourceFiles = game.useExternalSourceFiles;
 
   externalSourceFiles = gd::Clone(game.externalSourceFiles);
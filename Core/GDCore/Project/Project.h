@@ -7,6 +7,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "GDCore/Events/CodeGeneration/DiagnosticReport.h"
@@ -629,16 +630,115 @@ class GD_CORE_API Project : public ObjectsContainer {
 
   /**
    * \brief Unserialize the project from an element.
+   *
+   * \see SetLazyUnserializationEnabled
    */
   void UnserializeFrom(const SerializerElement& element);
 
+  /**
+   * \brief Set if the layouts, external events and external layouts must be
+   * unserialized lazily by UnserializeFrom.
+   *
+   * When enabled, UnserializeFrom only creates them (with their names) and
+   * keeps their elements: each of them is unserialized the first time it's
+   * accessed (using GetLayout, GetExternalEvents or GetExternalLayout). This
+   * makes opening a project proportional to the number of layouts instead of
+   * the size of the project.
+   *
+   * The elements of the layouts are shared with the element passed to
+   * UnserializeFrom (they are not copied). Modifying them through this element
+   * copies them first (see SerializerElement::AddSharedChild), so the layouts
+   * are unserialized from their original elements. Layouts not unserialized
+   * yet are written back as is by SerializeTo.
+   */
+  void SetLazyUnserializationEnabled(bool enable) {
+    lazyUnserialization = enable;
+  }
+
+  /**
+   * \brief Return true if the layouts, external events and external layouts
+   * are unserialized lazily.
+   *
+   * \see SetLazyUnserializationEnabled
+   */
+  bool IsLazyUnserializationEnabled() const { return lazyUnserialization; }
+
+  /**
+   * \brief Set the number of threads used by UnserializeFrom to unserialize
+   * the layouts, external events and external layouts (which are independent
+   * from each other). By default, only the calling thread is used.
+   *
+   * The project is the same whatever the number of threads.
+   *
+   * \note Threads are not used when compiled with Emscripten, or when lazy
+   * unserialization is enabled.
+   */
+  void SetUnserializationThreadsCount(std::size_t threadsCount) {
+    unserializationThreadsCount = threadsCount;
+  }
+
+  /**
+   * \brief Return the number of threads used by UnserializeFrom.
+   *
+   * \see SetUnserializationThreadsCount
+   */
+  std::size_t GetUnserializationThreadsCount() const {
+    return unserializationThreadsCount;
+  }
+
   /**
    * \brief Serialize the project.
    *
-   * "Dirty" flag is set to false when serialization is done.
+   * When incremental serialization is enabled, the "dirty" flags of the
+   * layouts, external events, external layouts, extensions and resources are
+   * set to false when serialization is done.
+   *
+   * \see SetIncrementalSerializationEnabled
    */
   void SerializeTo(SerializerElement& element) const;
 
+  /**
+   * \brief Set if SerializeTo must only serialize again the layouts, external
+   * events, external layouts, events functions extensions and resources that
+   * were modified since the last time the project was serialized.
+   *
+   * When enabled, the elements of the entities are kept after being
+   * serialized. The next time the project is serialized, the element of an
+   * entity which is not "dirty" is reused instead of serializing it again.
+   * This makes saving a large project proportional to the size of what was
+   * modified.
+   *
+   * An entity is marked as dirty when it's returned by a non-const accessor of
+   * the project (GetLayout, GetExternalEvents, GetExternalLayout,
+   * GetEventsFunctionsExtension or GetResourcesManager), as it can then be
+   * modified, and by its own modifiers and non-const accessors (including the
+   * ones of the objects of a layout, like GetObject or InsertNewObject). A
+   * new, copied or unserialized entity is always dirty.
+   *
+   * \warning An entity modified using a reference kept since the previous
+   * serialization (for example, an object of a layout obtained before it),
+   * must be marked with SetDirty.
+   *
+   * \note The elements of the entities are shared between the elements passed
+   * to the successive calls to SerializeTo. They are copied when modified
+   * through these elements (see SerializerElement::AddSharedChild), so
+   * modifying the result of a serialization does not change the next ones.
+   */
+  void SetIncrementalSerializationEnabled(bool enable) {
+    incrementalSerialization = enable;
+    if (!enable) serializedElementsCache.clear();
+  }
+
+  /**
+   * \brief Return true if SerializeTo only serializes again the entities that
+   * were modified.
+   *
+   * \see SetIncrementalSerializationEnabled
+   */
+  bool IsIncrementalSerializationEnabled() const {
+    return incrementalSerialization;
+  }
+
   /**
    * Get the major version of GDevelop used to save the project.
    */
@@ -959,7 +1059,10 @@ class GD_CORE_API Project : public ObjectsContainer {
    * \brief Provide access to the ResourceManager member containing the list of
    * the resources.
    */
-  ResourcesManager& GetResourcesManager() { return resourcesManager; }
+  ResourcesManager& GetResourcesManager() {
+    resourcesManager.SetDirty();
+    return resourcesManager;
+  }
 
   ///@}
 
@@ -1062,6 +1165,59 @@ class GD_CORE_API Project : public ObjectsContainer {
    */
   void Init(const gd::Project& project);
 
+  /**
+   * \brief Unserialize the layout if its unserialization was deferred (see
+   * SetLazyUnserializationEnabled).
+   */
+  void UnserializeLayoutIfNeeded(gd::Layout& layout) const;
+
+  /**
+   * \brief Unserialize the external events if their unserialization was
+   * deferred (see SetLazyUnserializationEnabled).
+   */
+  void UnserializeExternalEventsIfNeeded(
+      gd::ExternalEvents& externalEvents) const;
+
+  /**
+   * \brief Unserialize the external layout if its unserialization was
+   * deferred (see SetLazyUnserializationEnabled).
+   */
+  void UnserializeExternalLayoutIfNeeded(
+      gd::ExternalLayout& externalLayout) const;
+
+  /**
+   * \brief Serialize an entity of the project (a layout, external events...)
+   * in a new child of the parent element.
+   *
+   * When incremental serialization is enabled, the element serialized the
+   * previous time is reused if the entity is not dirty. The element is then
+   * stored in newSerializedElementsCache and the entity is marked as not
+   * dirty.
+   */
+  template <class T>
+  void SerializeEntityTo(
+      const T& entity,
+      SerializerElement& parentElement,
+      const gd::String& childName,
+      std::unordered_map<const void*, std::shared_ptr<SerializerElement> >&
+          newSerializedElementsCache) const;
+
+  /**
+   * \brief Serialize an entity which can be unserialized lazily (see
+   * SetLazyUnserializationEnabled). If it was not unserialized yet, its
+   * element is written back as is (it's shared, not copied).
+   */
+  template <class T>
+  void SerializeLazyEntityTo(
+      const T& entity,
+      const std::unordered_map<const T*,
+                               std::shared_ptr<const gd::SerializerElement> >&
+          elementsToUnserialize,
+      SerializerElement& parentElement,
+      const gd::String& childName,
+      std::unordered_map<const void*, std::shared_ptr<SerializerElement> >&
+          newSerializedElementsCache) const;
+
   gd::String name;            ///< Game name
   gd::String description;     ///< Game description
   gd::String version;         ///< Game version number (used for some exports)
@@ -1137,6 +1293,27 @@ class GD_CORE_API Project : public ObjectsContainer {
                                         ///< time the project was saved.
   mutable unsigned int gdBuildVersion;  ///< The GD build version used the last
                                         ///< time the project was saved.
+  bool lazyUnserialization;  ///< If true, layouts, external events and
+                             ///< external layouts are unserialized when
+                             ///< accessed for the first time.
+  std::size_t unserializationThreadsCount;  ///< Number of threads used to
+                                           ///< unserialize layouts.
+  mutable std::unordered_map<const gd::Layout*,
+                             std::shared_ptr<const gd::SerializerElement> >
+      layoutsToUnserialize;  ///< Elements of the layouts not unserialized yet.
+  mutable std::unordered_map<const gd::ExternalEvents*,
+                             std::shared_ptr<const gd::SerializerElement> >
+      externalEventsToUnserialize;  ///< Elements of the external events not
+                                    ///< unserialized yet.
+  mutable std::unordered_map<const gd::ExternalLayout*,
+                             std::shared_ptr<const gd::SerializerElement> >
+      externalLayoutsToUnserialize;  ///< Elements of the external layouts not
+                                     ///< unserialized yet.
+  bool incrementalSerialization;  ///< If true, entities which are not dirty
+                                  ///< are not serialized again.
+  mutable std::unordered_map<const void*, std::shared_ptr<SerializerElement> >
+      serializedElementsCache;  ///< The elements of the entities, as
+                                ///< serialized the last time.
 };
 
 }  // namespace gd
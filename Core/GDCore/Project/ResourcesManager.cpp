@@ -47,6 +47,7 @@ void ResourceFolder::Init(const ResourceFolder& other) {
 }
 
 void ResourcesManager::Init(const ResourcesManager& other) {
+  SetDirty();
   resources.clear();
   for (std::size_t i = 0; i < other.resources.size(); ++i) {
     resources.push_back(std::shared_ptr<Resource>(other.resources[i]->Clone()));
@@ -58,6 +59,7 @@ void ResourcesManager::Init(const ResourcesManager& other) {
 }
 
 Resource& ResourcesManager::GetResource(const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 0; i < resources.size(); ++i) {
     if (resources[i]->GetName() == name) return *resources[i];
   }
@@ -222,6 +224,7 @@ bool AudioResource::UpdateProperty(const gd::String& name,
 }
 
 bool ResourcesManager::AddResource(const gd::Resource& resource) {
+  SetDirty();
   if (HasResource(resource.GetName())) return false;
 
   std::shared_ptr<Resource> newResource =
@@ -235,6 +238,7 @@ bool ResourcesManager::AddResource(const gd::Resource& resource) {
 bool ResourcesManager::AddResource(const gd::String& name,
                                    const gd::String& filename,
                                    const gd::String& kind) {
+  SetDirty();
   if (HasResource(name)) return false;
 
   std::shared_ptr<Resource> res = CreateResource(kind);
@@ -318,10 +322,12 @@ bool ResourceFolder::MoveResourceDownInList(const gd::String& name) {
 }
 
 bool ResourcesManager::MoveResourceUpInList(const gd::String& name) {
+  SetDirty();
   return gd::MoveResourceUpInList(resources, name);
 }
 
 bool ResourcesManager::MoveResourceDownInList(const gd::String& name) {
+  SetDirty();
   return gd::MoveResourceDownInList(resources, name);
 }
 
@@ -335,6 +341,7 @@ std::size_t ResourcesManager::GetResourcePosition(
 
 void ResourcesManager::MoveResource(std::size_t oldIndex,
                                     std::size_t newIndex) {
+  SetDirty();
   if (oldIndex >= resources.size() || newIndex >= resources.size()) return;
 
   auto resource = resources[oldIndex];
@@ -343,6 +350,7 @@ void ResourcesManager::MoveResource(std::size_t oldIndex,
 }
 
 bool ResourcesManager::MoveFolderUpInList(const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 1; i < folders.size(); ++i) {
     if (folders[i].GetName() == name) {
       std::swap(folders[i], folders[i - 1]);
@@ -354,6 +362,7 @@ bool ResourcesManager::MoveFolderUpInList(const gd::String& name) {
 }
 
 bool ResourcesManager::MoveFolderDownInList(const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 0; i < folders.size() - 1; ++i) {
     if (folders[i].GetName() == name) {
       std::swap(folders[i], folders[i + 1]);
@@ -366,6 +375,7 @@ bool ResourcesManager::MoveFolderDownInList(const gd::String& name) {
 
 std::shared_ptr<gd::Resource> ResourcesManager::GetResourceSPtr(
     const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 0; i < resources.size(); ++i) {
     if (resources[i]->GetName() == name) return resources[i];
   }
@@ -391,6 +401,7 @@ const ResourceFolder& ResourcesManager::GetFolder(
 }
 
 ResourceFolder& ResourcesManager::GetFolder(const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 0; i < folders.size(); ++i) {
     if (folders[i].GetName() == name) return folders[i];
   }
@@ -399,6 +410,7 @@ ResourceFolder& ResourcesManager::GetFolder(const gd::String& name) {
 }
 
 void ResourcesManager::RemoveFolder(const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 0; i < folders.size();) {
     if (folders[i].GetName() == name) {
       folders.erase(folders.begin() + i);
@@ -408,6 +420,7 @@ void ResourcesManager::RemoveFolder(const gd::String& name) {
 }
 
 void ResourcesManager::CreateFolder(const gd::String& name) {
+  SetDirty();
   ResourceFolder newFolder;
   newFolder.SetName(name);
 
@@ -438,6 +451,7 @@ void ResourceFolder::AddResource(const gd::String& name,
 
 void ResourcesManager::RenameResource(const gd::String& oldName,
                                       const gd::String& newName) {
+  SetDirty();
   for (std::size_t i = 0; i < resources.size(); ++i) {
     if (resources[i]->GetName() == oldName) resources[i]->SetName(newName);
   }
@@ -454,6 +468,7 @@ void ResourceFolder::RemoveResource(const gd::String& name) {
 }
 
 void ResourcesManager::RemoveResource(const gd::String& name) {
+  SetDirty();
   for (std::size_t i = 0; i < resources.size();) {
     if (resources[i] != std::shared_ptr<Resource>() &&
         resources[i]->GetName() == name)
@@ -492,6 +507,7 @@ void ResourceFolder::SerializeTo(SerializerElement& element) const {
 }
 
 void ResourcesManager::UnserializeFrom(const SerializerElement& element) {
+  SetDirty();
   resources.clear();
   const SerializerElement& resourcesElement =
       element.GetChild("resources", 0, "Resources");
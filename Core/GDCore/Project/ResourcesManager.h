@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "GDCore/String.h"
+#include "GDCore/Tools/DirtyFlag.h"
 namespace gd {
 class Project;
 class ResourceFolder;
@@ -713,11 +714,26 @@ class GD_CORE_API ResourcesManager {
    */
   void UnserializeFrom(const SerializerElement& element);
 
+  /**
+   * \brief Mark the resources as modified (or not) since they were last
+   * serialized by gd::Project::SerializeTo.
+   *
+   * \see gd::Project::SetIncrementalSerializationEnabled
+   */
+  void SetDirty(bool dirty = true) const { dirtyFlag.SetDirty(dirty); }
+
+  /**
+   * \brief Return true if the resources were modified since they were last
+   * serialized by gd::Project::SerializeTo.
+   */
+  bool IsDirty() const { return dirtyFlag.IsDirty(); }
+
  private:
   void Init(const ResourcesManager& other);
 
   std::vector<std::shared_ptr<Resource> > resources;
   std::vector<ResourceFolder> folders;
+  mutable gd::DirtyFlag dirtyFlag;
 
   static ResourceFolder badFolder;
   static Resource badResource;
@@ -50,7 +50,8 @@ class GD_CORE_API Variable {
   /**
    * \brief Default constructor creating a variable with 0 as value.
    */
-  Variable() : value(0), type(Type::Number){};
+  Variable()
+      : folded(false), type(Type::Number), value(0), boolVal(false){};
   Variable(const Variable&);
   virtual ~Variable(){};
 
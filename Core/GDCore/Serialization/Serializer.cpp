@@ -6,17 +6,24 @@
 
 #include "GDCore/Serialization/Serializer.h"
 
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "GDCore/CommonTools.h"
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/IDE/FileWriteStream.h"
 #include "GDCore/Serialization/SerializerElement.h"
-#include "rapidjson/document.h"
-#include "rapidjson/prettywriter.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/memorystream.h"
 #include "rapidjson/rapidjson.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/writer.h"
 #if !defined(EMSCRIPTEN)
 #include "GDCore/TinyXml/tinyxml.h"
 #endif
@@ -30,9 +37,9 @@ void Serializer::ToXML(SerializerElement& element, TiXmlElement* xmlElement) {
   if (!xmlElement) return;
 
   if (element.IsValueUndefined()) {
-    const std::map<gd::String, SerializerValue>& attributes =
+    const SerializerElement::Attributes& attributes =
         element.GetAllAttributes();
-    for (std::map<gd::String, SerializerValue>::const_iterator it =
+    for (SerializerElement::Attributes::const_iterator it =
              attributes.begin();
          it != attributes.end();
          ++it) {
@@ -111,84 +118,233 @@ gd::String Serializer::ToEscapedXMLString(const gd::String& str) {
 }
 
 namespace {
-void RapidJsonValueToElement(const Value& value,
-                             gd::SerializerElement& element) {
-  if (value.IsBool()) {
-    element.SetBoolValue(value.GetBool());
-  } else if (value.IsNumber()) {
-    if (value.IsInt64())
-      element.SetIntValue(value.GetInt64());
-    else if (value.IsUint64())
-      element.SetIntValue(value.GetUint64());
-    else if (value.IsInt())
-      element.SetValue(value.GetInt());
-    else if (value.IsUint())
-      element.SetValue(value.GetUint());
-    else if (value.IsDouble())
-      element.SetValue(value.GetDouble());
-    else if (value.IsFloat())
-      element.SetValue(value.GetFloat());
-  } else if (value.IsString()) {
-    element.SetStringValue(value.GetString());
-  } else if (value.IsObject()) {
-    for (auto& m : value.GetObject()) {
-      RapidJsonValueToElement(m.value, element.AddChild(m.name.GetString()));
+/**
+ * \brief A rapidjson SAX handler building a gd::SerializerElement tree while
+ * the JSON is being read.
+ */
+class SerializerElementReaderHandler
+    : public BaseReaderHandler<UTF8<>, SerializerElementReaderHandler> {
+ public:
+  SerializerElementReaderHandler(gd::SerializerElement& rootElement_)
+      : rootElement(rootElement_){};
+
+  bool Null() {
+    NextElement();
+    return true;
+  }
+  bool Bool(bool b) {
+    NextElement().SetBoolValue(b);
+    return true;
+  }
+  bool Int(int i) {
+    NextElement().SetIntValue(i);
+    return true;
+  }
+  bool Uint(unsigned u) {
+    NextElement().SetIntValue(u);
+    return true;
+  }
+  bool Int64(int64_t i) {
+    NextElement().SetIntValue(i);
+    return true;
+  }
+  bool Uint64(uint64_t u) {
+    NextElement().SetIntValue(u);
+    return true;
+  }
+  bool Double(double d) {
+    NextElement().SetDoubleValue(d);
+    return true;
+  }
+  bool String(const char* str, SizeType length, bool copy) {
+    if (!copy) {
+      // Parsing in situ: the string is decoded in the source buffer, which
+      // is referenced without any copy.
+      NextElement().SetStringViewValue(str, length);
+      return true;
     }
-  } else if (value.IsArray()) {
+
+    gd::String value;
+    value.Raw().assign(str, length);
+    NextElement().SetStringValue(value);
+    return true;
+  }
+  bool StartObject() {
+    parents.push_back(&NextElement());
+    return true;
+  }
+  bool Key(const char* str, SizeType length, bool copy) {
+    key.Raw().assign(str, length);
+    return true;
+  }
+  bool EndObject(SizeType memberCount) {
+    parents.pop_back();
+    return true;
+  }
+  bool StartArray() {
+    gd::SerializerElement& element = NextElement();
     element.ConsiderAsArray();
-    for (auto& m : value.GetArray()) {
-      RapidJsonValueToElement(m, element.AddChild(""));
-    }
+    parents.push_back(&element);
+    return true;
+  }
+  bool EndArray(SizeType elementCount) {
+    parents.pop_back();
+    return true;
+  }
+
+ private:
+  /**
+   * \brief Return the element that must receive the value being read.
+   */
+  gd::SerializerElement& NextElement() {
+    if (parents.empty()) return rootElement;
+
+    gd::SerializerElement& parent = *parents.back();
+    return parent.AddChild(parent.ConsideredAsArray() ? emptyKey : key);
   }
+
+  gd::SerializerElement& rootElement;
+  std::vector<gd::SerializerElement*> parents;
+  gd::String key;
+  const gd::String emptyKey;
+};
+
+/**
+ * \brief A rapidjson input stream reading a file by chunks from a
+ * gd::AbstractFileSystem.
+ */
+class FileSystemReadStream {
+ public:
+  typedef char Ch;
+
+  FileSystemReadStream(gd::AbstractFileSystem& fs_,
+                       const gd::String& filename_)
+      : reader(fs_.OpenFileForReading(filename_)),
+        buffer(64 * 1024),
+        bufferSize(0),
+        current(0),
+        fileOffset(0),
+        bufferOffset(0) {
+    Read();
+  }
+
+  Ch Peek() const { return current < bufferSize ? buffer[current] : '\0'; }
+  Ch Take() {
+    Ch c = Peek();
+    if (current < bufferSize && ++current == bufferSize) Read();
+    return c;
+  }
+  size_t Tell() const { return bufferOffset + current; }
+
+  // Not implemented: only used for in-situ parsing.
+  Ch* PutBegin() {
+    RAPIDJSON_ASSERT(false);
+    return 0;
+  }
+  void Put(Ch) { RAPIDJSON_ASSERT(false); }
+  void Flush() { RAPIDJSON_ASSERT(false); }
+  size_t PutEnd(Ch*) {
+    RAPIDJSON_ASSERT(false);
+    return 0;
+  }
+
+ private:
+  void Read() {
+    bufferOffset = fileOffset;
+    bufferSize = reader->Read(buffer.data(), buffer.size());
+    fileOffset += bufferSize;
+    current = 0;
+  }
+
+  std::unique_ptr<gd::AbstractFileSystem::FileReader> reader;
+  std::vector<Ch> buffer;
+  std::size_t bufferSize;    ///< The number of valid bytes in the buffer.
+  std::size_t current;       ///< The position in the buffer.
+  std::size_t fileOffset;    ///< The position of the next chunk in the file.
+  std::size_t bufferOffset;  ///< The position of the buffer in the file.
+};
+
+template <unsigned parseFlags, typename InputStream>
+bool ParseJSON(gd::SerializerElement& element,
+               InputStream& stream,
+               gd::String& errorMessage) {
+  element = gd::SerializerElement();
+  SerializerElementReaderHandler handler(element);
+
+  // Iterative parsing avoids any stack overflow with deeply nested JSON.
+  Reader reader;
+  ParseResult result =
+      reader.Parse<kParseIterativeFlag | parseFlags>(stream, handler);
+  if (result.IsError()) {
+    errorMessage = gd::String(GetParseError_En(result.Code())) +
+                   " (at offset " + gd::String::From(result.Offset()) + ")";
+    element = gd::SerializerElement();
+    return false;
+  }
+
+  return true;
 }
 
-void ElementToRapidJson(const gd::SerializerElement& element,
-                        Value& value,
-                        Document::AllocatorType& allocator) {
-  if (!element.IsValueUndefined()) {
-    const SerializerValue& serializerValue = element.GetValue();
-    // TODO: use GetRaw to avoid conversions
-    if (serializerValue.IsBoolean())
-      value.SetBool(serializerValue.GetBool());
-    else if (serializerValue.IsDouble())
-      value.SetDouble(serializerValue.GetDouble());
-    else if (serializerValue.IsInt())
-      value.SetInt(serializerValue.GetInt());
-    else if (serializerValue.IsString()) {
-      // This does a copy of the string, and measure the string length.
-      value.SetString(serializerValue.GetRawString().c_str(), allocator);
-    }
-  } else if (element.ConsideredAsArray()) {
-    value.SetArray();
+/**
+ * \brief A rapidjson output stream appending to a std::string.
+ */
+class StringWriteStream {
+ public:
+  typedef char Ch;
+
+  StringWriteStream(std::string& str_) : str(str_){};
+
+  void Put(Ch c) { str.push_back(c); }
+  void Flush() {}
+
+ private:
+  std::string& str;
+};
+
+template <typename Writer>
+void WriteValue(const gd::SerializerValue& serializerValue, Writer& writer) {
+  if (serializerValue.IsBoolean())
+    writer.Bool(serializerValue.GetBool());
+  else if (serializerValue.IsDouble())
+    writer.Double(serializerValue.GetDouble());
+  else if (serializerValue.IsInt())
+    writer.Int(serializerValue.GetInt());
+  else if (serializerValue.IsString())
+    writer.String(serializerValue.GetRawStringData(),
+                  serializerValue.GetRawStringSize());
+  else
+    writer.Null();
+}
 
-    const auto& children = element.GetAllChildren();
-    value.Reserve(children.size(), allocator);
+template <typename Writer>
+void WriteKey(const gd::String& key, Writer& writer) {
+  writer.Key(key.Raw().data(), key.Raw().size());
+}
 
-    for (const auto& child : children) {
-      Value childValue;
-      ElementToRapidJson(*child.second, childValue, allocator);
-      value.PushBack(childValue, allocator);
+/**
+ * \brief Write the JSON of an element, directly from the element tree.
+ */
+template <typename Writer>
+void WriteElement(const gd::SerializerElement& element, Writer& writer) {
+  if (!element.IsValueUndefined()) {
+    WriteValue(element.GetValue(), writer);
+  } else if (element.ConsideredAsArray()) {
+    writer.StartArray();
+    for (const auto& child : element.GetAllChildren()) {
+      WriteElement(*child.second, writer);
     }
+    writer.EndArray();
   } else {
-    value.SetObject();
-
-    const auto& attributes = element.GetAllAttributes();
-    const auto& children = element.GetAllChildren();
-
-    for (const auto& attribute : attributes) {
-      Value name(attribute.first.c_str(),
-                 allocator);  // Copying the name is required.
-      Value childValue;
-      ElementToRapidJson(attribute.second, childValue, allocator);
-      value.AddMember(name, childValue, allocator);
+    writer.StartObject();
+    for (const auto& attribute : element.GetAllAttributes()) {
+      WriteKey(attribute.first, writer);
+      WriteValue(attribute.second, writer);
     }
-    for (const auto& child : children) {
-      Value name(child.first.c_str(),
-                 allocator);  // Copying the name is required.
-      Value childValue;
-      ElementToRapidJson(*child.second, childValue, allocator);
-      value.AddMember(name, childValue, allocator);
+    for (const auto& child : element.GetAllChildren()) {
+      WriteKey(child.first, writer);
+      WriteElement(*child.second, writer);
     }
+    writer.EndObject();
   }
 }
 }  // namespace
@@ -197,34 +353,449 @@ SerializerElement Serializer::FromJSON(const char* json) {
   SerializerElement element;
   size_t len = strlen(json);
   if (len != 0) {
-    Document document;
-
-    // In-situ parsing, decode strings directly in the source string. Source
-    // must be string.
-    char buffer[len + 1];
-    memcpy(buffer, json, len + 1);
-    if (document.ParseInsitu(buffer).HasParseError()) {
-      std::cout << "TODO: error while parsing" << std::endl;
-      return element;
+    gd::String errorMessage;
+    if (!FromJSON(element, json, len, errorMessage)) {
+      std::cout << "Error while parsing JSON: " << errorMessage << std::endl;
     }
-
-    RapidJsonValueToElement(document, element);
   }
 
   return element;
 }
 
+bool Serializer::FromJSON(SerializerElement& element,
+                          const char* json,
+                          std::size_t length,
+                          gd::String& errorMessage) {
+  MemoryStream stream(json, length);
+  return ParseJSON<kParseNoFlags>(element, stream, errorMessage);
+}
+
+bool Serializer::FromJSONInsitu(SerializerElement& element,
+                                char* json,
+                                gd::String& errorMessage) {
+  InsituStringStream stream(json);
+  return ParseJSON<kParseInsituFlag>(element, stream, errorMessage);
+}
+
+bool Serializer::FromJSONFile(SerializerElement& element,
+                              gd::AbstractFileSystem& fs,
+                              const gd::String& filename,
+                              gd::String& errorMessage) {
+  FileSystemReadStream stream(fs, filename);
+  return ParseJSON<kParseNoFlags>(element, stream, errorMessage);
+}
+
 gd::String Serializer::ToJSON(const SerializerElement& element) {
-  Document document;
-  Document::AllocatorType& allocator = document.GetAllocator();
+  gd::String json;
+  StringWriteStream stream(json.Raw());
+  Writer<StringWriteStream> writer(stream);
+  WriteElement(element, writer);
+
+  return json;
+}
+
+void Serializer::ToJSON(const SerializerElement& element,
+                        gd::FileWriteStream& stream) {
+  Writer<gd::FileWriteStream> writer(stream);
+  WriteElement(element, writer);
+}
+
+namespace {
+const char binaryMagic[4] = {'G', 'D', 'S', 'B'};
+const std::uint32_t binaryVersion = 1;
+const std::size_t binaryHeaderSize = 16;
+// Elements are read recursively: deeper snapshots are rejected, so that a
+// malformed or malicious snapshot can't overflow the stack (which is small in
+// WebAssembly).
+const std::size_t binaryMaxDepth = 512;
+
+enum BinaryElementFlags : std::uint8_t {
+  BinaryHasValue = 1,
+  BinaryIsArray = 2,
+  BinaryHasAttributes = 4,
+  BinaryHasChildren = 8,
+};
+
+enum BinaryValueType : std::uint8_t {
+  BinaryUnknown = 0,
+  BinaryBoolean = 1,
+  BinaryString = 2,
+  BinaryInt = 3,
+  BinaryDouble = 4,
+};
+}  // namespace
+
+/**
+ * \brief Write integers, doubles and strings in a buffer, in little endian,
+ * and intern the names of attributes and children.
+ */
+class Serializer::BinaryWriter {
+ public:
+  BinaryWriter() {}
+
+  void WriteUInt8(std::uint8_t value) { buffer.push_back(value); }
+
+  void WriteUInt32(std::uint32_t value) {
+    char bytes[4] = {static_cast<char>(value & 0xFF),
+                     static_cast<char>((value >> 8) & 0xFF),
+                     static_cast<char>((value >> 16) & 0xFF),
+                     static_cast<char>((value >> 24) & 0xFF)};
+    buffer.append(bytes, 4);
+  }
+
+  void WriteInt32(std::int32_t value) {
+    std::uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteUInt32(bits);
+  }
+
+  void WriteDouble(double value) {
+    std::uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteUInt32(static_cast<std::uint32_t>(bits & 0xFFFFFFFF));
+    WriteUInt32(static_cast<std::uint32_t>(bits >> 32));
+  }
+
+  void WriteString(const char* data, std::size_t size) {
+    WriteUInt32(static_cast<std::uint32_t>(size));
+    buffer.append(data, size);
+  }
+
+  void WriteValue(const SerializerValue& value) {
+    if (value.IsBoolean()) {
+      WriteUInt8(BinaryBoolean);
+      WriteUInt8(value.GetBool() ? 1 : 0);
+    } else if (value.IsInt()) {
+      WriteUInt8(BinaryInt);
+      WriteInt32(value.GetInt());
+    } else if (value.IsDouble()) {
+      WriteUInt8(BinaryDouble);
+      WriteDouble(value.GetDouble());
+    } else {
+      WriteUInt8(value.IsString() ? BinaryString : BinaryUnknown);
+      WriteString(value.GetRawStringData(), value.GetRawStringSize());
+    }
+  }
+
+  /**
+   * \brief Write the index of a name in the table of strings, adding it to
+   * the table if it's not already there.
+   */
+  void WriteName(const gd::String& name) {
+    auto it = namesIndices.find(name);
+    if (it == namesIndices.end()) {
+      it = namesIndices
+               .insert(std::make_pair(
+                   name, static_cast<std::uint32_t>(names.size())))
+               .first;
+      names.push_back(&it->first);
+    }
+
+    WriteUInt32(it->second);
+  }
+
+  /**
+   * \brief Overwrite an integer written previously at the given position.
+   */
+  void PatchUInt32(std::size_t position, std::uint32_t value) {
+    BinaryWriter patch;
+    patch.WriteUInt32(value);
+    buffer.replace(position, 4, patch.buffer);
+  }
+
+  /**
+   * \brief Write the table of strings, containing all the names written.
+   */
+  void WriteNamesTable() {
+    for (const gd::String* name : names)
+      WriteString(name->Raw().data(), name->Raw().size());
+  }
+
+  std::size_t GetNamesCount() const { return names.size(); }
+
+  std::string buffer;
+
+ private:
+  std::unordered_map<gd::String, std::uint32_t> namesIndices;
+  std::vector<const gd::String*> names;
+};
+
+/**
+ * \brief Read integers, doubles and strings written by a
+ * gd::Serializer::BinaryWriter, checking that the buffer is not overflowed.
+ */
+class Serializer::BinaryReader {
+ public:
+  BinaryReader(const char* data_, std::size_t size_)
+      : data(data_), size(size_), position(0){};
+
+  bool ReadUInt8(std::uint8_t& value) {
+    if (!CanRead(1)) return false;
+    value = static_cast<std::uint8_t>(data[position]);
+    position++;
+    return true;
+  }
+
+  bool ReadUInt32(std::uint32_t& value) {
+    if (!CanRead(4)) return false;
+    const unsigned char* bytes =
+        reinterpret_cast<const unsigned char*>(data + position);
+    value = static_cast<std::uint32_t>(bytes[0]) |
+            (static_cast<std::uint32_t>(bytes[1]) << 8) |
+            (static_cast<std::uint32_t>(bytes[2]) << 16) |
+            (static_cast<std::uint32_t>(bytes[3]) << 24);
+    position += 4;
+    return true;
+  }
+
+  bool ReadInt32(std::int32_t& value) {
+    std::uint32_t bits;
+    if (!ReadUInt32(bits)) return false;
+    memcpy(&value, &bits, sizeof(value));
+    return true;
+  }
+
+  bool ReadDouble(double& value) {
+    std::uint32_t low, high;
+    if (!ReadUInt32(low) || !ReadUInt32(high)) return false;
+    std::uint64_t bits = (static_cast<std::uint64_t>(high) << 32) | low;
+    memcpy(&value, &bits, sizeof(value));
+    return true;
+  }
+
+  bool ReadString(gd::String& value) {
+    std::uint32_t stringSize;
+    if (!ReadUInt32(stringSize) || !CanRead(stringSize)) return false;
+    value.Raw().assign(data + position, stringSize);
+    position += stringSize;
+    return true;
+  }
+
+  bool ReadValue(SerializerValue& value) {
+    std::uint8_t type;
+    if (!ReadUInt8(type)) return false;
+
+    if (type == BinaryBoolean) {
+      std::uint8_t boolean;
+      if (!ReadUInt8(boolean)) return false;
+      value.SetBool(boolean != 0);
+    } else if (type == BinaryInt) {
+      std::int32_t integer;
+      if (!ReadInt32(integer)) return false;
+      value.SetInt(integer);
+    } else if (type == BinaryDouble) {
+      double number;
+      if (!ReadDouble(number)) return false;
+      value.SetDouble(number);
+    } else if (type == BinaryString || type == BinaryUnknown) {
+      if (!ReadString(stringBuffer)) return false;
+      if (type == BinaryString)
+        value.SetString(stringBuffer);
+      else
+        value.Set(stringBuffer);
+    } else {
+      return Fail("unknown type of value");
+    }
+
+    return true;
+  }
+
+  /**
+   * \brief Read the index of a name and return the name from the table of
+   * strings.
+   */
+  bool ReadName(const gd::String*& name) {
+    std::uint32_t index;
+    if (!ReadUInt32(index)) return false;
+    if (index >= names.size()) return Fail("invalid index of name");
+
+    name = &names[index];
+    return true;
+  }
+
+  /**
+   * \brief Read a count of items, checking that it's not bigger than the
+   * remaining bytes (as each item uses at least one byte).
+   */
+  bool ReadCount(std::uint32_t& count) {
+    if (!ReadUInt32(count)) return false;
+    if (count > size - position) return Fail("invalid count of items");
+    return true;
+  }
+
+  bool Fail(const gd::String& error) {
+    if (errorMessage.empty())
+      errorMessage = error + " (at offset " + gd::String::From(position) + ")";
+    return false;
+  }
+
+  std::size_t GetPosition() const { return position; }
+  void SetPosition(std::size_t position_) { position = position_; }
+
+  std::vector<gd::String> names;
+  gd::String errorMessage;
+
+ private:
+  bool CanRead(std::size_t bytesCount) {
+    if (bytesCount > size - position) return Fail("unexpected end of data");
+    return true;
+  }
+
+  const char* data;
+  std::size_t size;
+  std::size_t position;
+  gd::String stringBuffer;  ///< Reused to avoid allocations.
+};
+
+void Serializer::WriteBinaryElement(const SerializerElement& element,
+                                    BinaryWriter& writer) {
+  writer.WriteUInt8((element.valueUndefined ? 0 : BinaryHasValue) |
+                    (element.isArray ? BinaryIsArray : 0) |
+                    (element.attributes.empty() ? 0 : BinaryHasAttributes) |
+                    (element.children.empty() ? 0 : BinaryHasChildren));
+  if (!element.valueUndefined) writer.WriteValue(element.elementValue);
+
+  if (!element.attributes.empty()) {
+    writer.WriteUInt32(static_cast<std::uint32_t>(element.attributes.size()));
+    for (const auto& attribute : element.attributes) {
+      writer.WriteName(attribute.first);
+      writer.WriteValue(attribute.second);
+    }
+  }
+
+  if (!element.children.empty()) {
+    writer.WriteUInt32(static_cast<std::uint32_t>(element.children.size()));
+    for (const auto& child : element.children) {
+      writer.WriteName(child.first);
+      WriteBinaryElement(*child.second, writer);
+    }
+  }
+
+  if (element.isArray) {
+    writer.WriteName(element.arrayOf);
+    writer.WriteName(element.deprecatedArrayOf);
+  }
+}
+
+bool Serializer::ReadBinaryElement(SerializerElement& element,
+                                   BinaryReader& reader,
+                                   std::size_t depth) {
+  if (depth > binaryMaxDepth) return reader.Fail("too deeply nested elements");
 
-  ElementToRapidJson(element, document, allocator);
+  std::uint8_t flags;
+  if (!reader.ReadUInt8(flags)) return false;
+  if (flags & BinaryHasValue) {
+    element.valueUndefined = false;
+    if (!reader.ReadValue(element.elementValue)) return false;
+  }
+
+  std::uint32_t attributesCount = 0;
+  if ((flags & BinaryHasAttributes) && !reader.ReadCount(attributesCount))
+    return false;
+  for (std::uint32_t i = 0; i < attributesCount; ++i) {
+    const gd::String* name = nullptr;
+    if (!reader.ReadName(name)) return false;
+    if (!reader.ReadValue(element.attributes[*name])) return false;
+  }
 
-  StringBuffer buffer;
-  Writer<StringBuffer> writer(buffer);
-  document.Accept(writer);
+  // Children are added directly (instead of using AddChild) to keep their
+  // names and order, even if they don't match the name of the array
+  // elements.
+  std::uint32_t childrenCount = 0;
+  if ((flags & BinaryHasChildren) && !reader.ReadCount(childrenCount))
+    return false;
+  element.children.reserve(childrenCount);
+  for (std::uint32_t i = 0; i < childrenCount; ++i) {
+    const gd::String* name = nullptr;
+    if (!reader.ReadName(name)) return false;
+
+    std::shared_ptr<SerializerElement> child = element.CreateElement();
+    element.children.push_back(std::make_pair(*name, child));
+    if (!ReadBinaryElement(*child, reader, depth + 1)) return false;
+  }
+  element.InvalidateChildrenIndex();
+
+  if (flags & BinaryIsArray) {
+    const gd::String* arrayOf = nullptr;
+    const gd::String* deprecatedArrayOf = nullptr;
+    if (!reader.ReadName(arrayOf) || !reader.ReadName(deprecatedArrayOf))
+      return false;
+
+    element.isArray = true;
+    element.arrayOf = *arrayOf;
+    element.deprecatedArrayOf = *deprecatedArrayOf;
+  }
+
+  return true;
+}
+
+std::string Serializer::ToBinary(const SerializerElement& element) {
+  BinaryWriter writer;
+  writer.buffer.append(binaryMagic, sizeof(binaryMagic));
+  writer.WriteUInt32(binaryVersion);
+  writer.WriteUInt32(0);  // Offset of the table of strings, patched below.
+  writer.WriteUInt32(0);  // Number of strings, patched below.
+
+  WriteBinaryElement(element, writer);
+
+  writer.PatchUInt32(8, static_cast<std::uint32_t>(writer.buffer.size()));
+  writer.PatchUInt32(12, static_cast<std::uint32_t>(writer.GetNamesCount()));
+  writer.WriteNamesTable();
+
+  return std::move(writer.buffer);
+}
+
+bool Serializer::FromBinary(SerializerElement& element,
+                            const char* data,
+                            std::size_t size,
+                            gd::String& errorMessage) {
+  element = gd::SerializerElement();
+
+  BinaryReader reader(data, size);
+  std::uint32_t version = 0, namesOffset = 0, namesCount = 0;
+  if (size < binaryHeaderSize ||
+      memcmp(data, binaryMagic, sizeof(binaryMagic)) != 0) {
+    errorMessage = "Not a binary snapshot";
+    return false;
+  }
+  reader.SetPosition(sizeof(binaryMagic));
+  reader.ReadUInt32(version);
+  reader.ReadUInt32(namesOffset);
+  reader.ReadUInt32(namesCount);
+  if (version != binaryVersion) {
+    errorMessage = "Unsupported version of binary snapshot (" +
+                   gd::String::From(version) + ")";
+    return false;
+  }
+
+  // Read the table of strings first, as the names of attributes and children
+  // are referencing it.
+  // Each string uses at least 4 bytes (its size).
+  bool success = namesOffset >= binaryHeaderSize && namesOffset <= size &&
+                 namesCount <= (size - namesOffset) / 4;
+  if (success) {
+    reader.SetPosition(namesOffset);
+    reader.names.resize(namesCount);
+    for (std::uint32_t i = 0; i < namesCount && success; ++i)
+      success = reader.ReadString(reader.names[i]);
+  } else {
+    reader.Fail("invalid table of strings");
+  }
+
+  if (success) {
+    reader.SetPosition(binaryHeaderSize);
+    success = ReadBinaryElement(element, reader, 0);
+    if (success && reader.GetPosition() != namesOffset)
+      success = reader.Fail("unexpected data after the root element");
+  }
+
+  if (!success) {
+    errorMessage = reader.errorMessage;
+    element = gd::SerializerElement();
+    return false;
+  }
 
-  return buffer.GetString();  // Temporary copy
+  return true;
 }
 
 }  // namespace gd
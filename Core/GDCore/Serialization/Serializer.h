@@ -6,9 +6,14 @@
 
 #ifndef GDCORE_SERIALIZER_H
 #define GDCORE_SERIALIZER_H
+#include <cstddef>
 #include <string>
 #include "GDCore/Serialization/SerializerElement.h"
 class TiXmlElement;
+namespace gd {
+class AbstractFileSystem;
+class FileWriteStream;
+}
 
 namespace gd {
 
@@ -44,8 +49,23 @@ class GD_CORE_API Serializer {
    */
   static gd::String ToJSON(const SerializerElement& element);
 
+  /**
+   * \brief Serialize a gd::SerializerElement to JSON, written in a
+   * file by chunks.
+   *
+   * The JSON is written while the element tree is walked: it is never
+   * entirely stored in memory (unless the file system does not support
+   * writing a file by chunks, see
+   * gd::AbstractFileSystem::OpenFileForWriting).
+   */
+  static void ToJSON(const SerializerElement& element,
+                     gd::FileWriteStream& stream);
+
   /**
    * \brief Construct a gd::SerializerElement from a JSON string.
+   *
+   * \note If the JSON is invalid, the error is logged and an empty element is
+   * returned.
    */
   static SerializerElement FromJSON(const char* json);
 
@@ -55,12 +75,131 @@ class GD_CORE_API Serializer {
   static SerializerElement FromJSON(const gd::String& json) {
     return FromJSON(json.c_str());
   }
+
+  /**
+   * \brief Fill a gd::SerializerElement from a JSON buffer.
+   *
+   * The element tree is built in a single pass while the JSON is read: no
+   * copy of the buffer and no intermediate JSON document are made.
+   *
+   * \param element The element to fill. It is reset if parsing fails.
+   * \param json The JSON to parse (does not need to be null terminated).
+   * \param length The size of the JSON, in bytes.
+   * \param errorMessage Set to a description of the error (and its offset) if
+   * parsing fails.
+   * \return true if the JSON was parsed successfully.
+   */
+  static bool FromJSON(SerializerElement& element,
+                       const char* json,
+                       std::size_t length,
+                       gd::String& errorMessage);
+
+  /**
+   * \brief Fill a gd::SerializerElement from a JSON buffer, parsed in situ:
+   * strings are decoded directly in the buffer and the string values of the
+   * elements reference it, without any copy.
+   *
+   * \warning The buffer is modified, and must stay valid as long as the
+   * element (or any of its children) is used. Copies of the element don't
+   * reference the buffer.
+   *
+   * \param element The element to fill. It is reset if parsing fails.
+   * \param json The null terminated JSON to parse.
+   * \param errorMessage Set to a description of the error (and its offset) if
+   * parsing fails.
+   * \return true if the JSON was parsed successfully.
+   */
+  static bool FromJSONInsitu(SerializerElement& element,
+                             char* json,
+                             gd::String& errorMessage);
+
+  /**
+   * \brief Fill a gd::SerializerElement from a JSON file, read by chunks
+   * from the file system (see gd::AbstractFileSystem::OpenFileForReading).
+   *
+   * \see gd::Serializer::FromJSON
+   * \return true if the file was parsed successfully.
+   */
+  static bool FromJSONFile(SerializerElement& element,
+                           gd::AbstractFileSystem& fs,
+                           const gd::String& filename,
+                           gd::String& errorMessage);
+  ///@}
+
+  /** \name Binary serialization.
+   * Convert a gd::SerializerElement from/to a compact binary snapshot.
+   *
+   * The snapshot is faster to read and write than JSON: numbers and booleans
+   * are stored in their native representation and the names of attributes and
+   * children are stored once, in a table of strings.
+   * It is meant to be used as a cache alongside the JSON files (which stay the
+   * reference format): it is versioned and must be discarded if it can't be
+   * read.
+   *
+   * Layout (all integers are little endian, without any alignment):
+   * - Header: "GDSB" magic, uint32 version, uint32 offset of the table of
+   * strings, uint32 number of strings.
+   * - The root element: uint8 flags (1: has a value, 2: is an array, 4: has
+   * attributes, 8: has children), the value (if any), uint32 number of
+   * attributes followed by the attributes (uint32 name, value), uint32 number
+   * of children followed by the children (uint32 name, element) and, for
+   * arrays, uint32 arrayOf name and uint32 deprecated arrayOf name. Names are
+   * indices in the table of strings.
+   * - A value: uint8 type (0: unknown, 1: boolean, 2: string, 3: int, 4:
+   * double) followed by an uint8, an uint32 size and the UTF8 string, an int32
+   * or a 64 bits IEEE 754 double.
+   * - The table of strings: for each string, uint32 size and the UTF8 string.
+   */
+  ///@{
+  /**
+   * \brief Serialize a gd::SerializerElement to a binary snapshot.
+   */
+  static std::string ToBinary(const SerializerElement& element);
+
+  /**
+   * \brief Fill a gd::SerializerElement from a binary snapshot.
+   *
+   * The buffer is only read (it can be a memory mapped file) and can be
+   * released after the call: strings are copied in the elements.
+   *
+   * \param element The element to fill. It is reset if reading fails.
+   * \param data The binary snapshot, as returned by ToBinary.
+   * \param size The size of the snapshot, in bytes.
+   * \param errorMessage Set to a description of the error if the snapshot
+   * is invalid (or was written by an incompatible version, or has more than
+   * 512 levels of nested elements).
+   * \return true if the snapshot was read successfully.
+   */
+  static bool FromBinary(SerializerElement& element,
+                         const char* data,
+                         std::size_t size,
+                         gd::String& errorMessage);
+
+  /**
+   * \brief Fill a gd::SerializerElement from a binary snapshot.
+   *
+   * \see gd::Serializer::FromBinary
+   */
+  static bool FromBinary(SerializerElement& element,
+                         const std::string& binary,
+                         gd::String& errorMessage) {
+    return FromBinary(element, binary.data(), binary.size(), errorMessage);
+  }
   ///@}
 
   virtual ~Serializer(){};
 
  private:
   Serializer(){};
+
+  class BinaryWriter;
+  class BinaryReader;
+
+  static void WriteBinaryElement(const SerializerElement& element,
+                                 BinaryWriter& writer);
+  static bool ReadBinaryElement(SerializerElement& element,
+                                BinaryReader& reader,
+                                std::size_t depth);
 };
 
 }  // namespace gd
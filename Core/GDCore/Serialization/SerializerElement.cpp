@@ -1,15 +1,31 @@
 #include "GDCore/Serialization/SerializerElement.h"
 
+#include <cstring>
 #include <iostream>
 
+#include "GDCore/Tools/Arena.h"
+
 namespace gd {
 
-SerializerElement SerializerElement::nullElement;
+SerializerElement& SerializerElement::GetNullElement() {
+  static thread_local SerializerElement nullElement;
+  return nullElement;
+}
 
-SerializerElement::SerializerElement() : valueUndefined(true), isArray(false) {}
+SerializerElement::SerializerElement()
+    : valueUndefined(true), isArray(false), arena(nullptr) {}
 
 SerializerElement::SerializerElement(const SerializerValue& value)
-    : valueUndefined(false), elementValue(value), isArray(false) {}
+    : valueUndefined(false),
+      elementValue(value),
+      isArray(false),
+      arena(nullptr) {}
+
+SerializerElement::SerializerElement(gd::Arena& arena_)
+    : valueUndefined(true),
+      attributes(Attributes::allocator_type(&arena_)),
+      isArray(false),
+      arena(&arena_) {}
 
 SerializerElement::~SerializerElement() {}
 
@@ -36,7 +52,7 @@ SerializerElement& SerializerElement::SetAttribute(const gd::String& name,
                       // support code using attributes. Make sure that any
                       // existing child with this name is removed (otherwise it
                       // would erase the attribute at serialization).
-  attributes[name].SetString(value);
+  SetString(attributes[name], value);
   return *this;
 }
 
@@ -159,41 +175,97 @@ SerializerElement& SerializerElement::AddChild(gd::String name) {
     return GetChild(name);
   }
 
-  std::shared_ptr<SerializerElement> newElement(new SerializerElement);
+  std::shared_ptr<SerializerElement> newElement = CreateElement();
   children.push_back(std::make_pair(name, newElement));
+  InvalidateChildrenIndex();
 
   return *newElement;
 }
 
+void SerializerElement::AddSharedChild(
+    gd::String name, std::shared_ptr<SerializerElement> child) {
+  if (isArray) {
+    if (name != arrayOf) {
+      std::cout << "WARNING: Adding a child, to a SerializerElement which is "
+                   "considered as an array, with a name ("
+                << name << ") which is not the same as the array elements ("
+                << arrayOf << "). Child was renamed." << std::endl;
+      name = arrayOf;
+    }
+  } else {
+    for (auto& existingChild : children) {
+      if (existingChild.first == name) {
+        existingChild.second = child;
+        return;
+      }
+    }
+  }
+
+  children.push_back(std::make_pair(name, child));
+  InvalidateChildrenIndex();
+}
+
 SerializerElement& SerializerElement::GetChild(std::size_t index) const {
+  std::size_t position = GetChildPosition(index);
+  if (position >= children.size()) return GetNullElement();
+
+  return *children[position].second;
+}
+
+SerializerElement& SerializerElement::GetChild(std::size_t index) {
+  std::size_t position = GetChildPosition(index);
+  if (position >= children.size()) return GetNullElement();
+
+  return GetUnsharedChild(position);
+}
+
+std::size_t SerializerElement::GetChildPosition(std::size_t index) const {
   if (!isArray) {
     std::cout << "ERROR: Getting a child from its index whereas the parent is "
                  "not considered as an array."
               << std::endl;
-    return nullElement;
+    return children.size();
   }
 
-  std::size_t currentIndex = 0;
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == arrayOf || children[i].first.empty() ||
-        (!deprecatedArrayOf.empty() &&
-         children[i].first == deprecatedArrayOf)) {
-      if (index == currentIndex)
-        return *children[i].second;
-      else
-        currentIndex++;
-    }
-  }
+  const std::vector<std::size_t>& positions =
+      GetChildrenIndex(arrayOf, deprecatedArrayOf);
+  if (index < positions.size()) return positions[index];
 
   std::cout << "ERROR: Requested out of bound child at index " << index
             << std::endl;
-  return nullElement;
+  return children.size();
+}
+
+std::shared_ptr<SerializerElement> SerializerElement::GetSharedChild(
+    std::size_t index) const {
+  if (!isArray) return nullptr;
+
+  const std::vector<std::size_t>& positions =
+      GetChildrenIndex(arrayOf, deprecatedArrayOf);
+  if (index < positions.size()) return children[positions[index]].second;
+
+  return nullptr;
 }
 
 SerializerElement& SerializerElement::GetChild(
     gd::String name, std::size_t index, gd::String deprecatedName) const {
+  std::size_t position = GetChildPosition(name, index, deprecatedName);
+  if (position >= children.size()) return GetNullElement();
+
+  return *children[position].second;
+}
+
+SerializerElement& SerializerElement::GetChild(gd::String name,
+                                               std::size_t index,
+                                               gd::String deprecatedName) {
+  std::size_t position = GetChildPosition(name, index, deprecatedName);
+  if (position >= children.size()) return GetNullElement();
+
+  return GetUnsharedChild(position);
+}
+
+std::size_t SerializerElement::GetChildPosition(
+    gd::String name, std::size_t index, gd::String deprecatedName) const {
   if (isArray) {
     if (name != arrayOf) {
       std::cout << "WARNING: Getting a child, from a SerializerElement which "
@@ -204,22 +276,40 @@ SerializerElement& SerializerElement::GetChild(
     }
   }
 
-  std::size_t currentIndex = 0;
-  for (size_t i = 0; i < children.size(); ++i) {
-    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
-
-    if (children[i].first == name || (isArray && children[i].first.empty()) ||
-        (!deprecatedName.empty() && children[i].first == deprecatedName)) {
-      if (index == currentIndex)
-        return *children[i].second;
-      else
-        currentIndex++;
+  if (isArray) {
+    const std::vector<std::size_t>& positions =
+        GetChildrenIndex(name, deprecatedName);
+    if (index < positions.size()) return positions[index];
+  } else {
+    std::size_t currentIndex = 0;
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
+
+      if (children[i].first == name ||
+          (!deprecatedName.empty() && children[i].first == deprecatedName)) {
+        if (index == currentIndex)
+          return i;
+        else
+          currentIndex++;
+      }
     }
   }
 
   std::cout << "Child " << name << " not found in SerializerElement::GetChild"
             << std::endl;
-  return nullElement;
+  return children.size();
+}
+
+SerializerElement& SerializerElement::GetUnsharedChild(std::size_t position) {
+  std::shared_ptr<SerializerElement>& child = children[position].second;
+  if (child.use_count() > 1) {
+    // Other elements still use the shared child: they keep it unchanged.
+    std::shared_ptr<SerializerElement> copiedChild = CreateElement();
+    *copiedChild = *child;
+    child = copiedChild;
+  }
+
+  return *child;
 }
 
 std::size_t SerializerElement::GetChildrenCount(
@@ -237,11 +327,13 @@ std::size_t SerializerElement::GetChildrenCount(
     deprecatedName = deprecatedArrayOf;
   }
 
+  if (isArray) return GetChildrenIndex(name, deprecatedName).size();
+
   std::size_t currentIndex = 0;
   for (size_t i = 0; i < children.size(); ++i) {
     if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
 
-    if (children[i].first == name || (isArray && children[i].first.empty()) ||
+    if (children[i].first == name ||
         (!deprecatedName.empty() && children[i].first == deprecatedName))
       currentIndex++;
   }
@@ -249,6 +341,29 @@ std::size_t SerializerElement::GetChildrenCount(
   return currentIndex;
 }
 
+const std::vector<std::size_t>& SerializerElement::GetChildrenIndex(
+    const gd::String& name, const gd::String& deprecatedName) const {
+  if (!childrenIndex) childrenIndex.reset(new ChildrenIndex);
+
+  for (const auto& childrenPositions : *childrenIndex) {
+    if (childrenPositions.name == name &&
+        childrenPositions.deprecatedName == deprecatedName)
+      return childrenPositions.positions;
+  }
+
+  childrenIndex->push_back(ChildrenPositions{name, deprecatedName, {}});
+  std::vector<std::size_t>& positions = childrenIndex->back().positions;
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (children[i].second == std::shared_ptr<SerializerElement>()) continue;
+
+    if (children[i].first == name || children[i].first.empty() ||
+        (!deprecatedName.empty() && children[i].first == deprecatedName))
+      positions.push_back(i);
+  }
+
+  return positions;
+}
+
 bool SerializerElement::HasChild(const gd::String& name,
                                  gd::String deprecatedName) const {
   for (size_t i = 0; i < children.size(); ++i) {
@@ -264,9 +379,10 @@ bool SerializerElement::HasChild(const gd::String& name,
 
 void SerializerElement::RemoveChild(const gd::String& name) {
   for (size_t i = 0; i < children.size();) {
-    if (children[i].first == name)
+    if (children[i].first == name) {
       children.erase(children.begin() + i);
-    else
+      InvalidateChildrenIndex();
+    } else
       ++i;
   }
 }
@@ -274,19 +390,71 @@ void SerializerElement::RemoveChild(const gd::String& name) {
 void SerializerElement::Init(const gd::SerializerElement& other) {
   valueUndefined = other.valueUndefined;
   elementValue = other.elementValue;
-  attributes = other.attributes;
+  if (arena && elementValue.IsString())
+    SetString(elementValue,
+              other.elementValue.GetRawStringData(),
+              other.elementValue.GetRawStringSize());
+
+  // Attributes are allocated from the arena of this element, if any (and so
+  // are their strings).
+  attributes.clear();
+  for (const auto& attribute : other.attributes) {
+    SerializerValue& value = attributes[attribute.first];
+    if (arena && attribute.second.IsString())
+      SetString(value,
+                attribute.second.GetRawStringData(),
+                attribute.second.GetRawStringSize());
+    else
+      value = attribute.second;
+  }
 
+  // Note that the arena is not copied: children are copied in the arena of
+  // this element, if any.
   children.clear();
   for (const auto& child : other.children) {
-    children.push_back(
-        std::make_pair(child.first,
-                       std::shared_ptr<SerializerElement>(
-                           new SerializerElement(*child.second))));
+    std::shared_ptr<SerializerElement> newElement = CreateElement();
+    *newElement = *child.second;
+    children.push_back(std::make_pair(child.first, newElement));
   }
 
   isArray = other.isArray;
   arrayOf = other.arrayOf;
   deprecatedArrayOf = other.deprecatedArrayOf;
+  InvalidateChildrenIndex();
+}
+
+std::shared_ptr<SerializerElement> SerializerElement::CreateElement() const {
+  if (!arena) return std::make_shared<SerializerElement>();
+
+  // The element and its shared_ptr control block are allocated together from
+  // the arena.
+  return std::allocate_shared<SerializerElement>(
+      gd::ArenaAllocator<SerializerElement>(arena), *arena);
+}
+
+void SerializerElement::SetString(SerializerValue& value,
+                                  const gd::String& string) const {
+  if (!arena) {
+    value.SetString(string);
+    return;
+  }
+
+  SetString(value, string.Raw().data(), string.Raw().size());
+}
+
+void SerializerElement::SetString(SerializerValue& value,
+                                  const char* data,
+                                  std::size_t size) const {
+  if (!arena) {
+    gd::String string;
+    string.Raw().assign(data, size);
+    value.SetString(string);
+    return;
+  }
+
+  char* arenaData = static_cast<char*>(arena->Allocate(size, 1));
+  std::memcpy(arenaData, data, size);
+  value.SetStringView(arenaData, size);
 }
 
 void SerializerElement::SetMultilineStringValue(const gd::String& value) {
@@ -297,6 +465,7 @@ void SerializerElement::SetMultilineStringValue(const gd::String& value) {
 
   std::vector<gd::String> lines = value.Split('\n');
   children.clear();
+  InvalidateChildrenIndex();
   ConsiderAsArrayOf("");
   for (const auto& line : lines) {
     AddChild("").SetStringValue(line);
@@ -13,6 +13,7 @@
 
 #include "GDCore/Serialization/SerializerValue.h"
 #include "GDCore/String.h"
+#include "GDCore/Tools/Arena.h"
 
 namespace gd {
 
@@ -29,13 +30,37 @@ namespace gd {
  * converted to a JavaScript object.
  *
  * \note Children are stored with their order preserved, but this also
- * means that their access/removal is O(number of children). This class
+ * means that their access by name/removal is O(number of children). This class
  * is not appropriated for a use in game where fast access is required.
  *
+ * \note Accessing the children of an array (GetChild(index),
+ * GetChildrenCount) uses an index of the positions of the children, built at
+ * the first access for each requested name and kept until the children are
+ * modified. Iterating over the children of an array is then linear in the
+ * number of children. Elements which are not arrays don't have an index (their
+ * children are searched). As this index is updated by const methods, an
+ * element must not be read from multiple threads at the same time (but
+ * different children can be read by different threads).
+ *
+ * \note Children can be shared by several elements (see AddSharedChild and
+ * GetSharedChild). They are copied on write: a shared child returned by the
+ * non-const GetChild methods is first replaced by a copy, so that modifying it
+ * does not modify the other elements sharing it.
+ *
  * \see gd::Serializer
  */
 class GD_CORE_API SerializerElement {
  public:
+  /**
+   * \brief The attributes of an element, allocated from the arena of the
+   * element (if any).
+   */
+  typedef std::map<gd::String,
+                   SerializerValue,
+                   std::less<gd::String>,
+                   gd::ArenaAllocator<std::pair<const gd::String, SerializerValue> > >
+      Attributes;
+
   /**
    * \brief Create an empty element with no value, no children and no
    * attributes.
@@ -47,10 +72,29 @@ class GD_CORE_API SerializerElement {
    */
   SerializerElement(const SerializerValue &value);
 
+  /**
+   * \brief Create an empty element whose descendants, attributes and string
+   * values are all allocated from the specified arena.
+   *
+   * This avoids a lot of small allocations when serializing a large tree (like
+   * a whole project).
+   *
+   * \warning The arena is not owned by the element: it must outlive the
+   * element and all its descendants (including the children shared with
+   * GetSharedChild).
+   *
+   * \note Copying an element (to or from an element using an arena) makes
+   * a deep copy: the copied children are allocated from the arena of
+   * the destination element, if any.
+   */
+  explicit SerializerElement(gd::Arena &arena);
+
   /**
    * Copy constructor.
    */
-  SerializerElement(const gd::SerializerElement &object) { Init(object); };
+  SerializerElement(const gd::SerializerElement &object) : arena(nullptr) {
+    Init(object);
+  };
 
   /**
    * Assignment operator.
@@ -92,7 +136,7 @@ class GD_CORE_API SerializerElement {
    */
   void SetValue(const gd::String &val) {
     valueUndefined = false;
-    elementValue.SetString(val);
+    SetString(elementValue, val);
   }
 
   /**
@@ -100,6 +144,17 @@ class GD_CORE_API SerializerElement {
    */
   void SetStringValue(const gd::String &val) { SetValue(val); }
 
+  /**
+   * \brief Set the value of the element, as a string referencing an external
+   * buffer (without copying it).
+   *
+   * \see gd::SerializerValue::SetStringView
+   */
+  void SetStringViewValue(const char *data, std::size_t size) {
+    valueUndefined = false;
+    elementValue.SetStringView(data, size);
+  }
+
   /**
    * \brief Set the value of the element, as an integer.
    */
@@ -331,7 +386,7 @@ class GD_CORE_API SerializerElement {
   /**
    * \brief Return all the attributes of the element.
    */
-  const std::map<gd::String, SerializerValue> &GetAllAttributes() const {
+  const Attributes &GetAllAttributes() const {
     return attributes;
   };
   ///@}
@@ -347,7 +402,10 @@ class GD_CORE_API SerializerElement {
    * When serialized to a format accepting arrays (like JSON), the element will
    * be serialized to an array.
    */
-  void ConsiderAsArray() const { isArray = true; };
+  void ConsiderAsArray() const {
+    if (!isArray) InvalidateChildrenIndex();
+    isArray = true;
+  };
 
   /**
    * \brief Check if the element is considered as an array containing its
@@ -391,9 +449,32 @@ class GD_CORE_API SerializerElement {
    */
   SerializerElement &AddChild(gd::String name);
 
+  /**
+   * \brief Add an existing element as a child, at the end of the children
+   * list, sharing its ownership (the element is not copied).
+   *
+   * If the element is not an array, an existing child with the same name is
+   * replaced.
+   *
+   * \note The element can then be shared by several parents: it's copied when
+   * it's accessed with the non-const GetChild methods of a parent (see the
+   * note about shared children in the class documentation).
+   *
+   * \warning A shared element must not be modified directly (or through the
+   * const GetChild methods), as this would modify all its parents.
+   *
+   * \param name The name of the new child.
+   * \param child The element to add as a child.
+   */
+  void AddSharedChild(gd::String name,
+                      std::shared_ptr<SerializerElement> child);
+
   /**
    * \brief Get a child of the element using its name.
    *
+   * \note Complexity is O(1) for arrays (see the note about the children index
+   * in the class documentation), O(number of children) otherwise.
+   *
    * \param name The name of the child.
    * \param name The index of the child, in case of an array.
    */
@@ -401,14 +482,50 @@ class GD_CORE_API SerializerElement {
                               std::size_t index = 0,
                               gd::String deprecatedName = "") const;
 
+  /**
+   * \brief Get a child of the element using its name, to modify it.
+   *
+   * If the child is shared with other elements, it's first replaced by a copy
+   * (see AddSharedChild).
+   */
+  SerializerElement &GetChild(gd::String name,
+                              std::size_t index = 0,
+                              gd::String deprecatedName = "");
+
   /**
    * \brief Get a child of the element using its index (when the element is
    * considered as an array).
    *
+   * \note Complexity is O(1), except for the first access after the children
+   * were modified.
+   *
    * \param name The index of the child
    */
   SerializerElement &GetChild(std::size_t index) const;
 
+  /**
+   * \brief Get a child of the element using its index (when the element is
+   * considered as an array), to modify it.
+   *
+   * If the child is shared with other elements, it's first replaced by a copy
+   * (see AddSharedChild).
+   */
+  SerializerElement &GetChild(std::size_t index);
+
+  /**
+   * \brief Get a child of the element using its index (when the element is
+   * considered as an array), sharing its ownership. This allows to keep a
+   * child, without copying it, after the element is destroyed.
+   *
+   * \warning If the element is allocated from an arena, the child must not
+   * outlive the arena. The child must not be modified directly (see
+   * AddSharedChild).
+   *
+   * \return The child, or nullptr if the index is out of bounds or if the
+   * element is not considered as an array.
+   */
+  std::shared_ptr<SerializerElement> GetSharedChild(std::size_t index) const;
+
   /**
    * \brief Get the number of children having a specific name.
    *
@@ -446,25 +563,107 @@ class GD_CORE_API SerializerElement {
   };
   ///@}
 
-  static SerializerElement nullElement;
-
  private:
+  friend class Serializer;  // To read/write binary snapshots losslessly.
+
+  /**
+   * \brief Return the element returned when a child is not found.
+   *
+   * As it can be modified like any other element (for example when considered
+   * as an array by a reader), there is one per thread.
+   */
+  static SerializerElement &GetNullElement();
+
   /**
    * Initialize element using another element. Used by copy-ctor and assign-op.
    * Don't forget to update me if members were changed!
    */
   void Init(const gd::SerializerElement &other);
 
+  /**
+   * \brief Return the positions, in the children list, of the children of
+   * the array having the specified name (or an empty name, or the deprecated
+   * name). The index is built if needed.
+   *
+   * \warning Must only be called if the element is considered as an array.
+   */
+  const std::vector<std::size_t> &GetChildrenIndex(
+      const gd::String &name, const gd::String &deprecatedName) const;
+
+  /**
+   * \brief Must be called when children are added/removed or when the
+   * element starts to be considered as an array.
+   */
+  void InvalidateChildrenIndex() const { childrenIndex.reset(); }
+
+  /**
+   * \brief Return the position, in the children list, of the child having the
+   * specified name (or deprecated name) and index, or the number of children
+   * if not found.
+   */
+  std::size_t GetChildPosition(gd::String name,
+                               std::size_t index,
+                               gd::String deprecatedName) const;
+
+  /**
+   * \brief Return the position, in the children list, of the child at the
+   * specified index of the array, or the number of children if not found.
+   */
+  std::size_t GetChildPosition(std::size_t index) const;
+
+  /**
+   * \brief Return the child at the specified position in the children list,
+   * after replacing it by a copy if it's shared with other elements.
+   */
+  SerializerElement &GetUnsharedChild(std::size_t position);
+
+  /**
+   * \brief Create a new empty element, allocated from the same arena as this
+   * element (if any).
+   */
+  std::shared_ptr<SerializerElement> CreateElement() const;
+
+  /**
+   * \brief Set a string value, copying the string in the arena of this element
+   * (if any).
+   */
+  void SetString(SerializerValue &value, const gd::String &string) const;
+
+  /**
+   * \brief Set a string value from a buffer, copying the string in the arena
+   * of this element (if any).
+   */
+  void SetString(SerializerValue &value,
+                 const char *data,
+                 std::size_t size) const;
+
   bool valueUndefined;  ///< If true, the element does not have a value.
   SerializerValue elementValue;
 
-  std::map<gd::String, SerializerValue> attributes;
+  Attributes attributes;
   std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement> > >
       children;
   mutable bool isArray;        ///< true if element is considered as an array
   mutable gd::String arrayOf;  ///< The name of the children (was useful for XML
                                ///< parsed elements).
   mutable gd::String deprecatedArrayOf;  ///< Alternate name for children
+
+  /**
+   * \brief The positions, in the children list, of the children of an array
+   * having a given name (or deprecated name).
+   */
+  struct ChildrenPositions {
+    gd::String name;
+    gd::String deprecatedName;
+    std::vector<std::size_t> positions;
+  };
+  typedef std::vector<ChildrenPositions> ChildrenIndex;
+  mutable std::unique_ptr<ChildrenIndex>
+      childrenIndex;  ///< Only built for arrays, when children are accessed
+                      ///< (usually with a single name).
+
+  gd::Arena *arena;  ///< If set, the children, attributes and strings are
+                     ///< allocated from this arena (not owned).
 };
 
 }  // namespace gd
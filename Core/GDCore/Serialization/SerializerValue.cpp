@@ -1,156 +1,192 @@
 #include "GDCore/Serialization/SerializerValue.h"
+
+#include <cstring>
+#include <istream>
+#include <new>
+#include <streambuf>
+
 #include "GDCore/CommonTools.h"
 
+namespace {
+/**
+ * \brief A read-only stream buffer over a string that is not copied.
+ */
+class StringViewBuffer : public std::streambuf {
+ public:
+  StringViewBuffer(const char *data, std::size_t size) {
+    char *begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+/**
+ * \brief Convert a string like gd::String::To, without copying it.
+ */
+template <typename T>
+T ParseStringView(const char *data, std::size_t size) {
+  StringViewBuffer buffer(data, size);
+  std::istream stream(&buffer);
+  T value;
+  stream >> value;
+  return value;
+}
+}  // namespace
+
 namespace gd {
 
-SerializerValue::SerializerValue()
-    : isUnknown(true),
-      isBoolean(false),
-      isString(false),
-      isInt(false),
-      isDouble(false),
-      booleanValue(false),
-      intValue(0),
-      doubleValue(0) {}
+SerializerValue::SerializerValue() : type(Unknown), isStringView(false) {
+  new (&stringValue) gd::String();
+}
 
 SerializerValue::SerializerValue(bool val)
-    : isUnknown(true),
-      isBoolean(false),
-      isString(false),
-      isInt(false),
-      isDouble(false),
-      booleanValue(false),
-      intValue(0),
-      doubleValue(0) {
-  SetBool(val);
-}
+    : type(Boolean), isStringView(false), booleanValue(val) {}
+
 SerializerValue::SerializerValue(const gd::String &val)
-    : isUnknown(true),
-      isBoolean(false),
-      isString(false),
-      isInt(false),
-      isDouble(false),
-      booleanValue(false),
-      intValue(0),
-      doubleValue(0) {
-  SetString(val);
+    : type(String), isStringView(false) {
+  new (&stringValue) gd::String(val);
 }
+
 SerializerValue::SerializerValue(int val)
-    : isUnknown(true),
-      isBoolean(false),
-      isString(false),
-      isInt(false),
-      isDouble(false),
-      booleanValue(false),
-      intValue(0),
-      doubleValue(0) {
-  SetInt(val);
-}
+    : type(Int), isStringView(false), intValue(val) {}
+
 SerializerValue::SerializerValue(double val)
-    : isUnknown(true),
-      isBoolean(false),
-      isString(false),
-      isInt(false),
-      isDouble(false),
-      booleanValue(false),
-      intValue(0),
-      doubleValue(0) {
-  SetDouble(val);
+    : type(Double), isStringView(false), doubleValue(val) {}
+
+SerializerValue::SerializerValue(const SerializerValue &other)
+    : type(Unknown), isStringView(false) {
+  new (&stringValue) gd::String();
+  *this = other;
+}
+
+SerializerValue &SerializerValue::operator=(const SerializerValue &other) {
+  if (this == &other) return *this;
+
+  switch (other.type) {
+    case Boolean:
+      SetBool(other.booleanValue);
+      break;
+    case Int:
+      SetInt(other.intValue);
+      break;
+    case Double:
+      SetDouble(other.doubleValue);
+      break;
+    case String:
+    case Unknown:
+      // A string referencing an external buffer is copied, so that the copy
+      // does not depend on the lifetime of the buffer.
+      ConstructString(other.type);
+      stringValue.Raw().assign(other.GetRawStringData(),
+                               other.GetRawStringSize());
+      break;
+  }
+
+  return *this;
+}
+
+SerializerValue::~SerializerValue() { DestroyString(); }
+
+void SerializerValue::DestroyString() {
+  if (HoldsString() && !isStringView) stringValue.~String();
+  isStringView = false;
+}
+
+void SerializerValue::ConstructString(Type stringType) {
+  if (!HoldsString() || isStringView) {
+    DestroyString();
+    new (&stringValue) gd::String();
+  }
+
+  type = stringType;
 }
 
 bool SerializerValue::GetBool() const {
-  if (isString || isUnknown)
-    return stringValue != "false";
-  else if (isInt)
+  if (HoldsString())
+    return GetRawStringSize() != 5 ||
+           memcmp(GetRawStringData(), "false", 5) != 0;
+  else if (type == Int)
     return intValue != 0;
-  else if (isDouble)
+  else if (type == Double)
     return doubleValue != 0.0;
 
   return booleanValue;
 }
 
 gd::String SerializerValue::GetString() const {
-  if (isBoolean)
+  if (type == Boolean)
     return booleanValue ? gd::String("true") : gd::String("false");
-  else if (isInt)
+  else if (type == Int)
     return gd::String::From(intValue);
-  else if (isDouble)
+  else if (type == Double)
     return gd::String::From(doubleValue);
-  else if (isUnknown)
-    return stringValue;
 
-  return stringValue;
+  return GetRawString();
+}
+
+gd::String SerializerValue::GetRawString() const {
+  if (!HoldsString()) return gd::String();
+  if (!isStringView) return stringValue;
+
+  gd::String str;
+  str.Raw().assign(stringView.data, stringView.size);
+  return str;
 }
 
 int SerializerValue::GetInt() const {
-  if (isBoolean)
+  if (type == Boolean)
     return booleanValue ? 1 : 0;
-  else if (isString || isUnknown)
-    return stringValue.To<int>();
-  else if (isDouble)
+  else if (HoldsString())
+    return ParseStringView<int>(GetRawStringData(), GetRawStringSize());
+  else if (type == Double)
     return doubleValue;
 
   return intValue;
 }
 
 double SerializerValue::GetDouble() const {
-  if (isBoolean)
+  if (type == Boolean)
     return booleanValue ? 1 : 0;
-  else if (isString || isUnknown)
-    return stringValue.To<double>();
-  else if (isInt)
+  else if (HoldsString())
+    return ParseStringView<double>(GetRawStringData(), GetRawStringSize());
+  else if (type == Int)
     return intValue;
 
   return doubleValue;
 }
 
 void SerializerValue::Set(const gd::String &val) {
-  isUnknown = true;
-  isBoolean = false;
-  isString = false;
-  isInt = false;
-  isDouble = false;
-
+  ConstructString(Unknown);
   stringValue = val;
 }
 
 void SerializerValue::SetBool(bool val) {
-  isUnknown = false;
-  isBoolean = true;
-  isString = false;
-  isInt = false;
-  isDouble = false;
-
+  DestroyString();
+  type = Boolean;
   booleanValue = val;
 }
 
 void SerializerValue::SetString(const gd::String &val) {
-  isUnknown = false;
-  isBoolean = false;
-  isString = true;
-  isInt = false;
-  isDouble = false;
-
+  ConstructString(String);
   stringValue = val;
 }
 
-void SerializerValue::SetInt(int val) {
-  isUnknown = false;
-  isBoolean = false;
-  isString = false;
-  isInt = true;
-  isDouble = false;
+void SerializerValue::SetStringView(const char *data, std::size_t size) {
+  DestroyString();
+  type = String;
+  isStringView = true;
+  stringView.data = data;
+  stringView.size = size;
+}
 
+void SerializerValue::SetInt(int val) {
+  DestroyString();
+  type = Int;
   intValue = val;
 }
 
 void SerializerValue::SetDouble(double val) {
-  isUnknown = false;
-  isBoolean = false;
-  isString = false;
-  isInt = false;
-  isDouble = true;
-
+  DestroyString();
+  type = Double;
   doubleValue = val;
 }
 
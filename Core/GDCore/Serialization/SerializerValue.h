@@ -6,6 +6,7 @@
 
 #ifndef GDCORE_SERIALIZERVALUE_H
 #define GDCORE_SERIALIZERVALUE_H
+#include <cstddef>
 #include <string>
 #include "GDCore/String.h"
 
@@ -14,6 +15,13 @@ namespace gd {
 /**
  * \brief A value stored inside a gd::SerializerElement.
  *
+ * The value is stored in a compact way: only the member corresponding to
+ * its type is stored (a boolean, an int, a double or a string).
+ *
+ * A string value can also reference an external buffer instead of owning a
+ * copy of the string (see SetStringView). This is used when parsing JSON in
+ * situ, see gd::Serializer::FromJSONInsitu.
+ *
  * \see gd::Serializer
  * \see gd::SerializerElement
  */
@@ -24,7 +32,23 @@ class GD_CORE_API SerializerValue {
   SerializerValue(const gd::String &val);
   SerializerValue(int val);
   SerializerValue(double val);
-  virtual ~SerializerValue(){};
+
+  /**
+   * \brief Copy constructor.
+   *
+   * \note If the value references an external buffer, the copy owns a copy of
+   * the string, so that it can outlive the buffer.
+   */
+  SerializerValue(const SerializerValue &other);
+
+  /**
+   * \brief Assignment operator.
+   *
+   * \see SerializerValue(const SerializerValue &other)
+   */
+  SerializerValue &operator=(const SerializerValue &other);
+
+  ~SerializerValue();
 
   /**
    * Set the value, its type being a boolean.
@@ -36,6 +60,19 @@ class GD_CORE_API SerializerValue {
    */
   void SetString(const gd::String &val);
 
+  /**
+   * \brief Set the value, its type being a string, referencing the string
+   * stored in an external buffer (which is not copied).
+   *
+   * \warning The buffer must stay valid as long as the value (or the
+   * element containing it) is used. Copies of the value own a copy of the
+   * string.
+   *
+   * \param data The UTF8 encoded string (does not need to be null terminated).
+   * \param size The size of the string, in bytes.
+   */
+  void SetStringView(const char *data, std::size_t size);
+
   /**
    * Set the value, its type being an integer.
    */
@@ -64,8 +101,30 @@ class GD_CORE_API SerializerValue {
   /**
    * Get the string value, without attempting any conversion.
    * Make sure to check that IsString is true beforehand.
+   *
+   * \note The string is copied. Prefer GetRawStringData and GetRawStringSize
+   * to read the string without copying it.
    */
-  const gd::String& GetRawString() const { return stringValue; };
+  gd::String GetRawString() const;
+
+  /**
+   * Get a pointer to the UTF8 encoded string value, without any conversion or
+   * copy. Make sure to check that IsString is true beforehand.
+   *
+   * \note The string is not necessarily null terminated, see
+   * GetRawStringSize.
+   */
+  const char *GetRawStringData() const {
+    return isStringView ? stringView.data : stringValue.Raw().data();
+  }
+
+  /**
+   * Get the size, in bytes, of the string value.
+   * Make sure to check that IsString is true beforehand.
+   */
+  std::size_t GetRawStringSize() const {
+    return isStringView ? stringView.size : stringValue.Raw().size();
+  }
 
   /**
    * Get the value, its type being an int.
@@ -80,32 +139,69 @@ class GD_CORE_API SerializerValue {
   /**
    * \brief Return true if the value is a boolean.
    */
-  bool IsBoolean() const { return isBoolean; }
+  bool IsBoolean() const { return type == Boolean; }
   /**
    * \brief Return true if the value is a string.
    */
-  bool IsString() const { return isString; }
+  bool IsString() const { return type == String; }
   /**
    * \brief Return true if the value is an int.
    */
-  bool IsInt() const { return isInt; }
+  bool IsInt() const { return type == Int; }
   /**
    * \brief Return true if the value is a double.
    */
-  bool IsDouble() const { return isDouble; }
+  bool IsDouble() const { return type == Double; }
+
+  /**
+   * \brief Return true if the value is a string referencing an external
+   * buffer.
+   *
+   * \see SetStringView
+   */
+  bool IsStringView() const { return isStringView; }
 
  private:
-  bool isUnknown;  ///< If true, the type is unknown but the value is stored as
-                   ///< a string in stringValue member.
-  bool isBoolean;
-  bool isString;
-  bool isInt;
-  bool isDouble;
-
-  bool booleanValue;
-  gd::String stringValue;
-  int intValue;
-  double doubleValue;
+  enum Type : unsigned char {
+    Unknown,  ///< The type is unknown but the value is stored as a string.
+    Boolean,
+    String,
+    Int,
+    Double
+  };
+
+  /**
+   * \brief Return true if the value is stored as a string (owned or
+   * referencing an external buffer).
+   */
+  bool HoldsString() const { return type == Unknown || type == String; }
+
+  /**
+   * \brief Destroy the string owned by the value, if any.
+   */
+  void DestroyString();
+
+  /**
+   * \brief Set the type and construct an empty string owned by the value.
+   */
+  void ConstructString(Type stringType);
+
+  Type type;
+  bool isStringView;  ///< true if the string references an external buffer
+                      ///< (stringView is used instead of stringValue).
+
+  struct StringView {
+    const char *data;
+    std::size_t size;
+  };
+
+  union {
+    bool booleanValue;
+    int intValue;
+    double doubleValue;
+    gd::String stringValue;
+    StringView stringView;
+  };
 };
 
 }  // namespace gd
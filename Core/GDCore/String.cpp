@@ -7,7 +7,12 @@
 #include "GDCore/String.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "GDCore/CommonTools.h"
 #include "GDCore/Utf8/utf8proc.h"
@@ -17,30 +22,124 @@ namespace gd
 
 constexpr String::size_type String::npos;
 
-String::String() : m_string()
+namespace priv
+{
+    /**
+     * \return the first byte between **first** and **last** which is not an
+     * ASCII character (or **last** if there is none).
+     *
+     * ASCII characters are the most common case: they are checked 16 bytes at
+     * a time when SSE2 is available, 8 bytes at a time otherwise.
+     */
+    const char* SkipASCIICharacters( const char *first, const char *last )
+    {
+        #if defined(__SSE2__)
+        while( last - first >= 16 )
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            if( _mm_movemask_epi8(bytes) != 0 ) //A byte has its highest bit set.
+                break;
+            first += 16;
+        }
+        #endif
+        while( last - first >= 8 )
+        {
+            std::uint64_t bytes;
+            std::memcpy(&bytes, first, 8);
+            if( bytes & 0x8080808080808080ULL )
+                break;
+            first += 8;
+        }
+        while( first < last && static_cast<unsigned char>(*first) < 0x80 )
+            ++first;
+
+        return first;
+    }
+
+    /**
+     * \return the number of characters between **first** and **last**, in the
+     * same way as iterating over them using String iterators.
+     */
+    String::size_type CountCodepoints( const char *first, const char *last )
+    {
+        String::size_type count = 0;
+        const char *it = first;
+        while( it < last )
+        {
+            //Count the ASCII characters without decoding them.
+            const char *nonASCII = SkipASCIICharacters(it, last);
+            count += nonASCII - it;
+            it = nonASCII;
+            if( it < last )
+            {
+                ::utf8::unchecked::next(it);
+                ++count;
+            }
+        }
+
+        return count;
+    }
+}
+
+String::String() : m_string(), m_size(0)
 {
 
 }
 
-String::String(const char *characters) : m_string()
+String::String(const char *characters) : m_string(), m_size(0)
 {
     *this = characters;
 }
 
-String::String(const std::u32string &string) : m_string()
+String::String(const std::u32string &string) : m_string(), m_size(0)
 {
     *this = string;
 }
 
+String::String(const String &other) :
+    m_string(other.m_string),
+    m_size(other.m_size.load(std::memory_order_relaxed))
+{
+
+}
+
+String::String(String &&other) noexcept :
+    m_string(std::move(other.m_string)),
+    m_size(other.m_size.exchange(npos, std::memory_order_relaxed))
+{
+
+}
+
+String& String::operator=(const String &other)
+{
+    if(this == &other)
+        return *this;
+
+    m_string = other.m_string;
+    m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+String& String::operator=(String &&other) noexcept
+{
+    if(this == &other)
+        return *this;
+
+    m_string = std::move(other.m_string);
+    m_size.store(other.m_size.exchange(npos, std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
 String& String::operator=(const char *characters)
 {
+    InvalidateSize();
     m_string = std::string(characters);
     return *this;
 }
 
 String& String::operator=(const std::u32string &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -60,7 +159,53 @@ String& String::operator=(const std::u32string &string)
 
 String::size_type String::size() const
 {
-    return std::distance(begin(), end());
+    size_type size = m_size.load(std::memory_order_relaxed);
+    if(size == npos)
+    {
+        //The string is not modified while its const methods are called, so
+        //threads computing the size at the same time store the same value.
+        size = priv::CountCodepoints(m_string.data(), m_string.data() + m_string.size());
+        m_size.store(size, std::memory_order_relaxed);
+    }
+
+    return size;
+}
+
+String::size_type String::GetBytePosition( size_type position, size_type fromBytePosition ) const
+{
+    if(HasOnlySingleByteCharacters())
+    {
+        size_type bytePosition = std::min(fromBytePosition, m_string.size());
+        return bytePosition + std::min(position, m_string.size() - bytePosition);
+    }
+
+    const char *first = m_string.data();
+    const char *last = first + m_string.size();
+    const char *it = first + std::min(fromBytePosition, m_string.size());
+    while(position > 0 && it < last)
+    {
+        //Skip the ASCII characters (at most "position" of them) without decoding them.
+        const char *nonASCII = priv::SkipASCIICharacters(it,
+            static_cast<size_type>(last - it) > position ? it + position : last);
+        position -= nonASCII - it;
+        it = nonASCII;
+        if(position > 0 && it < last)
+        {
+            ::utf8::unchecked::next(it);
+            --position;
+        }
+    }
+
+    return std::min<size_type>(it - first, m_string.size());
+}
+
+String::size_type String::GetPositionFromBytePosition( size_type bytePosition ) const
+{
+    if(HasOnlySingleByteCharacters())
+        return std::min(bytePosition, m_string.size());
+
+    const char *first = m_string.data();
+    return priv::CountCodepoints(first, first + std::min(bytePosition, m_string.size()));
 }
 
 String::iterator String::begin()
@@ -152,9 +297,19 @@ std::string String::ToLocale() const
 std::u32string String::ToUTF32() const
 {
     std::u32string u32str;
-    for( const_iterator it = begin(); it != end(); ++it )
+    u32str.reserve( size() );
+
+    const char *it = m_string.data();
+    const char *last = it + m_string.size();
+    while( it < last )
     {
-        u32str.push_back( *it );
+        //ASCII characters are the same in UTF32.
+        const char *nonASCII = priv::SkipASCIICharacters(it, last);
+        u32str.append( reinterpret_cast<const unsigned char*>(it),
+                       reinterpret_cast<const unsigned char*>(nonASCII) );
+        it = nonASCII;
+        if( it < last )
+            u32str.push_back( ::utf8::unchecked::next(it) );
     }
 
     return u32str;
@@ -180,34 +335,78 @@ std::wstring String::ToWide() const
 
 bool String::IsValid() const
 {
-    return ::utf8::is_valid(m_string.begin(), m_string.end());
+    const char *it = m_string.data();
+    const char *last = it + m_string.size();
+    while( true )
+    {
+        //ASCII characters are always valid.
+        it = priv::SkipASCIICharacters(it, last);
+        if( it == last )
+            return true;
+
+        if( ::utf8::internal::validate_next(it, last) != ::utf8::internal::UTF8_OK )
+            return false;
+    }
 }
 
 String& String::ReplaceInvalid( value_type replacement )
 {
+    //Most strings are valid: keep them (and their length) as they are.
+    if( IsValid() )
+        return *this;
+
     std::string validStr;
-    ::utf8::replace_invalid(m_string.begin(), m_string.end(), std::back_inserter(validStr), replacement);
+    validStr.reserve(m_string.size());
+    const char *it = m_string.data();
+    const char *last = it + m_string.size();
+    while( it < last )
+    {
+        const char *nonASCII = priv::SkipASCIICharacters(it, last);
+        validStr.append(it, nonASCII);
+        it = nonASCII;
+        if( it == last )
+            break;
+
+        const char *sequenceStart = it;
+        ::utf8::internal::utf_error error = ::utf8::internal::validate_next(it, last);
+        if( error == ::utf8::internal::UTF8_OK )
+        {
+            validStr.append(sequenceStart, it);
+            continue;
+        }
 
-    m_string = validStr;
+        //Replace the invalid sequence (even if it is truncated by the end of
+        //the string) by a single replacement character.
+        ::utf8::unchecked::append(replacement, std::back_inserter(validStr));
+        it = sequenceStart + 1;
+        if( error != ::utf8::internal::INVALID_LEAD )
+        {
+            while( it < last && ::utf8::internal::is_trail(*it) )
+                ++it;
+        }
+    }
+
+    InvalidateSize();
+    m_string = std::move(validStr);
 
     return *this;
 }
 
 String::value_type String::operator[]( const String::size_type position ) const
 {
-    const_iterator it = begin();
-    std::advance(it, position);
-    return *it;
+    return ::utf8::unchecked::peek_next(m_string.data() + GetBytePosition(position));
 }
 
 String& String::operator+=( const String &other )
 {
+    InvalidateSize();
     m_string += other.m_string;
     return *this;
 }
 
 String& String::operator+=( const char *other )
 {
+    InvalidateSize();
     m_string += other;
     return *this;
 }
@@ -220,21 +419,25 @@ String& String::operator+=( value_type character )
 
 void String::push_back( String::value_type character )
 {
+    InvalidateSize();
     ::utf8::unchecked::append(character, std::back_inserter(m_string));
 }
 
 void String::pop_back()
 {
+    InvalidateSize();
     m_string.erase((--end()).base(), end().base());
 }
 
 String& String::insert( size_type pos, const String &str )
 {
-    iterator it = begin();
-    std::advance(it, pos);
+    //Use the real position as bytes
+    size_type bytePosition = GetBytePosition(pos);
+    if(bytePosition == m_string.size() && pos > size())
+        throw std::out_of_range("[gd::String::insert] starting pos greater than size");
 
-    //Use the real position as bytes using the std::string::iterators
-    m_string.insert( std::distance(m_string.begin(), it.base()), str.m_string );
+    InvalidateSize();
+    m_string.insert( bytePosition, str.m_string );
 
     return *this;
 }
@@ -277,6 +480,7 @@ String &String::RemoveConsecutiveOccurrences(iterator i1,
 
 String& String::replace( iterator i1, iterator i2, const String &str )
 {
+    InvalidateSize();
     m_string.replace(i1.base(), i2.base(), str.m_string);
 
     return *this;
@@ -284,6 +488,7 @@ String& String::replace( iterator i1, iterator i2, const String &str )
 
 String& String::replace( iterator i1, iterator i2, size_type n, const char c )
 {
+    InvalidateSize();
     m_string.replace(i1.base(), i2.base(), n, c);
 
     return *this;
@@ -291,66 +496,57 @@ String& String::replace( iterator i1, iterator i2, size_type n, const char c )
 
 String& String::replace( String::size_type pos, String::size_type len, const char c )
 {
-    if(pos > size())
+    size_type bytePosition = GetBytePosition(pos);
+    if(bytePosition == m_string.size() && pos > size())
         throw std::out_of_range("[gd::String::replace] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance( i1, pos );
+    //Stop at the end of the string if there are less than "len" characters after "pos"
+    size_type byteEndPosition = GetBytePosition(len, bytePosition);
 
-    iterator i2 = i1;
-    while(i2 != end() && len > 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        --len;
-    }
+    InvalidateSize();
+    m_string.replace(bytePosition, byteEndPosition - bytePosition, 1, c);
 
-    return replace( i1, i2, 1, c );
+    return *this;
 }
 
 String& String::replace( String::size_type pos, String::size_type len, const String &str )
 {
-    if(pos > size())
+    size_type bytePosition = GetBytePosition(pos);
+    if(bytePosition == m_string.size() && pos > size())
         throw std::out_of_range("[gd::String::replace] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance( i1, pos );
+    //Stop at the end of the string if there are less than "len" characters after "pos"
+    size_type byteEndPosition = GetBytePosition(len, bytePosition);
 
-    iterator i2 = i1;
-    while(i2 != end() && len > 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        --len;
-    }
+    InvalidateSize();
+    m_string.replace(bytePosition, byteEndPosition - bytePosition, str.m_string);
 
-    return replace( i1, i2, str );
+    return *this;
 }
 
 String::iterator String::erase( String::iterator first, String::iterator last )
 {
+    InvalidateSize();
     return iterator( m_string.erase( first.base(), last.base() ) );
 }
 
 String::iterator String::erase( String::iterator p )
 {
+    InvalidateSize();
     return iterator( m_string.erase( p.base() ) );
 }
 
 void String::erase( String::size_type pos, String::size_type len )
 {
-    if(pos > size())
+    size_type bytePosition = GetBytePosition(pos);
+    if(bytePosition == m_string.size() && pos > size())
         throw std::out_of_range("[gd::String::erase] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance(i1, pos);
-
-    iterator i2 = i1;
-    while(i2 != end() && len != 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        len--;
-    }
+    //Stop at the end of the string if there are less than "len" characters after "pos"
+    size_type byteEndPosition = GetBytePosition(len, bytePosition);
 
-    erase( i1, i2 );
+    InvalidateSize();
+    m_string.erase(bytePosition, byteEndPosition - bytePosition);
 }
 
 std::vector<String> String::Split( String::value_type delimiter ) const
@@ -440,6 +636,7 @@ String& String::Normalize(String::NormForm form)
     else if(form == NFKC)
         newStr = utf8proc_NFKC((unsigned char*)m_string.c_str());
 
+    InvalidateSize();
     m_string = (char*)newStr;
 
     free(newStr);
@@ -449,52 +646,37 @@ String& String::Normalize(String::NormForm form)
 
 String String::substr( String::size_type start, String::size_type length ) const
 {
-    String str;
-
-    const_iterator startIt = begin();
-    while(start > 0 && startIt != end())
-    {
-        ++startIt;
-        --start;
-    }
-    if(start > 0) //We reach the end of the string before the start position
+    size_type bytePosition = GetBytePosition(start);
+    if(bytePosition == m_string.size() && start > size()) //The end of the string is before the start position
         throw std::out_of_range("[gd::String::substr] starting pos greater than size");
 
-    const_iterator endIt = startIt;
-    while(length > 0 && endIt != end())
-    {
-        ++endIt;
-        --length;
-    }
+    //Stop at the end of the string if there are less than "length" characters after "start"
+    size_type byteEndPosition = GetBytePosition(length, bytePosition);
 
-    str.m_string = std::string( startIt.base(), endIt.base() );
+    String str;
+    str.m_string.assign( m_string, bytePosition, byteEndPosition - bytePosition );
+    //A part of a string made of single byte characters is made of them too.
+    str.m_size.store(HasOnlySingleByteCharacters() ? str.m_string.size() : npos, std::memory_order_relaxed);
 
     return str;
 }
 
 String::size_type String::find( const String &search, String::size_type pos ) const
 {
-    const_iterator it = begin();
-
-    //Move to pos
-    if(pos < size())
-        std::advance( it, pos );
-    else
+    //The byte position is the end of the string if and only if pos >= size().
+    size_type bytePosition = GetBytePosition(pos);
+    if(bytePosition == m_string.size())
         return npos;
 
-    //Use the standard std::string to find a string (using their internal std::strings).
-    //Use the raw std::string iterator to get the offset as a **byte** count for the starting
-    //position.
+    //Use the standard std::string to find a string (using their internal std::strings),
+    //with the offset as a **byte** count for the starting position.
     std::string::size_type findPos =
-        m_string.find( search.m_string, std::distance( m_string.begin(), it.base() ) );
+        m_string.find( search.m_string, bytePosition );
 
     if( findPos != std::string::npos )
     {
-        //Create a String::iterator from the std::string::iterator pointing to the find result.
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance in **characters** count (that's why we need a String::iterator).
-        return std::distance( begin(), findPosIt );
+        //Return the position in **characters** count.
+        return GetPositionFromBytePosition( findPos );
     }
     else
         return npos;
@@ -512,32 +694,18 @@ String::size_type String::find( const String::value_type search, String::size_ty
 
 String::size_type String::rfind( const String &search, String::size_type pos ) const
 {
-    //Move to pos + 1 (we will then get the last byte of the character at pos)
-    const_iterator it = begin();
-    std::string::const_iterator baseIt;
-    if( pos < size() ) //little optimization by testing npos directly (avoid calculating size())
-    {
-        std::advance( it, pos + 1 );
-        baseIt = it.base();
-        --baseIt; //Decrement the std::string::iterator by one because we need
-        //it to point to the last byte of the character at pos
-    }
-
     //The last character is included, so we need to put the position
-    //of the last byte of the character at the position "pos"
+    //of the last byte of the character at the position "pos" (i.e: the byte
+    //before the character at pos + 1)
+    size_type byteEndPosition = pos == npos ? m_string.size() : GetBytePosition( pos + 1 );
     std::string::size_type findPos = m_string.rfind( search.m_string,
-        pos < size() ? std::distance( m_string.begin(), baseIt ) : std::string::npos
+        byteEndPosition < m_string.size() ? byteEndPosition - 1 : std::string::npos
         );
 
     if( findPos != std::string::npos )
     {
-        //Create a String::iterator to the find position to be able to get the real
-        //distance as characters count (it would be a distance as bytes count
-        //with a std::string::iterator)
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance (which is a distance as characters count)
-        return std::distance( begin(), findPosIt );
+        //Return the position as characters count (and not as bytes count)
+        return GetPositionFromBytePosition( findPos );
     }
     else
         return npos;
@@ -564,11 +732,11 @@ namespace priv
         else
             return String::npos;
 
-        for( ; it != str.end(); ++it )
+        for( String::size_type pos = startPos; it != str.end(); ++it, ++pos )
         {
             //Search the current char in the match string
             if( ( std::find( match.begin(), match.end(), (*it) ) != match.end() ) != not_of )
-                return std::distance( str.begin(), it );
+                return pos;
         }
 
         return String::npos;
@@ -594,15 +762,20 @@ namespace priv
         String::size_type strSize = str.size();
 
         String::const_iterator it = str.end();
+        String::size_type pos = strSize;
         if( endPos < strSize )
+        {
             std::advance( it, endPos - strSize + 1 );
+            pos = endPos + 1;
+        }
 
         while( it != str.begin() )
         {
             --it;
+            --pos;
 
             if( ( std::find( match.begin(), match.end(), (*it) ) != match.end() ) != not_of )
-                return std::distance( str.begin(), it );
+                return pos;
         }
 
         return String::npos;
@@ -7,6 +7,7 @@
 #ifndef GDCORE_UTF8_STRING_H
 #define GDCORE_UTF8_STRING_H
 
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -118,6 +119,10 @@ public:
      */
     String(const std::u32string &string);
 
+    String(const String &other);
+
+    String(String &&other) noexcept;
+
 /**
  * \}
  */
@@ -140,6 +145,10 @@ public:
 
     String& operator=(const std::u32string &string);
 
+    String& operator=(const String &other);
+
+    String& operator=(String &&other) noexcept;
+
 /**
  * \}
  */
@@ -156,6 +165,10 @@ public:
 
     /**
      * \brief Returns the string's length.
+     *
+     * \note The length is computed (in linear time, counting the ASCII
+     * characters 8 or 16 at a time) the first time it's requested, then kept
+     * until the string is modified.
      */
     size_type size() const;
 
@@ -169,7 +182,7 @@ public:
      *
      * **Iterators :** Obviously, all iterators are invalidated.
      */
-    void clear() { m_string.clear(); }
+    void clear() { m_string.clear(); m_size.store(0, std::memory_order_relaxed); }
 
     void reserve(gd::String::size_type size) { m_string.reserve(size); }
 
@@ -335,16 +348,20 @@ public:
 
     /**
      * \brief Returns the code point at the specified position
-     * \warning This operator has a linear complexity on the character's
-     * position. You should avoid to use it in a loop and use the iterators
+     * \warning This operator has a constant complexity if the string is only
+     * made of ASCII characters, but a linear complexity on the character's
+     * position otherwise (even if the ASCII characters are skipped 8 or 16 at
+     * a time). You should avoid to use it in a loop and use the iterators
      * provided by this class instead.
      */
     value_type operator[]( const size_type position ) const;
 
     /**
      * \brief Get the raw UTF8-encoded std::string
+     * \note As the std::string can be modified, the length of the String is
+     * computed again when next requested.
      */
-    std::string& Raw() { return m_string; }
+    std::string& Raw() { InvalidateSize(); return m_string; }
 
     /**
      * \brief Get the raw UTF8-encoded std::string
@@ -675,8 +692,35 @@ public:
  */
 
 private:
-    std::string m_string; ///< Internal std::string container
+    /**
+     * \brief Return the position, in bytes, of the character at the given
+     * position (or the size of the string, in bytes, if the position is
+     * greater than the length).
+     * \param fromBytePosition the position, in bytes, of a character from
+     * which **position** is counted.
+     */
+    size_type GetBytePosition( size_type position, size_type fromBytePosition = 0 ) const;
+
+    /**
+     * \brief Return the position of the character starting at the given
+     * position in bytes.
+     */
+    size_type GetPositionFromBytePosition( size_type bytePosition ) const;
+
+    /**
+     * \brief Return true if all the characters are one byte long, i.e: if
+     * positions are the same in bytes and in characters.
+     */
+    bool HasOnlySingleByteCharacters() const { return size() == m_string.size(); }
 
+    /**
+     * \brief Forget the length of the string, to be called when the
+     * std::string is modified.
+     */
+    void InvalidateSize() { m_size.store(npos, std::memory_order_relaxed); }
+
+    std::string m_string; ///< Internal std::string container
+    mutable std::atomic<size_type> m_size; ///< Length of the string, or npos if not computed yet (it can be computed by const methods called from multiple threads).
 };
 
 /**
@@ -858,7 +902,9 @@ namespace std
  * The UTF8 encoding has the advantage to reduce the RAM consumption compared to UTF16 or UTF32 for strings using a lot
  * of latin characters. But the characters variable length brings some performance issues compared to fixed size encoding.
  * That's why the complexity of each methods is written in their documentation. For instance, the size() method is linear
- * on the string size and so is the operator[]().
+ * on the string size the first time it's called, but the length is then kept in the String until it's modified. The
+ * operator[]() is constant for strings only made of ASCII characters (the most common in games) and linear otherwise.
+ * Both skip the ASCII characters by blocks of 8 or 16 bytes instead of decoding them one by one.
  *
  * \section Conversion Conversions from/to other string types
  * The String handles implicit conversion with std::String (implicit constructor and implicit conversion
@@ -0,0 +1,39 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/Arena.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gd {
+
+Arena::Arena(std::size_t blockSize_)
+    : blockSize(blockSize_), current(nullptr), remaining(0), allocatedSize(0) {}
+
+Arena::~Arena() {}
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+  std::size_t padding =
+      (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) %
+      alignment;
+  if (current == nullptr || padding + size > remaining) {
+    // Allocations larger than a block get their own block. Blocks are
+    // allocated with new[], so are aligned for any type.
+    std::size_t newBlockSize = size > blockSize ? size : blockSize;
+    blocks.push_back(std::unique_ptr<char[]>(new char[newBlockSize]));
+    current = blocks.back().get();
+    remaining = newBlockSize;
+    padding = 0;
+  }
+
+  void* allocated = current + padding;
+  current += padding + size;
+  remaining -= padding + size;
+  allocatedSize += size;
+  return allocated;
+}
+
+}  // namespace gd
@@ -0,0 +1,197 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_ARENA_H
+#define GDCORE_ARENA_H
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace gd {
+struct ArenaDeleter;
+}
+
+namespace gd {
+
+/**
+ * \brief A bump allocator: memory is allocated by chunks from large blocks,
+ * and only freed, all at once, when the arena is destroyed.
+ *
+ * This is useful for trees made of a lot of small nodes (like
+ * gd::SerializerElement) that are built and destroyed together.
+ *
+ * \note An arena is not thread-safe.
+ *
+ * \see gd::ArenaAllocator
+ * \ingroup Tools
+ */
+class GD_CORE_API Arena {
+ public:
+  Arena(std::size_t blockSize = 64 * 1024);
+  ~Arena();
+
+  /**
+   * \brief Allocate \a size bytes, aligned on \a alignment (which must be a
+   * power of two, not greater than the alignment of std::max_align_t).
+   *
+   * The memory is not initialized and stays allocated until the arena
+   * is destroyed.
+   */
+  void* Allocate(std::size_t size, std::size_t alignment);
+
+  /**
+   * \brief Return the number of bytes allocated from the arena.
+   */
+  std::size_t GetAllocatedSize() const { return allocatedSize; }
+
+  /**
+   * \brief Return the number of blocks allocated by the arena.
+   */
+  std::size_t GetBlocksCount() const { return blocks.size(); }
+
+ private:
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  std::size_t blockSize;
+  std::vector<std::unique_ptr<char[]>> blocks;
+  char* current;           ///< The first free byte of the last block.
+  std::size_t remaining;   ///< The free bytes in the last block.
+  std::size_t allocatedSize;
+};
+
+/**
+ * \brief A standard allocator allocating from a gd::Arena, or from the heap if
+ * no arena is given.
+ *
+ * The allocator does not own the arena: the arena must outlive the objects
+ * (or the containers) using it. Deallocating memory allocated from an arena
+ * does nothing: memory is released with the arena.
+ *
+ * \see gd::Arena
+ * \ingroup Tools
+ */
+template <class T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  ArenaAllocator(gd::Arena* arena_ = nullptr) : arena(arena_){};
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena){};
+
+  T* allocate(std::size_t n) {
+    if (!arena) return static_cast<T*>(::operator new(n * sizeof(T)));
+    return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, std::size_t n) {
+    if (!arena) ::operator delete(p);
+  };
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena == other.arena;
+  }
+  template <class U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena != other.arena;
+  }
+
+  gd::Arena* arena;
+};
+
+/**
+ * \brief A base class for objects that can be allocated either from the heap
+ * or from a gd::Arena, while still being owned and deleted as usual with a
+ * gd::ArenaUniquePtr.
+ *
+ * Use gd::MakeArenaUnique to allocate an object from an arena (or from the
+ * heap if the arena is null). Deleting an object allocated from an arena calls
+ * its destructor, but its memory is only released with the arena: the arena
+ * must outlive the object.
+ *
+ * \see gd::Arena
+ * \ingroup Tools
+ */
+class GD_CORE_API ArenaAllocated {
+ public:
+  ArenaAllocated() : allocatedFromArena(false){};
+  ArenaAllocated(const ArenaAllocated&) : allocatedFromArena(false){};
+  ArenaAllocated& operator=(const ArenaAllocated&) { return *this; };
+
+  /**
+   * \brief Return true if the object was allocated from an arena (in which
+   * case its memory must not be freed).
+   */
+  bool IsAllocatedFromArena() const { return allocatedFromArena; }
+
+ private:
+  template <class T, class... Args>
+  friend std::unique_ptr<T, ArenaDeleter> MakeArenaUnique(gd::Arena* arena,
+                                                          Args&&... args);
+
+  bool allocatedFromArena;
+};
+
+/**
+ * \brief The deleter of objects deriving from gd::ArenaAllocated: the memory
+ * of objects allocated from an arena is left to the arena.
+ *
+ * It can be converted from the default deleter, so that a std::unique_ptr
+ * (for example made with gd::make_unique) can still be given to a
+ * gd::ArenaUniquePtr, like the children of the expression nodes.
+ *
+ * \see gd::ArenaUniquePtr
+ * \ingroup Tools
+ */
+struct ArenaDeleter {
+  ArenaDeleter(){};
+  template <class T>
+  ArenaDeleter(const std::default_delete<T>&){};
+
+  template <class T>
+  void operator()(T* object) const {
+    if (object->IsAllocatedFromArena())
+      object->~T();
+    else
+      delete object;
+  }
+};
+
+/**
+ * \brief A std::unique_ptr owning an object deriving from gd::ArenaAllocated,
+ * allocated from an arena or from the heap.
+ *
+ * A std::unique_ptr can be moved into it, but not the other way around (the
+ * object could be allocated from an arena): use gd::ArenaUniquePtr to store
+ * the objects it owns.
+ *
+ * \ingroup Tools
+ */
+template <class T>
+using ArenaUniquePtr = std::unique_ptr<T, ArenaDeleter>;
+
+/**
+ * \brief Like gd::make_unique, but allocating the object from \a arena (or
+ * from the heap if \a arena is null).
+ *
+ * \ingroup Tools
+ */
+template <class T, class... Args>
+std::unique_ptr<T, ArenaDeleter> MakeArenaUnique(gd::Arena* arena,
+                                                 Args&&... args) {
+  if (!arena) return ArenaUniquePtr<T>(new T(std::forward<Args>(args)...));
+
+  T* object = new (arena->Allocate(sizeof(T), alignof(T)))
+      T(std::forward<Args>(args)...);
+  object->allocatedFromArena = true;
+  return ArenaUniquePtr<T>(object);
+}
+
+}  // namespace gd
+
+#endif  // GDCORE_ARENA_H
@@ -0,0 +1,38 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_DIRTYFLAG_H
+#define GDCORE_DIRTYFLAG_H
+
+namespace gd {
+
+/**
+ * \brief A flag telling if something was modified since it was last saved.
+ *
+ * A new flag is dirty. A copy of a flag (or a flag assigned from another one)
+ * is also dirty: copying an entity gives a new entity that was never saved.
+ *
+ * \see gd::Project::SetIncrementalSerializationEnabled
+ * \ingroup Tools
+ */
+class DirtyFlag {
+ public:
+  DirtyFlag() : dirty(true){};
+  DirtyFlag(const DirtyFlag&) : dirty(true){};
+  DirtyFlag& operator=(const DirtyFlag&) {
+    dirty = true;
+    return *this;
+  };
+
+  bool IsDirty() const { return dirty; };
+  void SetDirty(bool dirty_) { dirty = dirty_; };
+
+ private:
+  bool dirty;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_DIRTYFLAG_H
@@ -0,0 +1,77 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/InternedString.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "GDCore/String.h"
+
+namespace gd {
+
+namespace {
+template <class Entry>
+const Entry* GetEmptyEntry() {
+  static const Entry emptyEntry{"", std::hash<gd::String>()("")};
+  return &emptyEntry;
+}
+
+// Strings can be interned by multiple threads (for example when layouts are
+// unserialized in parallel). The pool is split in shards, according to the
+// hash of the strings, each with its own mutex, so that threads rarely wait
+// for each other.
+constexpr std::size_t poolShardsCount = 16;
+
+template <class Entry>
+struct PoolShard {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::unique_ptr<const Entry>> entries;
+};
+
+template <class Entry>
+PoolShard<Entry>& GetPoolShard(std::size_t hash) {
+  static PoolShard<Entry> shards[poolShardsCount];
+  return shards[hash % poolShardsCount];
+}
+}  // namespace
+
+InternedString::InternedString() : entry(GetEmptyEntry<Entry>()) {}
+
+InternedString::InternedString(const gd::String& str)
+    : entry(str.empty() ? GetEmptyEntry<Entry>() : Intern(str)) {}
+
+bool InternedString::FindInterned(const gd::String& str,
+                                  InternedString& internedString) {
+  if (str.empty()) {
+    internedString.entry = GetEmptyEntry<Entry>();
+    return true;
+  }
+
+  auto& shard = GetPoolShard<Entry>(std::hash<gd::String>()(str));
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.entries.find(str.Raw());
+  if (it == shard.entries.end()) return false;
+
+  internedString.entry = it->second.get();
+  return true;
+}
+
+const InternedString::Entry* InternedString::Intern(const gd::String& str) {
+  const std::size_t hash = std::hash<gd::String>()(str);
+  auto& shard = GetPoolShard<Entry>(hash);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& entry = shard.entries[str.Raw()];
+  if (!entry) {
+    entry.reset(new Entry{str, hash});
+  }
+
+  return entry.get();
+}
+
+}  // namespace gd
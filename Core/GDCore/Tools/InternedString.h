@@ -0,0 +1,93 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_INTERNEDSTRING_H
+#define GDCORE_INTERNEDSTRING_H
+
+#include <cstddef>
+#include <functional>
+
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief A string stored only once in a global pool, used for identifiers
+ * repeated a lot in a project (like the types of instructions, objects and
+ * behaviors).
+ *
+ * An interned string is only a pointer to the pooled string: it is copied and
+ * compared in constant time, and its hash is computed once.
+ *
+ * \note Pooled strings are never released: only intern strings coming from a
+ * limited set of values.
+ *
+ * \ingroup Tools
+ */
+class GD_CORE_API InternedString {
+ public:
+  /**
+   * \brief Construct an empty string.
+   */
+  InternedString();
+
+  /**
+   * \brief Construct an interned string, adding the string to the pool if
+   * necessary.
+   */
+  explicit InternedString(const gd::String& str);
+
+  /**
+   * \brief Find the interned string equal to \a str, without adding it to
+   * the pool.
+   *
+   * \return false if the string was never interned (so that no interned
+   * string is equal to it).
+   */
+  static bool FindInterned(const gd::String& str,
+                           InternedString& internedString);
+
+  /**
+   * \brief Return the pooled string. The reference stays valid until the end
+   * of the program.
+   */
+  const gd::String& GetString() const { return entry->string; };
+
+  /**
+   * \brief Return the hash of the string (the same as
+   * `std::hash<gd::String>`).
+   */
+  std::size_t GetHash() const { return entry->hash; };
+
+  bool operator==(const InternedString& other) const {
+    return entry == other.entry;
+  };
+  bool operator!=(const InternedString& other) const {
+    return entry != other.entry;
+  };
+
+ private:
+  struct Entry {
+    gd::String string;
+    std::size_t hash;
+  };
+
+  static const Entry* Intern(const gd::String& str);
+
+  const Entry* entry;
+};
+
+}  // namespace gd
+
+namespace std {
+template <>
+struct hash<gd::InternedString> {
+  size_t operator()(const gd::InternedString& str) const {
+    return str.GetHash();
+  }
+};
+}  // namespace std
+
+#endif  // GDCORE_INTERNEDSTRING_H
@@ -19,8 +19,15 @@
 #if defined(EMSCRIPTEN)
 // When compiling with Emscripten, use a translation function that is calling a
 // JS method on the module, so that an external translation library can be used.
+// Translations are cached in a catalog, where strings are searched with a hash
+// computed at compile time, so that the JS method is called only once for each
+// string.
+
+#include <cstdint>
+#include <type_traits>
 
 #include "GDCore/String.h"
+#include "GDCore/Tools/TranslationCatalog.h"
 #if defined(_)
 #undef _
 #endif
@@ -29,7 +36,13 @@ namespace gd {
 gd::String GetTranslation(const char* str);
 }
 
-#define _(s) gd::GetTranslation(u8##s)
+// The hash is used as a template argument so that it's always computed at
+// compile time.
+#define _(s)                                                              \
+  gd::TranslationCatalog::Get().GetTranslation(                           \
+      std::integral_constant<std::uint64_t,                               \
+                             gd::TranslationCatalog::Hash(u8##s)>::value, \
+      u8##s)
 
 #else
 // When compiling without Emscripten,
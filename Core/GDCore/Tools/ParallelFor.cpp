@@ -0,0 +1,57 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/ParallelFor.h"
+
+#include <algorithm>
+#if !defined(EMSCRIPTEN)
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace gd {
+
+void ParallelFor(std::size_t count,
+                 std::size_t threadsCount,
+                 const std::function<void(std::size_t)>& function) {
+#if !defined(EMSCRIPTEN)
+  threadsCount = std::min(threadsCount, count);
+  if (threadsCount > 1) {
+    std::atomic<std::size_t> nextIndex(0);
+    std::exception_ptr firstException;
+    std::mutex exceptionMutex;
+
+    // Indices are distributed one by one, as the work for each of them can
+    // be very different (think of a small and a huge layout).
+    auto work = [&]() {
+      for (std::size_t index = nextIndex++; index < count;
+           index = nextIndex++) {
+        try {
+          function(index);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(exceptionMutex);
+          if (!firstException) firstException = std::current_exception();
+        }
+      }
+    };
+
+    // The calling thread is one of the workers.
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < threadsCount; ++i) threads.emplace_back(work);
+    work();
+    for (auto& thread : threads) thread.join();
+
+    if (firstException) std::rethrow_exception(firstException);
+    return;
+  }
+#endif
+
+  for (std::size_t index = 0; index < count; ++index) function(index);
+}
+
+}  // namespace gd
@@ -0,0 +1,33 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_PARALLELFOR_H
+#define GDCORE_PARALLELFOR_H
+#include <cstddef>
+#include <functional>
+
+namespace gd {
+
+/**
+ * \brief Call \a function for each index from 0 to \a count - 1, using up to
+ * \a threadsCount threads.
+ *
+ * Each index is processed exactly once, but in no particular order: the
+ * function must only modify data owned by the index it's called with.
+ * The call returns when all the indices are processed. If the function throws,
+ * the first exception is rethrown once all the threads are finished.
+ *
+ * \note When compiled with Emscripten, or if \a threadsCount is 1 or less,
+ * indices are processed in order, on the calling thread.
+ *
+ * \ingroup Tools
+ */
+void GD_CORE_API ParallelFor(std::size_t count,
+                             std::size_t threadsCount,
+                             const std::function<void(std::size_t)>& function);
+
+}  // namespace gd
+
+#endif  // GDCORE_PARALLELFOR_H
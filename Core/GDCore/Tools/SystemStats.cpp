@@ -48,4 +48,28 @@ size_t SystemStats::GetUsedVirtualMemory() {
 #endif
 }
 
+size_t SystemStats::GetPeakUsedPhysicalMemory() {
+#if defined(LINUX)
+  FILE* file = fopen("/proc/self/status", "r");
+  if (file == NULL) return 0;
+
+  size_t result = 0;
+  char line[128];
+  while (fgets(line, 128, file) != NULL) {
+    if (strncmp(line, "VmHWM:", 6) == 0) {
+      result = strtoull(line + 6, NULL, 10);
+      break;
+    }
+  }
+  fclose(file);
+  return result;
+#elif defined(WINDOWS)
+  PROCESS_MEMORY_COUNTERS pmc;
+  GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+  return pmc.PeakWorkingSetSize / 1024;
+#else
+  return 0;
+#endif
+}
+
 }  // namespace gd
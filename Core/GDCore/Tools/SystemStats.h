@@ -23,6 +23,16 @@ class GD_CORE_API SystemStats {
    */
   static size_t GetUsedVirtualMemory();
 
+  /**
+   * Return the peak physical memory (resident set size) used by the process
+   * since it started, in KB.
+   *
+   * \note This is a high-water mark for the whole process: it never decreases
+   * and can't be attributed to a single operation.
+   * @return 0 if the information is not available
+   */
+  static size_t GetPeakUsedPhysicalMemory();
+
  private:
   SystemStats(){};
   virtual ~SystemStats(){};
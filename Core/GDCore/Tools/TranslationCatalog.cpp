@@ -0,0 +1,91 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Tools/TranslationCatalog.h"
+
+#include <cstring>
+
+#include "GDCore/String.h"
+#include "GDCore/Tools/Localization.h"
+
+namespace gd {
+
+TranslationCatalog::TranslationCatalog(TranslationFunction translate_)
+    : translate(translate_), translationsGeneration(0) {}
+
+TranslationCatalog& TranslationCatalog::Get() {
+#if defined(EMSCRIPTEN)
+  static TranslationCatalog catalog(&gd::GetTranslation);
+#else
+  static TranslationCatalog catalog(
+      [](const char* str) { return gd::String(str); });
+#endif
+  return catalog;
+}
+
+gd::String TranslationCatalog::GetTranslation(std::uint64_t hash,
+                                              const char* str) {
+  TranslationFunction translateString;
+  std::size_t generation;
+  {
+    std::lock_guard<std::mutex> lock(translationsMutex);
+    auto it = translations.find(hash);
+    if (it != translations.end()) {
+      if (std::strcmp(it->second.str.c_str(), str) == 0)
+        return it->second.translation;
+
+      // Another string has the same hash: very unlikely, but still supported.
+      auto collidingIt = collidingTranslations.find(str);
+      if (collidingIt != collidingTranslations.end())
+        return collidingIt->second;
+    }
+
+    translateString = translate;
+    generation = translationsGeneration;
+  }
+
+  // The translation function can be slow (it calls JavaScript in
+  // libGD.js), so other threads are not blocked while it's called.
+  gd::String translation = translateString(str);
+
+  std::lock_guard<std::mutex> lock(translationsMutex);
+  // Don't keep a translation made before the catalog was cleared, as it can
+  // be in the previous language.
+  if (generation != translationsGeneration) return translation;
+
+  auto it = translations.find(hash);
+  if (it == translations.end()) {
+    Entry& entry = translations[hash];
+    entry.str = str;
+    entry.translation = translation;
+  } else if (std::strcmp(it->second.str.c_str(), str) != 0) {
+    collidingTranslations.emplace(str, translation);
+  }
+
+  return translation;
+}
+
+void TranslationCatalog::SetTranslationFunction(
+    TranslationFunction translate_) {
+  std::lock_guard<std::mutex> lock(translationsMutex);
+  translate = translate_;
+  translations.clear();
+  collidingTranslations.clear();
+  translationsGeneration++;
+}
+
+void TranslationCatalog::Clear() {
+  std::lock_guard<std::mutex> lock(translationsMutex);
+  translations.clear();
+  collidingTranslations.clear();
+  translationsGeneration++;
+}
+
+std::size_t TranslationCatalog::GetTranslationsCount() const {
+  std::lock_guard<std::mutex> lock(translationsMutex);
+  return translations.size() + collidingTranslations.size();
+}
+
+}  // namespace gd
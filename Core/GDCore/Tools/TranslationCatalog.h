@@ -0,0 +1,142 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_TRANSLATIONCATALOG_H
+#define GDCORE_TRANSLATIONCATALOG_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief A cache of the translations of the strings marked with the
+ * underscore macro (see GDCore/Tools/Localization.h).
+ *
+ * Strings are found using a hash of the untranslated string, computed at
+ * compile time for literals. Each string is translated only once (by the
+ * translation function of the catalog), and the translation is then kept
+ * until the catalog is cleared (for example when the language is changed).
+ *
+ * \ingroup Tools
+ */
+class GD_CORE_API TranslationCatalog {
+ public:
+  using TranslationFunction = std::function<gd::String(const char*)>;
+
+  /**
+   * \brief Create a catalog translating strings with the given function.
+   */
+  explicit TranslationCatalog(TranslationFunction translate);
+
+  /**
+   * \brief Return the catalog used by the underscore macro.
+   */
+  static TranslationCatalog& Get();
+
+  /**
+   * \brief Return the hash of a string (FNV-1a), used to search the
+   * translation of the string in the catalog.
+   *
+   * \note The function is constexpr so that the hash of literals can be
+   * computed at compile time (the underscore macro forces it). Characters are
+   * hashed by chunks, so that long strings don't exceed the recursion depth
+   * allowed in constant expressions.
+   */
+  static constexpr std::uint64_t Hash(
+      const char* str, std::uint64_t hash = 14695981039346656037ull) {
+    return HashChunk(str, hash, GetChunkSize(str));
+  }
+
+  /**
+   * \brief Return the translation of the string, translating it if it's not
+   * in the catalog yet.
+   *
+   * The translation function is called without holding the lock of the
+   * catalog, so it can be called by multiple threads for the same string.
+   *
+   * \param hash The hash of the string, as returned by Hash.
+   * \param str The string to translate.
+   * \return A copy of the translation, as the catalog can be cleared at any
+   * time (for example by another thread when the language is changed).
+   */
+  gd::String GetTranslation(std::uint64_t hash, const char* str);
+
+  /**
+   * \brief Change the function used to translate strings. The catalog is
+   * cleared.
+   */
+  void SetTranslationFunction(TranslationFunction translate);
+
+  /**
+   * \brief Remove all the translations from the catalog, so that strings are
+   * translated again when next requested.
+   */
+  void Clear();
+
+  /**
+   * \brief Return the number of strings translated in the catalog.
+   */
+  std::size_t GetTranslationsCount() const;
+
+ private:
+  static constexpr std::size_t hashChunkSize = 16;
+
+  static constexpr std::size_t GetChunkSize(const char* str,
+                                            std::size_t size = 0) {
+    return size < hashChunkSize && str[size] ? GetChunkSize(str, size + 1)
+                                             : size;
+  }
+
+  static constexpr std::uint64_t HashChars(const char* str,
+                                           std::size_t count,
+                                           std::uint64_t hash) {
+    return count ? HashChars(str + 1,
+                             count - 1,
+                             (hash ^ static_cast<unsigned char>(*str)) *
+                                 1099511628211ull)
+                 : hash;
+  }
+
+  static constexpr std::uint64_t HashChunk(const char* str,
+                                           std::uint64_t hash,
+                                           std::size_t chunkSize) {
+    return chunkSize ? Hash(str + chunkSize, HashChars(str, chunkSize, hash))
+                     : hash;
+  }
+
+  struct Entry {
+    std::string str;
+    gd::String translation;
+  };
+
+  /**
+   * \brief Hash the already hashed keys of the table.
+   */
+  struct IdentityHash {
+    std::size_t operator()(std::uint64_t hash) const {
+      return static_cast<std::size_t>(hash);
+    }
+  };
+
+  TranslationFunction translate;
+  std::unordered_map<std::uint64_t, Entry, IdentityHash> translations;
+  std::unordered_map<std::string, gd::String>
+      collidingTranslations;  ///< Strings having the hash of another string.
+  std::size_t translationsGeneration;  ///< Incremented when the catalog is
+                                       ///< cleared.
+  mutable std::mutex translationsMutex;  ///< Strings can be translated by
+                                         ///< multiple threads (when extensions
+                                         ///< are created lazily).
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_TRANSLATIONCATALOG_H
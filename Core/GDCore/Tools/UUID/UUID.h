@@ -7,6 +7,8 @@
 #ifndef GDCORE_TOOLS_UUID_UUID_H
 #define GDCORE_TOOLS_UUID_UUID_H
 
+#include <mutex>
+
 #include "GDCore/String.h"
 #include "sole.h"
 
@@ -16,7 +18,16 @@ namespace UUID {
 /**
  * Generate a random UUID v4
  */
-inline gd::String MakeUuid4() { return gd::String::From(sole::uuid4()); }
+inline gd::String MakeUuid4() {
+  // sole::uuid4 uses a random device shared by all threads.
+  static std::mutex mutex;
+  sole::uuid uuid;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uuid = sole::uuid4();
+  }
+  return gd::String::From(uuid);
+}
 
 }  // namespace UUID
 }  // namespace gd
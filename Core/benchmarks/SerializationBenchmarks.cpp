@@ -0,0 +1,356 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the loading, saving and code generation of large
+ * synthetic projects.
+ *
+ * Usage: GDCore_benchmarks [--scenes=N] [--objects=N] [--instances=N]
+ * [--events=N] [--variables=N] [--runs=N] [--output=results.json]
+ *
+ * Results are written as JSON (on the standard output, or in the file given
+ * with --output), so that they can be compared between releases.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Extensions/Builtin/AllBuiltinExtensions.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/Variable.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCore/String.h"
+#include "GDCore/Tools/SystemStats.h"
+
+namespace {
+std::atomic<std::size_t> allocationsCount(0);
+}
+
+// Count the allocations done by the process (including the ones done by
+// GDCore), to track the allocations done by each benchmark.
+void* operator new(std::size_t size) {
+  allocationsCount++;
+  void* pointer = std::malloc(size ? size : 1);
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+namespace {
+
+/**
+ * \brief The size of the synthetic project used for the benchmarks.
+ */
+struct ProjectSize {
+  std::size_t scenes = 10;
+  std::size_t objects = 50;     ///< Objects per scene.
+  std::size_t instances = 1000; ///< Instances per scene.
+  std::size_t events = 100;     ///< Events per scene.
+  std::size_t variables = 50;   ///< Variables per scene.
+};
+
+void SetupPlatform(gd::Platform& platform) {
+  platform.EnableExtensionLoadingLogs(false);
+
+  auto spriteExtension = std::make_shared<gd::PlatformExtension>();
+  gd::BuiltinExtensionsImplementer::ImplementsSpriteExtension(
+      *spriteExtension);
+  platform.AddExtension(spriteExtension);
+
+  auto commonInstructionsExtension = std::make_shared<gd::PlatformExtension>();
+  gd::BuiltinExtensionsImplementer::ImplementsCommonInstructionsExtension(
+      *commonInstructionsExtension);
+  platform.AddExtension(commonInstructionsExtension);
+}
+
+/**
+ * \brief Fill the project with scenes containing objects, variables,
+ * instances and events.
+ */
+void GenerateProject(gd::Project& project, const ProjectSize& size) {
+  for (std::size_t i = 0; i < size.scenes; ++i) {
+    gd::Layout& layout =
+        project.InsertNewLayout("Scene" + gd::String::From(i), i);
+
+    for (std::size_t j = 0; j < size.objects; ++j) {
+      layout.InsertNewObject(
+          project, "Sprite", "MyObject" + gd::String::From(j), j);
+    }
+    for (std::size_t j = 0; j < size.variables; ++j) {
+      layout.GetVariables()
+          .InsertNew("MyVariable" + gd::String::From(j), j)
+          .SetValue(j);
+    }
+    for (std::size_t j = 0; j < size.instances; ++j) {
+      gd::InitialInstance& instance =
+          layout.GetInitialInstances().InsertNewInitialInstance();
+      if (size.objects)
+        instance.SetObjectName("MyObject" +
+                               gd::String::From(j % size.objects));
+      instance.SetX(j * 1.5);
+      instance.SetY(j * 2.5);
+    }
+    for (std::size_t j = 0; j < size.events; ++j) {
+      gd::StandardEvent event;
+      gd::String variableName =
+          "MyVariable" + gd::String::From(size.variables ? j % size.variables
+                                                         : 0);
+      event.GetConditions().Insert(gd::Instruction(
+          "VarScene",
+          {gd::Expression(variableName),
+           gd::Expression("="),
+           gd::Expression(gd::String::From(j))}));
+      event.GetActions().Insert(gd::Instruction(
+          "ModVarScene",
+          {gd::Expression(variableName),
+           gd::Expression("+"),
+           gd::Expression("MyVariable + 1 * TimeDelta()")}));
+      layout.GetEvents().InsertEvent(event);
+    }
+  }
+}
+
+/**
+ * \brief Generate the texts of a text-heavy project (dialogues and JSON
+ * stored in strings), to be converted to code.
+ */
+std::vector<gd::String> GenerateTexts(const ProjectSize& size) {
+  std::vector<gd::String> texts;
+  for (std::size_t i = 0; i < size.scenes * size.events; ++i) {
+    texts.push_back(
+        "Hello traveler! The road to the castle is long and dangerous. Take "
+        "this sword, and come back when you have found the three keys of the "
+        "forest. Good luck, my friend. " +
+        gd::String::From(i));
+    texts.push_back("{\"character\": \"Guard\", \"line\": " +
+                    gd::String::From(i) +
+                    ", \"text\": \"Halt!\\nWho goes there?\", "
+                    "\"choices\": [\"A friend\", \"Nobody\"]}");
+    texts.push_back(
+        u8"Bonjour voyageur ! La route vers le château est longue et "
+        u8"dangereuse. Prends cette épée, et reviens quand tu auras trouvé les "
+        u8"trois clés de la forêt. Bonne chance, mon ami ! " +
+        gd::String::From(i));
+  }
+
+  return texts;
+}
+
+/**
+ * \brief Run a benchmark and add its results to the results element.
+ */
+void DoBenchmark(gd::SerializerElement& resultsElement,
+                 const gd::String& benchmarkName,
+                 std::size_t runsCount,
+                 const std::function<void()>& func) {
+  std::vector<long long> timesInMicroseconds;
+  std::size_t allocationsCountBefore = allocationsCount;
+
+  for (std::size_t i = 0; i < runsCount; i++) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+
+    timesInMicroseconds.push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+            .count());
+  }
+
+  double averageTime = 0;
+  for (auto time : timesInMicroseconds) averageTime += time;
+  averageTime /= runsCount;
+
+  gd::SerializerElement& resultElement = resultsElement.AddChild("result");
+  resultElement.SetAttribute("name", benchmarkName);
+  resultElement.SetAttribute("runs", (int)runsCount);
+  resultElement.SetAttribute("averageMicroseconds", averageTime);
+  resultElement.SetAttribute(
+      "minMicroseconds",
+      (double)*std::min_element(timesInMicroseconds.begin(),
+                                timesInMicroseconds.end()));
+  resultElement.SetAttribute(
+      "averageAllocations",
+      (double)(allocationsCount - allocationsCountBefore) / runsCount);
+  // The peak is process-wide: it includes the memory used by the project
+  // generation and by the previous benchmarks.
+  resultElement.SetAttribute(
+      "processPeakUsedPhysicalMemoryKB",
+      (double)gd::SystemStats::GetPeakUsedPhysicalMemory());
+
+  std::cerr << benchmarkName << " benchmark (" << runsCount
+            << " runs): " << averageTime << " microseconds" << std::endl;
+}
+
+bool ReadOption(const gd::String& argument,
+                const gd::String& name,
+                gd::String& value) {
+  gd::String prefix = "--" + name + "=";
+  if (argument.find(prefix) != 0) return false;
+
+  value = argument.substr(prefix.size());
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  ProjectSize size;
+  std::size_t runsCount = 5;
+  gd::String outputFile;
+
+  for (int i = 1; i < argc; ++i) {
+    gd::String argument = argv[i];
+    gd::String value;
+    if (ReadOption(argument, "scenes", value))
+      size.scenes = value.To<std::size_t>();
+    else if (ReadOption(argument, "objects", value))
+      size.objects = value.To<std::size_t>();
+    else if (ReadOption(argument, "instances", value))
+      size.instances = value.To<std::size_t>();
+    else if (ReadOption(argument, "events", value))
+      size.events = value.To<std::size_t>();
+    else if (ReadOption(argument, "variables", value))
+      size.variables = value.To<std::size_t>();
+    else if (ReadOption(argument, "runs", value))
+      runsCount = std::max<std::size_t>(1, value.To<std::size_t>());
+    else if (ReadOption(argument, "output", value))
+      outputFile = value;
+    else {
+      std::cerr << "Unknown argument: " << argument << std::endl;
+      return 1;
+    }
+  }
+
+  gd::Platform platform;
+  SetupPlatform(platform);
+
+  gd::Project project;
+  project.AddPlatform(platform);
+  GenerateProject(project, size);
+
+  gd::SerializerElement benchmarksElement;
+  gd::SerializerElement& projectSizeElement =
+      benchmarksElement.AddChild("projectSize");
+  projectSizeElement.SetAttribute("scenes", (int)size.scenes);
+  projectSizeElement.SetAttribute("objects", (int)size.objects);
+  projectSizeElement.SetAttribute("instances", (int)size.instances);
+  projectSizeElement.SetAttribute("events", (int)size.events);
+  projectSizeElement.SetAttribute("variables", (int)size.variables);
+  gd::SerializerElement& resultsElement =
+      benchmarksElement.AddChild("results");
+  resultsElement.ConsiderAsArrayOf("result");
+
+  gd::SerializerElement projectElement;
+  DoBenchmark(resultsElement, "Project::SerializeTo", runsCount, [&]() {
+    projectElement = gd::SerializerElement();
+    project.SerializeTo(projectElement);
+  });
+
+  gd::String json;
+  DoBenchmark(resultsElement, "Serializer::ToJSON", runsCount, [&]() {
+    json = gd::Serializer::ToJSON(projectElement);
+  });
+  benchmarksElement.SetAttribute("projectJSONSize", (int)json.Raw().size());
+
+  DoBenchmark(resultsElement, "Serializer::FromJSON", runsCount, [&]() {
+    gd::SerializerElement element;
+    gd::String errorMessage;
+    if (!gd::Serializer::FromJSON(
+            element, json.c_str(), json.Raw().size(), errorMessage))
+      std::cerr << "Unable to read the project JSON: " << errorMessage
+                << std::endl;
+  });
+
+  std::string binary;
+  DoBenchmark(resultsElement, "Serializer::ToBinary", runsCount, [&]() {
+    binary = gd::Serializer::ToBinary(projectElement);
+  });
+  benchmarksElement.SetAttribute("projectBinarySize", (int)binary.size());
+
+  DoBenchmark(resultsElement, "Serializer::FromBinary", runsCount, [&]() {
+    gd::SerializerElement element;
+    gd::String errorMessage;
+    if (!gd::Serializer::FromBinary(element, binary, errorMessage))
+      std::cerr << "Unable to read the project binary snapshot: "
+                << errorMessage << std::endl;
+  });
+
+  DoBenchmark(resultsElement, "Project::UnserializeFrom", runsCount, [&]() {
+    gd::Project readProject;
+    readProject.AddPlatform(platform);
+    readProject.UnserializeFrom(projectElement);
+  });
+
+  std::vector<gd::String> texts = GenerateTexts(size);
+  DoBenchmark(resultsElement,
+              "EventsCodeGenerator::ConvertToStringExplicit",
+              runsCount,
+              [&]() {
+                std::size_t codeSize = 0;
+                for (const auto& text : texts)
+                  codeSize +=
+                      gd::EventsCodeGenerator::ConvertToStringExplicit(text)
+                          .Raw()
+                          .size();
+                if (!codeSize) std::cerr << "No code generated" << std::endl;
+              });
+
+  std::vector<std::string> utf8Texts;
+  std::size_t utf8TextsSize = 0;
+  for (const auto& text : texts) {
+    utf8Texts.push_back(text.Raw());
+    utf8TextsSize += text.Raw().size();
+  }
+  benchmarksElement.SetAttribute("textsSize", (int)utf8TextsSize);
+  DoBenchmark(resultsElement,
+              "String::FromUTF8 and String::ReplaceInvalid",
+              runsCount,
+              [&]() {
+                std::size_t length = 0;
+                for (const auto& utf8Text : utf8Texts)
+                  length +=
+                      gd::String::FromUTF8(utf8Text).ReplaceInvalid().size();
+                if (!length) std::cerr << "No text read" << std::endl;
+              });
+  DoBenchmark(resultsElement, "String::ToUTF32", runsCount, [&]() {
+    std::size_t length = 0;
+    for (const auto& text : texts) length += text.ToUTF32().size();
+    if (!length) std::cerr << "No text converted" << std::endl;
+  });
+
+  gd::String results = gd::Serializer::ToJSON(benchmarksElement);
+  if (outputFile.empty()) {
+    std::cout << results << std::endl;
+  } else {
+    std::ofstream file(outputFile.c_str());
+    file << results << std::endl;
+    if (!file) {
+      std::cerr << "Unable to write the results in " << outputFile
+                << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
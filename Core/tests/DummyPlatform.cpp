@@ -3,6 +3,8 @@
  * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
  * reserved. This project is released under the MIT License.
  */
+#include <cmath>
+
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/IDE/Events/ExpressionValidator.h"
@@ -363,6 +365,10 @@ void SetupProjectWithDummyPlatform(gd::Project& project,
   extension->AddStrExpression("ToString", "ToString", "", "", "")
       .AddParameter("expression", "Number to convert to string")
       .SetFunctionName("toString");
+  extension->AddExpression("Floor", "Floor", "", "", "")
+      .AddParameter("expression", "Number to round down")
+      .SetFunctionName("Math.floor")
+      .SetPure([](double number) { return std::floor(number); });
   extension
       ->AddExpression("MouseX",
                       _("Cursor X position"),
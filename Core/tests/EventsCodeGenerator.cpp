@@ -8,6 +8,7 @@
  */
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 #include <memory>
+#include <vector>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Project/Layout.h"
@@ -31,4 +32,31 @@ TEST_CASE("EventsCodeGenerator", "[common][events]") {
     REQUIRE(codeGenerator.ConvertToString("{\"hello\":\r\n\"world \\\" \"}") ==
             "{\\\"hello\\\":\\r\\n\\\"world \\\\\\\" \\\"}");
   }
+  SECTION("Conversion of long strings to code") {
+    // Characters to escape at any position, in strings longer than the
+    // blocks of bytes checked at once.
+    gd::String text = "Lorem ipsum dolor sit amet, consectetur adipiscing";
+    for (std::size_t i = 0; i <= text.size(); ++i) {
+      for (const gd::String& character :
+           std::vector<gd::String>{"\\", "\r", "\n", "\""}) {
+        gd::String plainString = text.substr(0, i) + character + text.substr(i);
+        gd::String expected =
+            plainString.FindAndReplace("\\", "\\\\")
+                .FindAndReplace("\r", "\\r")
+                .FindAndReplace("\n", "\\n")
+                .FindAndReplace("\"", "\\\"");
+        REQUIRE(gd::EventsCodeGenerator::ConvertToString(plainString) ==
+                expected);
+        REQUIRE(gd::EventsCodeGenerator::ConvertToStringExplicit(
+                    plainString) == "\"" + expected + "\"");
+      }
+    }
+
+    REQUIRE(gd::EventsCodeGenerator::ConvertToString(text) == text);
+    REQUIRE(gd::EventsCodeGenerator::ConvertToString("") == "");
+    REQUIRE(gd::EventsCodeGenerator::ConvertToStringExplicit("") == "\"\"");
+    REQUIRE(gd::EventsCodeGenerator::ConvertToStringExplicit(
+                u8"Ça va ? «\"Très\" bien»\n😀\\") ==
+            u8"\"Ça va ? «\\\"Très\\\" bien»\\n😀\\\\\"");
+  }
 }
@@ -101,7 +101,7 @@ TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
 
       REQUIRE(node);
       node->Visit(expressionCodeGenerator);
-      REQUIRE(expressionCodeGenerator.GetOutput() == "\"hello\" + \"world\"");
+      REQUIRE(expressionCodeGenerator.GetOutput() == "\"helloworld\"");
     }
     {
       auto node = parser.ParseExpression(
@@ -177,7 +177,75 @@ TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
                                                           context);
       REQUIRE(node);
       node->Visit(expressionCodeGenerator);
-      REQUIRE(expressionCodeGenerator.GetOutput() == "12.5 + -(2.) / (0.3)");
+      REQUIRE(expressionCodeGenerator.GetOutput() == "5.833333333333333");
+    }
+  }
+
+  SECTION("Constant folding") {
+    auto generate = [&](const gd::String &expression) {
+      auto node = parser.ParseExpression(expression);
+      gd::ExpressionCodeGenerator expressionCodeGenerator("number",
+                                                          "",
+                                                          codeGenerator,
+                                                          context);
+      REQUIRE(node);
+      node->Visit(expressionCodeGenerator);
+      return expressionCodeGenerator.GetOutput();
+    };
+
+    SECTION("Constant operations") {
+      REQUIRE(generate("1 + 2 * 3") == "7");
+      REQUIRE(generate("(1 + 2) * 3") == "9");
+      REQUIRE(generate("0.1 + 0.2") == "0.30000000000000004");
+      REQUIRE(generate("1 / 3") == "0.3333333333333333");
+      REQUIRE(generate("2 - 5") == "(-3)");
+      REQUIRE(generate("-(1 + 1)") == "(-2)");
+      REQUIRE(generate("(12)") == "(12)");
+      REQUIRE(generate("\"a\" + \"b\" + \"c\"") == "\"abc\"");
+    }
+    SECTION("Operations are computed from left to right") {
+      REQUIRE(generate("10 - 5 + 2") == "7");
+      REQUIRE(generate("10 - 5 - 2") == "3");
+      REQUIRE(generate("8 / 4 / 2") == "1");
+    }
+    SECTION("Constant beginning of a chain of operations") {
+      REQUIRE(generate("1 + 2 + MySceneVariable + 3") ==
+              "3 + getAnyVariable(MySceneVariable).getAsNumber() + 3");
+      REQUIRE(generate("1 + MySceneVariable + 2") ==
+              "1 + getAnyVariable(MySceneVariable).getAsNumber() + 2");
+      REQUIRE(generate("MySceneVariable + 1 + 2") ==
+              "getAnyVariable(MySceneVariable).getAsNumber() + 1 + 2");
+      REQUIRE(generate("MySceneVariable * (2 + 3)") ==
+              "getAnyVariable(MySceneVariable).getAsNumber() * 5");
+    }
+    SECTION("Operations without effect") {
+      REQUIRE(generate("MySceneVariable * 1") ==
+              "getAnyVariable(MySceneVariable).getAsNumber()");
+      REQUIRE(generate("1 * MySceneVariable") ==
+              "getAnyVariable(MySceneVariable).getAsNumber()");
+      REQUIRE(generate("MySceneVariable / (3 - 2)") ==
+              "getAnyVariable(MySceneVariable).getAsNumber()");
+      REQUIRE(generate("MySceneVariable - 0 + 1") ==
+              "getAnyVariable(MySceneVariable).getAsNumber() + 1");
+      // Adding 0 would change -0 to 0, so it's kept.
+      REQUIRE(generate("MySceneVariable + 0") ==
+              "getAnyVariable(MySceneVariable).getAsNumber() + 0");
+      REQUIRE(generate("1 / MySceneVariable") ==
+              "1 / getAnyVariable(MySceneVariable).getAsNumber()");
+    }
+    SECTION("Operations not computed") {
+      // Non finite results are left to the generated code.
+      REQUIRE(generate("1 / 0") == "1 / 0");
+      REQUIRE(generate("1 / 0 + 1") == "1 / 0 + 1");
+      // Strings and numbers are never mixed.
+      REQUIRE(generate("\"a\" + 1") == "\"a\" + 1");
+    }
+    SECTION("Pure functions") {
+      REQUIRE(generate("MyExtension::Floor(2.5 * 3)") == "7");
+      REQUIRE(generate("MyExtension::Floor(-0.5)") == "(-1)");
+      REQUIRE(generate("MyExtension::Floor(MySceneVariable)") ==
+              "Math.floor(getAnyVariable(MySceneVariable).getAsNumber())");
+      REQUIRE(generate("MyExtension::ToString(2 + 3)") == "toString(5)");
     }
   }
 
@@ -259,7 +327,7 @@ TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
       REQUIRE(node);
       node->Visit(expressionCodeGenerator);
       REQUIRE(expressionCodeGenerator.GetOutput() ==
-              "getCursorX(\"\", \"layer1\", 2 + 2)");
+              "getCursorX(\"\", \"layer1\", 4)");
       // (first argument is the currentScene)
     }
     SECTION("with last optional parameter omit") {
@@ -1059,7 +1127,7 @@ TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
       REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
                   codeGenerator, context, "variable", "MySceneVariable[ \"hello\" + "
             "\"world\" ]", "")
-              == "getAnyVariable(MySceneVariable).getChild(\"hello\" + \"world\")");
+              == "getAnyVariable(MySceneVariable).getChild(\"helloworld\")");
     }
     SECTION("bracket access (using a string object variable inside)") {
       REQUIRE(gd::ExpressionCodeGenerator::GenerateExpressionCode(
@@ -1236,7 +1304,7 @@ TEST_CASE("ExpressionCodeGenerator", "[common][events]") {
         node->Visit(expressionCodeGenerator);
         REQUIRE(expressionCodeGenerator.GetOutput() ==
                 "returnVariable(getLayoutVariable(myVariable).getChild("
-                "\"hello\" + \"world\").getChild(\"child2\"))");
+                "\"helloworld\").getChild(\"child2\"))");
       }
       SECTION("bracket access with nested variable") {
         auto node = parser.ParseExpression(
@@ -6,8 +6,12 @@
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
 
 #include "DummyPlatform.h"
+#include "GDCore/Events/Expression.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodeSerializer.h"
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/IDE/Events/ExpressionNodeLocationFinder.h"
 #include "GDCore/IDE/Events/ExpressionValidator.h"
 #include "GDCore/IDE/Events/ExpressionTypeFinder.h"
 #include "GDCore/IDE/Events/ExpressionVariableOwnerFinder.h"
@@ -16,6 +20,8 @@
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/ProjectScopedContainers.h"
 #include "GDCore/Project/PropertiesContainer.h"
+#include "GDCore/Tools/Arena.h"
+#include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
 
 TEST_CASE("ExpressionParser2", "[common][events]") {
@@ -3494,8 +3500,8 @@ TEST_CASE("ExpressionParser2", "[common][events]") {
 
   SECTION("Fuzzy/random tests") {
     {
-      auto testExpression = [&parser, platform, projectScopedContainers](const gd::String &expression) {
-        auto testExpressionWithType = [&parser, platform, projectScopedContainers,
+      auto testExpression = [&parser, &platform, projectScopedContainers](const gd::String &expression) {
+        auto testExpressionWithType = [&parser, &platform, projectScopedContainers,
                                        &expression](const gd::String &type) {
           auto node = parser.ParseExpression(expression);
           REQUIRE(node != nullptr);
@@ -3938,4 +3944,270 @@ TEST_CASE("ExpressionParser2", "[common][events]") {
       }
     }
   }
+
+  SECTION("Allocation from an arena") {
+    gd::Arena arena(256);
+    {
+      auto node = parser.ParseExpression("1 + MySceneStructureVariable.MyChild", &arena);
+      REQUIRE(node != nullptr);
+      REQUIRE(arena.GetAllocatedSize() > 0);
+      REQUIRE(arena.GetBlocksCount() > 1);
+      REQUIRE(node->IsAllocatedFromArena());
+
+      auto &operatorNode = dynamic_cast<gd::OperatorNode &>(*node);
+      REQUIRE(operatorNode.op == '+');
+      auto &identifierNode =
+          dynamic_cast<gd::IdentifierNode &>(*operatorNode.rightHandSide);
+      REQUIRE(identifierNode.identifierName == "MySceneStructureVariable");
+      REQUIRE(identifierNode.childIdentifierName == "MyChild");
+
+      gd::ExpressionValidator validator(platform, projectScopedContainers, "number");
+      node->Visit(validator);
+      REQUIRE(validator.GetFatalErrors().size() == 0);
+    }
+    {
+      std::size_t allocatedSize = arena.GetAllocatedSize();
+      auto node = parser.ParseExpression("1 +", &arena);
+      REQUIRE(node != nullptr);
+      REQUIRE(arena.GetAllocatedSize() > allocatedSize);
+
+      gd::ExpressionValidator validator(platform, projectScopedContainers, "number");
+      node->Visit(validator);
+      REQUIRE(validator.GetFatalErrors().size() == 1);
+    }
+    {
+      // Nodes are still allocated from the heap when no arena is given.
+      std::size_t allocatedSize = arena.GetAllocatedSize();
+      auto node = parser.ParseExpression("1 + 2");
+      REQUIRE(node != nullptr);
+      REQUIRE(arena.GetAllocatedSize() == allocatedSize);
+      REQUIRE_FALSE(node->IsAllocatedFromArena());
+
+      // Nodes made with gd::make_unique can still be given to a tree.
+      auto &operatorNode = dynamic_cast<gd::OperatorNode &>(*node);
+      operatorNode.rightHandSide = gd::make_unique<gd::NumberNode>("3");
+      REQUIRE(gd::ExpressionParser2NodePrinter::PrintNode(*node) == "1 + 3");
+    }
+  }
+
+  SECTION("Trees shared by expressions") {
+    gd::Expression expression1("MySceneVariable + 1");
+    gd::Expression expression2("MySceneVariable + 1");
+    gd::Expression otherExpression("MySceneVariable + 2");
+    REQUIRE(expression1.GetRootNode() != nullptr);
+    REQUIRE(expression1.GetRootNode() == expression2.GetRootNode());
+    REQUIRE(expression1.GetRootNode() != otherExpression.GetRootNode());
+
+    gd::Expression copiedExpression(expression1);
+    REQUIRE(copiedExpression.GetRootNode() == expression1.GetRootNode());
+
+    copiedExpression = otherExpression;
+    REQUIRE(copiedExpression.GetRootNode() == otherExpression.GetRootNode());
+    REQUIRE(dynamic_cast<gd::OperatorNode &>(*copiedExpression.GetRootNode())
+                .op == '+');
+  }
+
+  auto getErrors = [&](gd::ExpressionNode &node) {
+    gd::ExpressionValidator validator(platform, projectScopedContainers, "number");
+    node.Visit(validator);
+    std::vector<gd::String> errors;
+    for (auto *error : validator.GetAllErrors()) {
+      errors.push_back(error->GetMessage() + " at " +
+                       gd::String::From(error->GetStartPosition()) + "-" +
+                       gd::String::From(error->GetEndPosition()));
+    }
+    return errors;
+  };
+  auto requireSameTrees = [&](gd::ExpressionNode &node,
+                              gd::ExpressionNode &expectedNode,
+                              const gd::String &expression) {
+    REQUIRE(gd::ExpressionParser2NodePrinter::PrintNode(node) ==
+            gd::ExpressionParser2NodePrinter::PrintNode(expectedNode));
+    REQUIRE(getErrors(node) == getErrors(expectedNode));
+    for (size_t position = 0; position <= expression.size(); ++position) {
+      auto *nodeAtPosition =
+          gd::ExpressionNodeLocationFinder::GetNodeAtPosition(node, position);
+      auto *expectedNodeAtPosition =
+          gd::ExpressionNodeLocationFinder::GetNodeAtPosition(expectedNode,
+                                                              position);
+      REQUIRE((nodeAtPosition == nullptr) ==
+              (expectedNodeAtPosition == nullptr));
+      if (nodeAtPosition) {
+        REQUIRE(nodeAtPosition->location.GetStartPosition() ==
+                expectedNodeAtPosition->location.GetStartPosition());
+        REQUIRE(nodeAtPosition->location.GetEndPosition() ==
+                expectedNodeAtPosition->location.GetEndPosition());
+      }
+    }
+  };
+
+  SECTION("Parsing after an edit") {
+    SECTION("Nodes outside of the edit are reused") {
+      gd::String expression =
+          "MyExtension::GetNumberWith2Params(1, \"a\") + "
+          "MySpriteObject.GetObjectNumber() * 3";
+      auto node = parser.ParseExpression(expression);
+      auto &operatorNode = dynamic_cast<gd::OperatorNode &>(*node);
+      auto *functionNode = operatorNode.leftHandSide.get();
+      auto &termNode =
+          dynamic_cast<gd::OperatorNode &>(*operatorNode.rightHandSide);
+      auto *objectFunctionNode = termNode.leftHandSide.get();
+
+      // Replace "1" by "42".
+      gd::String newExpression =
+          "MyExtension::GetNumberWith2Params(42, \"a\") + "
+          "MySpriteObject.GetObjectNumber() * 3";
+      auto newNode = parser.ParseExpressionAfterEdit(
+          newExpression, std::move(node), 34, 1, 2);
+      REQUIRE(newNode != nullptr);
+
+      auto &newOperatorNode = dynamic_cast<gd::OperatorNode &>(*newNode);
+      REQUIRE(newOperatorNode.leftHandSide.get() != functionNode);
+      auto &newTermNode =
+          dynamic_cast<gd::OperatorNode &>(*newOperatorNode.rightHandSide);
+      REQUIRE(newTermNode.leftHandSide.get() == objectFunctionNode);
+      REQUIRE(newTermNode.leftHandSide->parent == &newTermNode);
+      REQUIRE(newTermNode.leftHandSide->location.GetStartPosition() == 45);
+
+      requireSameTrees(
+          *newNode, *parser.ParseExpression(newExpression), newExpression);
+    }
+
+    SECTION("Same trees as when parsing the whole expression") {
+      std::vector<gd::String> expressions = {
+          "MyExtension::GetNumberWith2Params(1, \"a\") + MySpriteObject.GetObjectNumber() * 3",
+          "MySceneStructureVariable.MyChild + MySceneVariable[\"a\" + MyExtension::ToString(2)]",
+          "-(12 + MySpriteObject.MyBehavior::GetBehaviorNumber()) / MyExtension::MouseX(,0)",
+          "\"Hello \\\"World\" + MyExtension::ToString(3.5) + Hello World 1",
+      };
+      std::vector<gd::String> insertedTexts = {
+          "1", " ", ".", "(", ")", ",", "\"", "::", "x", "["};
+
+      for (const auto &expression : expressions) {
+        for (size_t position = 0; position <= expression.size(); ++position) {
+          std::vector<std::pair<gd::String, size_t>> edits;
+          if (position < expression.size()) {
+            edits.push_back(std::make_pair("", 1));
+          }
+          for (const auto &insertedText : insertedTexts) {
+            edits.push_back(std::make_pair(insertedText, 0));
+          }
+
+          for (const auto &edit : edits) {
+            gd::String newExpression = expression.substr(0, position) +
+                                       edit.first +
+                                       expression.substr(position + edit.second);
+            auto newNode = parser.ParseExpressionAfterEdit(
+                newExpression,
+                parser.ParseExpression(expression),
+                position,
+                edit.second,
+                edit.first.size());
+            REQUIRE(newNode != nullptr);
+            requireSameTrees(*newNode,
+                             *parser.ParseExpression(newExpression),
+                             newExpression);
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Serialization of trees") {
+    std::vector<gd::String> expressions = {
+        "MyExtension::GetNumberWith2Params(1, \"a\") + MySpriteObject.GetObjectNumber() * 3",
+        "MySceneStructureVariable.MyChild + MySceneVariable[\"a\" + MyExtension::ToString(2)].b",
+        "-(12 + MySpriteObject.MyBehavior::GetBehaviorNumber()) / MyExtension::MouseX(,0)",
+        "\"Hello \\\"World\" + MyExtension::ToString(3.5) + Hello World 1",
+        "MySpriteObject.MyBehavior:: + MySpriteObject.",
+        "",
+    };
+
+    for (const auto &expression : expressions) {
+      auto node = parser.ParseExpression(expression);
+      std::string serializedNode;
+      gd::ExpressionParser2NodeSerializer::SerializeNode(*node, serializedNode);
+
+      size_t position = 0;
+      gd::Arena arena(1024);
+      auto unserializedNode = gd::ExpressionParser2NodeSerializer::UnserializeNode(
+          serializedNode, position, &arena);
+      REQUIRE(unserializedNode != nullptr);
+      REQUIRE(position == serializedNode.size());
+      requireSameTrees(*unserializedNode, *node, expression);
+
+      std::string serializedAgain;
+      gd::ExpressionParser2NodeSerializer::SerializeNode(*unserializedNode,
+                                                         serializedAgain);
+      REQUIRE(serializedAgain == serializedNode);
+
+      // Truncated data is rejected.
+      for (size_t size = 0; size < serializedNode.size(); ++size) {
+        size_t truncatedPosition = 0;
+        REQUIRE(gd::ExpressionParser2NodeSerializer::UnserializeNode(
+                    serializedNode.substr(0, size), truncatedPosition) ==
+                nullptr);
+      }
+    }
+
+    {
+      // Trees missing a required child are rejected.
+      auto node = parser.ParseExpression("1 + MyExtension::MouseX(\"a\", 2)");
+      auto &operatorNode = dynamic_cast<gd::OperatorNode &>(*node);
+      auto &functionCallNode =
+          dynamic_cast<gd::FunctionCallNode &>(*operatorNode.rightHandSide);
+      functionCallNode.parameters[1] = nullptr;
+      std::string serializedNode;
+      gd::ExpressionParser2NodeSerializer::SerializeNode(*node, serializedNode);
+      size_t position = 0;
+      REQUIRE(gd::ExpressionParser2NodeSerializer::UnserializeNode(
+                  serializedNode, position) == nullptr);
+
+      operatorNode.rightHandSide = nullptr;
+      serializedNode.clear();
+      gd::ExpressionParser2NodeSerializer::SerializeNode(*node, serializedNode);
+      position = 0;
+      REQUIRE(gd::ExpressionParser2NodeSerializer::UnserializeNode(
+                  serializedNode, position) == nullptr);
+    }
+  }
+
+  SECTION("Trees cache") {
+    std::string cache;
+    {
+      gd::Expression expression("CachedExpressionA + \"cached\"");
+      REQUIRE(expression.GetRootNode() != nullptr);
+      cache = gd::Expression::SaveTreesCache("en");
+    }
+
+    REQUIRE_FALSE(gd::Expression::LoadTreesCache(cache, "fr"));
+    {
+      // A cache saved by another version of GDevelop is not loaded.
+      std::string otherVersionCache = cache;
+      size_t versionPosition = otherVersionCache.find(
+          gd::VersionWrapper::FullString().Raw());
+      REQUIRE(versionPosition != std::string::npos);
+      otherVersionCache[versionPosition] = 'X';
+      REQUIRE_FALSE(gd::Expression::LoadTreesCache(otherVersionCache, "en"));
+    }
+    REQUIRE_FALSE(gd::Expression::LoadTreesCache(
+        cache.substr(0, cache.size() - 1), "en"));
+    REQUIRE(gd::Expression::LoadTreesCache(cache, "en"));
+    {
+      gd::Expression expression("CachedExpressionA + \"cached\"");
+      requireSameTrees(*expression.GetRootNode(),
+                       *parser.ParseExpression(expression.GetPlainString()),
+                       expression.GetPlainString());
+    }
+
+    // Check that a loaded tree is used instead of parsing the expression.
+    size_t keyPosition = cache.find("CachedExpressionA");
+    REQUIRE(keyPosition != std::string::npos);
+    cache.replace(keyPosition, 17, "CachedExpressionB");
+    REQUIRE(gd::Expression::LoadTreesCache(cache, "en"));
+    gd::Expression expression("CachedExpressionB + \"cached\"");
+    REQUIRE(gd::ExpressionParser2NodePrinter::PrintNode(
+                *expression.GetRootNode()) ==
+            "CachedExpressionA + \"cached\"");
+  }
 }
@@ -124,4 +124,18 @@ TEST_CASE("ExpressionParser2 - Benchmarks", "[common][events]") {
           "AndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgain"));
     });
   }
+
+  SECTION("Parse long text") {
+    // Parsing time must be linear in the length of the expression, including
+    // for characters not being ASCII.
+    gd::String text = "\"";
+    for (size_t i = 0; i < 20000; i++) text += u8"é";
+    text += "\"";
+
+    doBenchmark("Long text", 10, [&]() {
+      auto node = parser.ParseExpression(text);
+      REQUIRE(node != nullptr);
+      REQUIRE(node->location.GetEndPosition() == 20002);
+    });
+  }
 }
@@ -0,0 +1,76 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering interned strings of GDevelop Core.
+ */
+#include "GDCore/Tools/InternedString.h"
+
+#include <functional>
+
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+TEST_CASE("InternedString", "[common]") {
+  SECTION("Equality") {
+    gd::InternedString sprite("Sprite");
+    gd::InternedString sameSprite(gd::String("Spr") + "ite");
+    gd::InternedString text("TextObject::Text");
+
+    REQUIRE(sprite == sameSprite);
+    REQUIRE(sprite != text);
+    REQUIRE(&sprite.GetString() == &sameSprite.GetString());
+    REQUIRE(sprite.GetString() == "Sprite");
+    REQUIRE(text.GetString() == "TextObject::Text");
+  }
+
+  SECTION("Empty string") {
+    gd::InternedString empty;
+    gd::InternedString otherEmpty("");
+
+    REQUIRE(empty == otherEmpty);
+    REQUIRE(empty.GetString().empty());
+    REQUIRE(empty != gd::InternedString("Sprite"));
+  }
+
+  SECTION("Finding an interned string") {
+    gd::InternedString found;
+    REQUIRE_FALSE(gd::InternedString::FindInterned(
+        "MyExtension::NeverInterned", found));
+
+    gd::InternedString interned("MyExtension::Interned");
+    REQUIRE(gd::InternedString::FindInterned("MyExtension::Interned", found));
+    REQUIRE(found == interned);
+    REQUIRE(gd::InternedString::FindInterned("", found));
+    REQUIRE(found == gd::InternedString());
+  }
+
+  SECTION("Hash") {
+    gd::InternedString behaviorType(
+        "PlatformBehavior::PlatformerObjectBehavior");
+    REQUIRE(behaviorType.GetHash() ==
+            std::hash<gd::String>()(
+                "PlatformBehavior::PlatformerObjectBehavior"));
+    REQUIRE(std::hash<gd::InternedString>()(behaviorType) ==
+            behaviorType.GetHash());
+    REQUIRE(gd::InternedString().GetHash() == std::hash<gd::String>()(""));
+  }
+
+  SECTION("Instructions") {
+    gd::Instruction instruction("MyExtension::DoSomething");
+    gd::Instruction otherInstruction;
+    otherInstruction.SetType("MyExtension::DoSomething");
+
+    REQUIRE(instruction.GetType() == "MyExtension::DoSomething");
+    REQUIRE(instruction.GetInternedType() ==
+            otherInstruction.GetInternedType());
+
+    otherInstruction.SetType("MyExtension::DoSomethingElse");
+    REQUIRE(otherInstruction.GetType() == "MyExtension::DoSomethingElse");
+    REQUIRE(instruction.GetInternedType() !=
+            otherInstruction.GetInternedType());
+  }
+}
@@ -0,0 +1,306 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the search of metadata of a platform.
+ */
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+
+#include <memory>
+
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+TEST_CASE("MetadataProvider", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  SECTION("Instructions") {
+    auto action = gd::MetadataProvider::GetExtensionAndActionMetadata(
+        platform, "MyExtension::DoSomething");
+    REQUIRE(action.GetExtension().GetName() == "MyExtension");
+    REQUIRE(action.GetMetadata().GetFullName() == "Do something");
+
+    // Actions of objects and behaviors.
+    REQUIRE(!gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(
+            platform, "MyExtension::SetAnimationName")));
+    REQUIRE(!gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(
+            platform, "MyExtension::BehaviorDoSomething")));
+
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(platform,
+                                                "MyExtension::Unknown")));
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetConditionMetadata(
+            platform, "MyExtension::DoSomething")));
+  }
+
+  SECTION("Objects and behaviors") {
+    REQUIRE(gd::MetadataProvider::GetExtensionAndObjectMetadata(
+                platform, "MyExtension::Sprite")
+                .GetExtension()
+                .GetName() == "MyExtension");
+    REQUIRE(gd::MetadataProvider::GetExtensionAndBehaviorMetadata(
+                platform, "MyExtension::MyBehavior")
+                .GetExtension()
+                .GetName() == "MyExtension");
+    REQUIRE(gd::MetadataProvider::IsBadObjectMetadata(
+        gd::MetadataProvider::GetObjectMetadata(platform,
+                                                "MyExtension::Unknown")));
+    REQUIRE(gd::MetadataProvider::IsBadBehaviorMetadata(
+        gd::MetadataProvider::GetBehaviorMetadata(platform,
+                                                  "MyExtension::Unknown")));
+  }
+
+  SECTION("Expressions") {
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(
+            platform, "MyExtension::GetNumber")));
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(
+            platform, "MyExtension::ToString")));
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetStrExpressionMetadata(
+            platform, "MyExtension::ToString")));
+
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "MyExtension::Sprite", "GetObjectNumber")));
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectStrExpressionMetadata(
+            platform, "MyExtension::Sprite", "GetObjectStringWith1Param")));
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetBehaviorExpressionMetadata(
+            platform,
+            "MyExtension::MyBehavior",
+            "GetBehaviorNumberWith1Param")));
+
+    // Expressions of the base object are available for all objects.
+    REQUIRE(gd::MetadataProvider::GetExtensionAndObjectExpressionMetadata(
+                platform, "MyExtension::Sprite", "GetFromBaseExpression")
+                .GetExtension()
+                .GetName() == "BuiltinObject");
+    REQUIRE(gd::MetadataProvider::GetExtensionAndObjectExpressionMetadata(
+                platform, "MyExtension::Unknown", "GetFromBaseExpression")
+                .GetExtension()
+                .GetName() == "BuiltinObject");
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "MyExtension::Sprite", "Unknown")));
+  }
+
+  SECTION("Extensions added and removed") {
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(platform,
+                                                "OtherExtension::DoMore")));
+
+    std::shared_ptr<gd::PlatformExtension> extension =
+        std::make_shared<gd::PlatformExtension>();
+    extension->SetExtensionInformation(
+        "OtherExtension", "Other extension", "", "", "");
+    extension->AddAction("DoMore", "Do more", "", "", "", "", "");
+    platform.AddExtension(extension);
+
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(
+                platform, "OtherExtension::DoMore")
+                .GetFullName() == "Do more");
+    // Metadata of other extensions are still found.
+    REQUIRE(!gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(
+            platform, "MyExtension::DoSomething")));
+
+    platform.RemoveExtension("OtherExtension");
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(platform,
+                                                "OtherExtension::DoMore")));
+  }
+
+  SECTION("Metadata declared by multiple extensions") {
+    // Builtin extensions have no namespace, so they can declare the same
+    // actions.
+    std::shared_ptr<gd::PlatformExtension> timeExtension =
+        std::make_shared<gd::PlatformExtension>();
+    timeExtension->SetExtensionInformation(
+        "BuiltinTime", "Time extension", "", "", "");
+    timeExtension->AddAction("Wait", "Wait (time)", "", "", "", "", "");
+    platform.AddExtension(timeExtension);
+
+    std::shared_ptr<gd::PlatformExtension> sceneExtension =
+        std::make_shared<gd::PlatformExtension>();
+    sceneExtension->SetExtensionInformation(
+        "BuiltinScene", "Scene extension", "", "", "");
+    sceneExtension->AddAction("Wait", "Wait (scene)", "", "", "", "", "");
+    platform.AddExtension(sceneExtension);
+
+    // The first extension declaring the action is used.
+    REQUIRE(gd::MetadataProvider::GetExtensionAndActionMetadata(platform,
+                                                                "Wait")
+                .GetExtension()
+                .GetName() == "BuiltinTime");
+
+    platform.RemoveExtension("BuiltinTime");
+    REQUIRE(gd::MetadataProvider::GetExtensionAndActionMetadata(platform,
+                                                                "Wait")
+                .GetExtension()
+                .GetName() == "BuiltinScene");
+  }
+
+  SECTION("Extensions created lazily") {
+    int createdExtensionsCount = 0;
+    platform.AddLazyExtension("LazyExtension", [&createdExtensionsCount]() {
+      createdExtensionsCount++;
+      std::shared_ptr<gd::PlatformExtension> extension =
+          std::make_shared<gd::PlatformExtension>();
+      extension->SetExtensionInformation(
+          "LazyExtension", "Lazy extension", "", "", "");
+      extension->AddAction("DoLater", "Do later", "", "", "", "", "");
+      return extension;
+    });
+
+    REQUIRE(platform.IsExtensionLoaded("LazyExtension"));
+    REQUIRE(!gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(
+            platform, "MyExtension::DoSomething")));
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(platform,
+                                                "MyExtension::Unknown")));
+    REQUIRE(createdExtensionsCount == 0);
+
+    // The extension is created when one of its types is searched.
+    REQUIRE(gd::MetadataProvider::GetExtensionAndActionMetadata(
+                platform, "LazyExtension::DoLater")
+                .GetExtension()
+                .GetName() == "LazyExtension");
+    REQUIRE(createdExtensionsCount == 1);
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(platform,
+                                                "LazyExtension::Unknown")));
+    REQUIRE(platform.GetAllPlatformExtensions().back()->GetName() ==
+            "LazyExtension");
+    REQUIRE(createdExtensionsCount == 1);
+  }
+
+  SECTION("Extensions without namespace created lazily from their types") {
+    std::vector<gd::String> createdExtensions;
+    auto addLazyExtension = [&](const gd::String& name,
+                                const gd::String& actionName) {
+      platform.AddLazyExtension(
+          name, {actionName}, [&createdExtensions, name, actionName]() {
+            createdExtensions.push_back(name);
+            std::shared_ptr<gd::PlatformExtension> extension =
+                std::make_shared<gd::PlatformExtension>();
+            extension->SetExtensionInformation(name, name, "", "", "");
+            extension->AddAction(actionName, actionName, "", "", "", "", "");
+            return extension;
+          });
+    };
+    addLazyExtension("BuiltinTime", "Wait");
+    addLazyExtension("BuiltinAudio", "PlaySound");
+
+    // Only the extension declaring the action is created.
+    REQUIRE(gd::MetadataProvider::GetExtensionAndActionMetadata(platform,
+                                                                "PlaySound")
+                .GetExtension()
+                .GetName() == "BuiltinAudio");
+    REQUIRE(createdExtensions == std::vector<gd::String>{"BuiltinAudio"});
+
+    REQUIRE(gd::MetadataProvider::IsBadInstructionMetadata(
+        gd::MetadataProvider::GetActionMetadata(platform, "Unknown")));
+    REQUIRE(createdExtensions == std::vector<gd::String>{"BuiltinAudio"});
+
+    // Events are searched without creating all the extensions.
+    REQUIRE(platform.GetEventMetadata("Unknown") == nullptr);
+    REQUIRE(createdExtensions == std::vector<gd::String>{"BuiltinAudio"});
+  }
+
+  SECTION("Extensions created lazily when listed") {
+    int createdExtensionsCount = 0;
+    platform.AddLazyExtension("LazyExtension", [&createdExtensionsCount]() {
+      createdExtensionsCount++;
+      std::shared_ptr<gd::PlatformExtension> extension =
+          std::make_shared<gd::PlatformExtension>();
+      extension->SetExtensionInformation(
+          "LazyExtension", "Lazy extension", "", "", "");
+      return extension;
+    });
+
+    REQUIRE(createdExtensionsCount == 0);
+    REQUIRE(platform.GetExtension("LazyExtension")->GetName() ==
+            "LazyExtension");
+    REQUIRE(createdExtensionsCount == 1);
+    platform.GetAllPlatformExtensions();
+    REQUIRE(createdExtensionsCount == 1);
+
+    platform.RemoveExtension("LazyExtension");
+    REQUIRE(!platform.IsExtensionLoaded("LazyExtension"));
+  }
+
+  SECTION("Extensions created lazily keep the order they were added in") {
+    platform.AddLazyExtension("BuiltinTime", {"Wait"}, []() {
+      std::shared_ptr<gd::PlatformExtension> extension =
+          std::make_shared<gd::PlatformExtension>();
+      extension->SetExtensionInformation(
+          "BuiltinTime", "Time extension", "", "", "");
+      extension->AddAction("Wait", "Wait (time)", "", "", "", "", "");
+      return extension;
+    });
+
+    std::shared_ptr<gd::PlatformExtension> sceneExtension =
+        std::make_shared<gd::PlatformExtension>();
+    sceneExtension->SetExtensionInformation(
+        "BuiltinScene", "Scene extension", "", "", "");
+    sceneExtension->AddAction("Wait", "Wait (scene)", "", "", "", "", "");
+    platform.AddExtension(sceneExtension);
+
+    // The lazy extension was added first, so it's used even if it's created
+    // after the index is built.
+    platform.GetMetadataIndex();
+    REQUIRE(gd::MetadataProvider::GetExtensionAndActionMetadata(platform,
+                                                                "Wait")
+                .GetExtension()
+                .GetName() == "BuiltinTime");
+
+    auto extensions = platform.GetAllPlatformExtensions();
+    REQUIRE(extensions.size() >= 2);
+    REQUIRE(extensions[extensions.size() - 2]->GetName() == "BuiltinTime");
+    REQUIRE(extensions.back()->GetName() == "BuiltinScene");
+  }
+
+  SECTION("Extensions created lazily can search other extensions") {
+    platform.AddLazyExtension("DependentExtension", [&platform]() {
+      // Creating an extension can search (and create) the other ones.
+      std::shared_ptr<gd::PlatformExtension> extension =
+          std::make_shared<gd::PlatformExtension>();
+      extension->SetExtensionInformation(
+          "DependentExtension",
+          platform.GetExtension("LazyExtension")->GetFullName(),
+          "",
+          "",
+          "");
+      return extension;
+    });
+    platform.AddLazyExtension("LazyExtension", []() {
+      std::shared_ptr<gd::PlatformExtension> extension =
+          std::make_shared<gd::PlatformExtension>();
+      extension->SetExtensionInformation(
+          "LazyExtension", "Lazy extension", "", "", "");
+      return extension;
+    });
+
+    REQUIRE(platform.GetExtension("DependentExtension")->GetFullName() ==
+            "Lazy extension");
+    REQUIRE(platform.IsExtensionLoaded("LazyExtension"));
+  }
+}
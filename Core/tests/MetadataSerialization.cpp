@@ -0,0 +1,221 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the snapshots of the metadata of a platform.
+ */
+#include <algorithm>
+#include <memory>
+
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+namespace {
+// An extension declaring only in code what can't be serialized.
+std::shared_ptr<gd::PlatformExtension> CreateExtensionWithoutMetadata() {
+  auto extension = std::make_shared<gd::PlatformExtension>();
+  extension->SetExtensionInformation("MyExtension", "", "", "", "");
+  extension->AddObject<gd::SpriteObject>(
+      "Sprite", "Dummy Sprite", "Dummy sprite object", "");
+  extension
+      ->AddAction("DoSomething", "", "", "", "", "", "")
+      .SetCustomCodeGenerator([](gd::Instruction &instruction,
+                                 gd::EventsCodeGenerator &codeGenerator,
+                                 gd::EventsCodeGenerationContext &context) {
+        return "customCode();";
+      });
+  return extension;
+}
+
+// An extension built from its snapshot, like builtin extensions.
+std::shared_ptr<gd::PlatformExtension> CreateExtensionFromSnapshot(
+    const gd::SerializerElement &metadataSnapshot) {
+  auto extension = CreateExtensionWithoutMetadata();
+  extension->UnserializeMetadataFrom(metadataSnapshot);
+  return extension;
+}
+
+const gd::SerializerElement *GetObjectElement(
+    const gd::SerializerElement &extensionElement, const gd::String &type) {
+  const gd::SerializerElement &objectsElement =
+      extensionElement.GetChild("objects");
+  objectsElement.ConsiderAsArrayOf("object");
+  for (std::size_t i = 0; i < objectsElement.GetChildrenCount(); ++i) {
+    if (objectsElement.GetChild(i).GetStringAttribute("type") == type)
+      return &objectsElement.GetChild(i);
+  }
+
+  return nullptr;
+}
+}  // namespace
+
+TEST_CASE("MetadataSerialization", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  gd::SerializerElement element;
+  platform.SerializeMetadataTo(element);
+
+  gd::SerializerElement unserializedElement;
+  gd::String errorMessage;
+  REQUIRE(gd::Serializer::FromBinary(
+      unserializedElement, gd::Serializer::ToBinary(element), errorMessage));
+  REQUIRE(gd::Serializer::ToJSON(unserializedElement) ==
+          gd::Serializer::ToJSON(element));
+
+  auto requireMetadataFromSnapshot = [&platform](
+                                         const gd::Platform &newPlatform) {
+    const auto &action = gd::MetadataProvider::GetActionMetadata(
+        newPlatform, "MyExtension::DoSomething");
+    REQUIRE(action.GetFullName() == "Do something");
+    REQUIRE(action.GetParametersCount() == 1);
+    REQUIRE(action.GetParameter(0).GetType() == "expression");
+    REQUIRE(action.HasCustomCodeGenerator());
+
+    const auto &expression = gd::MetadataProvider::GetExpressionMetadata(
+        newPlatform, "MyExtension::GetNumber");
+    REQUIRE(expression.GetFullName() == "Get me a number");
+    REQUIRE(expression.codeExtraInformation.functionCallName == "getNumber");
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetStrExpressionMetadata(
+            newPlatform, "MyExtension::ToString")));
+
+    // Functions of the objects declared in code are declared too.
+    const auto &objectExpression =
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            newPlatform, "MyExtension::Sprite", "GetObjectNumber");
+    REQUIRE(objectExpression.GetFullName() == "Get number from object");
+    REQUIRE(objectExpression.codeExtraInformation.functionCallName ==
+            "getObjectNumber");
+
+    // The metadata are the same as the ones declared in code.
+    gd::SerializerElement extensionElement;
+    platform.GetExtension("MyExtension")->SerializeMetadataTo(extensionElement);
+    gd::SerializerElement newExtensionElement;
+    newPlatform.GetExtension("MyExtension")
+        ->SerializeMetadataTo(newExtensionElement);
+    const gd::SerializerElement *objectElement =
+        GetObjectElement(extensionElement, "MyExtension::Sprite");
+    const gd::SerializerElement *newObjectElement =
+        GetObjectElement(newExtensionElement, "MyExtension::Sprite");
+    REQUIRE(objectElement != nullptr);
+    REQUIRE(newObjectElement != nullptr);
+    REQUIRE(gd::Serializer::ToJSON(*newObjectElement) ==
+            gd::Serializer::ToJSON(*objectElement));
+    REQUIRE(gd::Serializer::ToJSON(newExtensionElement.GetChild("actions")) ==
+            gd::Serializer::ToJSON(extensionElement.GetChild("actions")));
+    REQUIRE(
+        gd::Serializer::ToJSON(newExtensionElement.GetChild("expressions")) ==
+        gd::Serializer::ToJSON(extensionElement.GetChild("expressions")));
+  };
+
+  SECTION("Snapshot not applied to an extension already added") {
+    gd::Platform newPlatform;
+    newPlatform.AddExtension(CreateExtensionWithoutMetadata());
+
+    // The metadata of the extension are already declared in code.
+    REQUIRE(newPlatform.UnserializeMetadataFrom(unserializedElement));
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(newPlatform,
+                                                    "MyExtension::GetNumber")));
+  }
+
+  SECTION("Snapshot applied to an extension added later") {
+    gd::Platform newPlatform;
+    newPlatform.UnserializeMetadataFrom(unserializedElement);
+    newPlatform.AddExtension(CreateExtensionWithoutMetadata());
+    requireMetadataFromSnapshot(newPlatform);
+  }
+
+  SECTION("Lazily created extension built from the snapshot") {
+    gd::Platform newPlatform;
+    REQUIRE(newPlatform.UnserializeMetadataFrom(unserializedElement));
+    bool declaredInCode = false;
+    newPlatform.AddLazyExtension(
+        "MyExtension",
+        [&declaredInCode]() {
+          declaredInCode = true;
+          return CreateExtensionWithoutMetadata();
+        },
+        &CreateExtensionFromSnapshot);
+    requireMetadataFromSnapshot(newPlatform);
+    REQUIRE(!declaredInCode);
+
+    const auto &extension = *newPlatform.GetExtension("MyExtension");
+    REQUIRE(extension.GetFullName() == "My testing extension");
+  }
+
+  SECTION("Lazily created extension declared in code without snapshot") {
+    gd::Platform newPlatform;
+    bool declaredInCode = false;
+    newPlatform.AddLazyExtension(
+        "MyExtension",
+        [&declaredInCode]() {
+          declaredInCode = true;
+          return CreateExtensionWithoutMetadata();
+        },
+        &CreateExtensionFromSnapshot);
+    REQUIRE(newPlatform.GetExtension("MyExtension") != nullptr);
+    REQUIRE(declaredInCode);
+  }
+
+  SECTION("Snapshot of another version of GDevelop") {
+    gd::SerializerElement outdatedElement = unserializedElement;
+    outdatedElement.SetAttribute("version", "0.0.0");
+
+    gd::Platform newPlatform;
+    REQUIRE(!newPlatform.UnserializeMetadataFrom(outdatedElement));
+    newPlatform.AddExtension(CreateExtensionWithoutMetadata());
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(newPlatform,
+                                                    "MyExtension::GetNumber")));
+  }
+
+  SECTION("Types of a lazily created extension read from the snapshot") {
+    gd::SerializerElement extensionElement;
+    platform.GetExtension("MyExtension")->SerializeMetadataTo(extensionElement);
+    std::vector<gd::String> types =
+        gd::PlatformExtension::GetTypesDeclaredInMetadata(extensionElement);
+    REQUIRE(std::find(types.begin(), types.end(), "MyExtension::GetNumber") !=
+            types.end());
+    REQUIRE(std::find(types.begin(), types.end(), "MyExtension::Sprite") !=
+            types.end());
+    REQUIRE(std::find(types.begin(),
+                      types.end(),
+                      "MyExtension::SetAnimationName") != types.end());
+
+    gd::Platform newPlatform;
+    newPlatform.UnserializeMetadataFrom(unserializedElement);
+    bool created = false;
+    newPlatform.AddLazyExtension(
+        "MyExtension",
+        &CreateExtensionWithoutMetadata,
+        [&created](const gd::SerializerElement &metadataSnapshot) {
+          created = true;
+          return CreateExtensionFromSnapshot(metadataSnapshot);
+        });
+
+    // A type of the namespace not declared by the extension doesn't create it.
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(newPlatform,
+                                                    "MyExtension::Unknown")));
+    REQUIRE(!created);
+    REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(
+            newPlatform, "MyExtension::GetNumber")));
+    REQUIRE(created);
+  }
+}
@@ -0,0 +1,166 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the search of objects by name in a container.
+ */
+#include "GDCore/Project/ObjectsContainer.h"
+
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+namespace {
+// Check the positions found by name against the objects of the container.
+void RequirePositionsOfAllObjects(const gd::ObjectsContainer &container) {
+  for (std::size_t i = 0; i < container.GetObjectsCount(); ++i) {
+    const gd::String &name = container.GetObject(i).GetName();
+    REQUIRE(container.HasObjectNamed(name));
+    REQUIRE(container.GetObjectPosition(name) == i);
+    REQUIRE(&container.GetObject(name) == &container.GetObject(i));
+  }
+}
+}  // namespace
+
+TEST_CASE("ObjectsContainer", "[common]") {
+  gd::Platform platform;
+  gd::Project project;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  gd::Layout &layout = project.InsertNewLayout("Scene", 0);
+  layout.InsertNewObject(project, "MyExtension::Sprite", "Object1", 0);
+  layout.InsertNewObject(project, "MyExtension::Sprite", "Object2", 1);
+  layout.InsertNewObject(project, "MyExtension::Sprite", "Object3", 2);
+  RequirePositionsOfAllObjects(layout);
+
+  SECTION("Insertion") {
+    layout.InsertNewObject(project, "MyExtension::Sprite", "Object0", 0);
+    REQUIRE(layout.GetObjectPosition("Object0") == 0);
+    REQUIRE(layout.GetObjectPosition("Object3") == 3);
+
+    layout.InsertObject(layout.GetObject("Object1"), 2).SetName("Copy");
+    REQUIRE(layout.GetObjectPosition("Copy") == 2);
+    REQUIRE(layout.GetObjectPosition("Object2") == 3);
+
+    layout.InsertNewObject(
+        project, "MyExtension::Sprite", "Last", layout.GetObjectsCount() + 10);
+    REQUIRE(layout.GetObjectPosition("Last") == 5);
+    REQUIRE(!layout.HasObjectNamed("Unknown"));
+    REQUIRE(layout.GetObjectPosition("Unknown") == gd::String::npos);
+    RequirePositionsOfAllObjects(layout);
+  }
+
+  SECTION("Removal") {
+    layout.RemoveObject("Object1");
+    REQUIRE(!layout.HasObjectNamed("Object1"));
+    REQUIRE(layout.GetObjectPosition("Object2") == 0);
+    REQUIRE(layout.GetObjectPosition("Object3") == 1);
+
+    layout.RemoveObject("Unknown");
+    REQUIRE(layout.GetObjectsCount() == 2);
+    RequirePositionsOfAllObjects(layout);
+  }
+
+  SECTION("Move") {
+    layout.MoveObject(0, 2);
+    REQUIRE(layout.GetObjectPosition("Object1") == 2);
+    REQUIRE(layout.GetObjectPosition("Object2") == 0);
+    REQUIRE(layout.GetObjectPosition("Object3") == 1);
+    RequirePositionsOfAllObjects(layout);
+
+    gd::Layout &otherLayout = project.InsertNewLayout("Other scene", 1);
+    otherLayout.InsertNewObject(project, "MyExtension::Sprite", "Other", 0);
+    REQUIRE(otherLayout.HasObjectNamed("Other"));
+    layout.MoveObjectFolderOrObjectToAnotherContainerInFolder(
+        layout.GetRootFolder().GetObjectNamed("Object3"),
+        otherLayout,
+        otherLayout.GetRootFolder(),
+        0);
+    REQUIRE(!layout.HasObjectNamed("Object3"));
+    REQUIRE(otherLayout.GetObjectPosition("Object3") == 1);
+    RequirePositionsOfAllObjects(layout);
+    RequirePositionsOfAllObjects(otherLayout);
+  }
+
+  SECTION("Rename") {
+    layout.GetObject("Object2").SetName("Renamed");
+    REQUIRE(!layout.HasObjectNamed("Object2"));
+    REQUIRE(layout.GetObjectPosition("Renamed") == 1);
+    RequirePositionsOfAllObjects(layout);
+
+    // Objects moved to another container are renamed in this container.
+    gd::Layout &otherLayout = project.InsertNewLayout("Other scene", 1);
+    otherLayout.InsertNewObject(project, "MyExtension::Sprite", "Other", 0);
+    REQUIRE(otherLayout.HasObjectNamed("Other"));
+    layout.MoveObjectFolderOrObjectToAnotherContainerInFolder(
+        layout.GetRootFolder().GetObjectNamed("Object3"),
+        otherLayout,
+        otherLayout.GetRootFolder(),
+        0);
+    otherLayout.GetObject("Object3").SetName("Renamed3");
+    REQUIRE(otherLayout.GetObjectPosition("Renamed3") == 1);
+    RequirePositionsOfAllObjects(otherLayout);
+
+    // Objects added to the objects list are indexed.
+    std::unique_ptr<gd::Object> object(layout.GetObject("Object1").Clone());
+    object->SetName("Added");
+    layout.GetObjects().push_back(std::move(object));
+    REQUIRE(layout.GetObjectPosition("Added") == 2);
+    RequirePositionsOfAllObjects(layout);
+
+    // Objects of copied containers are renamed in the copy.
+    gd::Layout copiedLayout = layout;
+    copiedLayout.GetObject("Object1").SetName("RenamedInCopy");
+    REQUIRE(copiedLayout.GetObjectPosition("RenamedInCopy") == 0);
+    REQUIRE(layout.GetObjectPosition("Object1") == 0);
+    RequirePositionsOfAllObjects(copiedLayout);
+  }
+
+  SECTION("Missing object") {
+    REQUIRE(!layout.HasObjectNamed("Missing"));
+    REQUIRE(layout.GetObject("Missing").GetName() == "");
+    REQUIRE(layout.GetObjectPosition("Missing") == gd::String::npos);
+  }
+
+  SECTION("Objects with the same name") {
+    layout.GetObject("Object3").SetName("Object1");
+    REQUIRE(layout.GetObjectPosition("Object1") == 0);
+
+    layout.RemoveObject("Object1");
+    REQUIRE(layout.GetObjectPosition("Object1") == 1);
+    REQUIRE(layout.GetObjectPosition("Object2") == 0);
+
+    layout.InsertNewObject(project, "MyExtension::Sprite", "Object2", 0);
+    REQUIRE(layout.GetObjectPosition("Object2") == 0);
+    REQUIRE(layout.GetObjectPosition("Object1") == 2);
+  }
+
+  SECTION("Modification of the objects list") {
+    layout.GetObjects().erase(layout.GetObjects().begin());
+    REQUIRE(!layout.HasObjectNamed("Object1"));
+    RequirePositionsOfAllObjects(layout);
+
+    auto &objects = layout.GetObjects();
+    std::swap(objects[0], objects[1]);
+    RequirePositionsOfAllObjects(layout);
+  }
+
+  SECTION("Copy") {
+    gd::Layout otherLayout;
+    otherLayout.InsertNewObject(project, "MyExtension::Sprite", "ObjectA", 0);
+    otherLayout.InsertNewObject(project, "MyExtension::Sprite", "ObjectB", 1);
+    otherLayout.InsertNewObject(project, "MyExtension::Sprite", "ObjectC", 2);
+    REQUIRE(otherLayout.HasObjectNamed("ObjectA"));
+
+    otherLayout = layout;
+    REQUIRE(!otherLayout.HasObjectNamed("ObjectA"));
+    REQUIRE(otherLayout.GetObjectPosition("Object2") == 1);
+    RequirePositionsOfAllObjects(otherLayout);
+  }
+}
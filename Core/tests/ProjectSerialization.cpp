@@ -0,0 +1,292 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the serialization of projects.
+ */
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Project/ExternalEvents.h"
+#include "GDCore/Project/ExternalLayout.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "catch.hpp"
+
+using namespace gd;
+
+namespace {
+void SetupProjectWithLayouts(gd::Project &project, gd::Platform &platform) {
+  SetupProjectWithDummyPlatform(project, platform);
+
+  gd::Layout &layout1 = project.InsertNewLayout("Scene1", 0);
+  layout1.SetWindowDefaultTitle("Title 1");
+  layout1.InsertNewObject(project, "MyExtension::Sprite", "MyObject", 0);
+  gd::Layout &layout2 = project.InsertNewLayout("Scene2", 1);
+  layout2.SetWindowDefaultTitle("Title 2");
+
+  project.InsertNewExternalEvents("MyExternalEvents", 0)
+      .SetAssociatedLayout("Scene1");
+  project.InsertNewExternalLayout("MyExternalLayout", 0)
+      .SetAssociatedLayout("Scene2");
+}
+}  // namespace
+
+TEST_CASE("ProjectSerialization", "[common]") {
+  SECTION("Lazy unserialization of layouts") {
+    gd::Platform platform;
+    gd::Project writtenProject;
+    SetupProjectWithLayouts(writtenProject, platform);
+
+    SerializerElement projectElement;
+    writtenProject.SerializeTo(projectElement);
+
+    gd::Project readProject;
+    readProject.AddPlatform(platform);
+    readProject.SetLazyUnserializationEnabled(true);
+    readProject.UnserializeFrom(projectElement);
+
+    // Layouts are known by their names...
+    REQUIRE(readProject.GetLayoutsCount() == 2);
+    REQUIRE(readProject.HasLayoutNamed("Scene2"));
+    REQUIRE(readProject.GetLayoutPosition("Scene2") == 1);
+    REQUIRE(readProject.HasExternalEventsNamed("MyExternalEvents"));
+    REQUIRE(readProject.HasExternalLayoutNamed("MyExternalLayout"));
+
+    // ...but only unserialized when accessed. The elements are shared, but
+    // modifying them in the project element copies them first: the layouts
+    // are unserialized from their original elements.
+    projectElement.GetChild("layouts")
+        .GetChild(1)
+        .SetAttribute("title", gd::String("Modified title 2"));
+    REQUIRE(projectElement.GetChild("layouts").GetChild(1).GetStringAttribute(
+                "title") == "Modified title 2");
+    projectElement = SerializerElement();
+
+    REQUIRE(readProject.GetLayout("Scene1").GetWindowDefaultTitle() ==
+            "Title 1");
+    REQUIRE(readProject.GetLayout("Scene1").HasObjectNamed("MyObject"));
+    REQUIRE(readProject.GetLayout(1).GetWindowDefaultTitle() == "Title 2");
+    REQUIRE(readProject.GetExternalEvents("MyExternalEvents")
+                .GetAssociatedLayout() == "Scene1");
+    REQUIRE(readProject.GetExternalLayout(0).GetAssociatedLayout() ==
+            "Scene2");
+  }
+
+  SECTION("Unserialization using multiple threads") {
+    gd::Platform platform;
+    gd::Project writtenProject;
+    SetupProjectWithLayouts(writtenProject, platform);
+    for (std::size_t i = 0; i < 20; ++i) {
+      gd::Layout &layout = writtenProject.InsertNewLayout(
+          "Other scene " + gd::String::From(i), 2 + i);
+      for (std::size_t j = 0; j < 10; ++j) {
+        layout.InsertNewObject(writtenProject,
+                               "MyExtension::Sprite",
+                               "MyObject" + gd::String::From(j),
+                               j);
+        layout.GetInitialInstances().InsertNewInitialInstance().SetObjectName(
+            "MyObject" + gd::String::From(j));
+      }
+      writtenProject.InsertNewExternalEvents(
+          "Other external events " + gd::String::From(i), 1 + i);
+    }
+
+    SerializerElement projectElement;
+    writtenProject.SerializeTo(projectElement);
+
+    gd::Project readProject;
+    readProject.AddPlatform(platform);
+    readProject.SetUnserializationThreadsCount(4);
+    readProject.UnserializeFrom(projectElement);
+
+    REQUIRE(readProject.GetLayoutsCount() == 22);
+    REQUIRE(readProject.GetLayout(5).GetName() == "Other scene 3");
+    REQUIRE(readProject.GetLayout(5).GetObjectsCount() == 10);
+    REQUIRE(
+        readProject.GetLayout(5).GetInitialInstances().GetInstancesCount() ==
+        10);
+    REQUIRE(readProject.GetExternalEvents(0).GetAssociatedLayout() ==
+            "Scene1");
+
+    SerializerElement readProjectElement;
+    readProject.SerializeTo(readProjectElement);
+    REQUIRE(Serializer::ToJSON(readProjectElement) ==
+            Serializer::ToJSON(projectElement));
+  }
+
+  SECTION("Saving and copying a project unserialized lazily") {
+    gd::Platform platform;
+    gd::Project writtenProject;
+    SetupProjectWithLayouts(writtenProject, platform);
+
+    SerializerElement projectElement;
+    writtenProject.SerializeTo(projectElement);
+    gd::String json = Serializer::ToJSON(projectElement);
+
+    gd::Project readProject;
+    readProject.AddPlatform(platform);
+    readProject.SetLazyUnserializationEnabled(true);
+    readProject.UnserializeFrom(projectElement);
+
+    gd::Project copiedProject = readProject;
+    REQUIRE(copiedProject.GetLayout("Scene2").GetWindowDefaultTitle() ==
+            "Title 2");
+    copiedProject.RemoveLayout("Scene1");
+    REQUIRE(copiedProject.GetLayoutsCount() == 1);
+
+    SerializerElement readProjectElement;
+    readProject.SerializeTo(readProjectElement);
+    REQUIRE(Serializer::ToJSON(readProjectElement) == json);
+
+    // Layouts not unserialized are written back as is...
+    const SerializerElement &readLayoutsElement =
+        readProjectElement.GetChild("layouts");
+    const SerializerElement &layoutsElement =
+        projectElement.GetChild("layouts");
+    REQUIRE(readLayoutsElement.GetSharedChild(1) ==
+            layoutsElement.GetSharedChild(1));
+
+    // ...and modifying them in the saved element does not modify the project.
+    readProjectElement.GetChild("layouts").GetChild(1).SetAttribute(
+        "title", gd::String("Modified title 2"));
+    REQUIRE(layoutsElement.GetChild(1).GetStringAttribute("title") ==
+            "Title 2");
+    REQUIRE(readProject.GetLayout("Scene2").GetWindowDefaultTitle() ==
+            "Title 2");
+  }
+
+  SECTION("Incremental serialization") {
+    gd::Platform platform;
+    gd::Project project;
+    SetupProjectWithLayouts(project, platform);
+    project.SetIncrementalSerializationEnabled(true);
+
+    // The same project, always fully serialized, to compare with. (Copying
+    // the project is not used, as the folders of objects are not copied).
+    gd::Platform fullySerializedPlatform;
+    gd::Project fullySerializedProject;
+    SetupProjectWithLayouts(fullySerializedProject, fullySerializedPlatform);
+
+    auto serializeToJSON = [](const gd::Project &project) {
+      SerializerElement projectElement;
+      project.SerializeTo(projectElement);
+      return Serializer::ToJSON(projectElement);
+    };
+
+    // Everything is serialized the first time.
+    const gd::Project &constProject = project;
+    REQUIRE(constProject.GetLayout("Scene1").IsDirty());
+    SerializerElement projectElement;
+    project.SerializeTo(projectElement);
+    REQUIRE(Serializer::ToJSON(projectElement) ==
+            serializeToJSON(fullySerializedProject));
+    REQUIRE_FALSE(constProject.GetLayout("Scene1").IsDirty());
+    REQUIRE_FALSE(constProject.GetExternalEvents(0).IsDirty());
+    REQUIRE_FALSE(constProject.GetResourcesManager().IsDirty());
+
+    // Entities not modified are not serialized again: their elements are
+    // reused...
+    SerializerElement otherProjectElement;
+    project.SerializeTo(otherProjectElement);
+    const SerializerElement &layoutsElement =
+        static_cast<const SerializerElement &>(projectElement)
+            .GetChild("layouts");
+    const SerializerElement &otherLayoutsElement =
+        static_cast<const SerializerElement &>(otherProjectElement)
+            .GetChild("layouts");
+    REQUIRE(otherLayoutsElement.GetSharedChild(0) ==
+            layoutsElement.GetSharedChild(0));
+
+    // ...but modifying them in the serialized element copies them first, so
+    // the next serializations are unchanged.
+    projectElement.GetChild("layouts").GetChild(0).AddChild("usedResources");
+    REQUIRE(otherLayoutsElement.GetSharedChild(0) !=
+            layoutsElement.GetSharedChild(0));
+    REQUIRE(serializeToJSON(project) ==
+            serializeToJSON(fullySerializedProject));
+
+    // Entities accessed to be modified are marked as dirty...
+    for (gd::Project *modifiedProject : {&project, &fullySerializedProject}) {
+      modifiedProject->GetLayout("Scene2").SetWindowDefaultTitle(
+          "Modified title 2");
+    }
+    REQUIRE(constProject.GetLayout("Scene2").IsDirty());
+    REQUIRE_FALSE(constProject.GetLayout("Scene1").IsDirty());
+    REQUIRE(serializeToJSON(project) ==
+            serializeToJSON(fullySerializedProject));
+
+    // ...and so are entities modified by their own modifiers, using a
+    // reference kept since the previous serialization.
+    gd::Layout &layout1 = project.GetLayout("Scene1");
+    serializeToJSON(project);
+    REQUIRE_FALSE(layout1.IsDirty());
+    layout1.SetWindowDefaultTitle("Modified title 1");
+    fullySerializedProject.GetLayout("Scene1").SetWindowDefaultTitle(
+        "Modified title 1");
+    REQUIRE(layout1.IsDirty());
+    REQUIRE(serializeToJSON(project) ==
+            serializeToJSON(fullySerializedProject));
+
+    // ...and so are layouts whose objects are accessed to be modified.
+    serializeToJSON(project);
+    REQUIRE_FALSE(layout1.IsDirty());
+    for (gd::Project *modifiedProject : {&project, &fullySerializedProject}) {
+      gd::Layout &modifiedLayout = modifiedProject->GetLayout("Scene1");
+      modifiedLayout.GetObject("MyObject").SetName("MyRenamedObject");
+    }
+    REQUIRE(layout1.IsDirty());
+    REQUIRE(serializeToJSON(project).find("MyRenamedObject") !=
+            gd::String::npos);
+    REQUIRE(serializeToJSON(project) ==
+            serializeToJSON(fullySerializedProject));
+
+    for (gd::Project *modifiedProject : {&project, &fullySerializedProject}) {
+      gd::Layout &modifiedLayout = modifiedProject->GetLayout("Scene1");
+      serializeToJSON(*modifiedProject);
+      modifiedLayout.GetObject(0).GetVariables().InsertNew("MyObjectVariable",
+                                                           0);
+      serializeToJSON(*modifiedProject);
+      modifiedLayout.InsertNewObject(
+          *modifiedProject, "MyExtension::Sprite", "MyOtherObject", 1);
+      serializeToJSON(*modifiedProject);
+      modifiedLayout.GetObjectGroups().InsertNew("MyGroup", 0);
+      serializeToJSON(*modifiedProject);
+      modifiedLayout.MoveObject(0, 1);
+      serializeToJSON(*modifiedProject);
+      modifiedLayout.RemoveObject("MyOtherObject");
+    }
+    REQUIRE(serializeToJSON(project).find("MyObjectVariable") !=
+            gd::String::npos);
+    REQUIRE(serializeToJSON(project) ==
+            serializeToJSON(fullySerializedProject));
+
+    // An entity which is not dirty is not serialized again...
+    layout1.SetWindowDefaultTitle("Other title 1");
+    layout1.SetDirty(false);
+    REQUIRE(serializeToJSON(project).find("Other title 1") ==
+            gd::String::npos);
+
+    // ...until it's marked as dirty.
+    layout1.SetDirty();
+    REQUIRE(serializeToJSON(project).find("Other title 1") !=
+            gd::String::npos);
+    fullySerializedProject.GetLayout("Scene1").SetWindowDefaultTitle(
+        "Other title 1");
+
+    // Added and removed entities are taken into account.
+    for (gd::Project *modifiedProject : {&project, &fullySerializedProject}) {
+      modifiedProject->RemoveLayout("Scene1");
+      modifiedProject->InsertNewLayout("Scene3", 1);
+      modifiedProject->InsertNewExternalEvents("MyOtherExternalEvents", 1);
+    }
+    REQUIRE(serializeToJSON(project) ==
+            serializeToJSON(fullySerializedProject));
+  }
+}
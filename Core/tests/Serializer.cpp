@@ -7,20 +7,73 @@
  * @file Tests covering serialization to JSON.
  */
 #include "GDCore/Serialization/Serializer.h"
+
+#include <cstring>
+
+#include "DummyPlatform.h"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Events/Serialization.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/IDE/FileWriteStream.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/Variable.h"
+#include "GDCore/Tools/Arena.h"
 #include "GDCore/Tools/SystemStats.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
 
 using namespace gd;
 
+namespace {
+class JSONFileSystem : public gd::AbstractFileSystem {
+ public:
+  JSONFileSystem(const gd::String& content_ = "") : content(content_){};
+  virtual ~JSONFileSystem(){};
+
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) { return true; };
+  virtual gd::String FileNameFrom(const gd::String& file) { return file; };
+  virtual gd::String DirNameFrom(const gd::String& file) { return ""; };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    return true;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) { return false; }
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    return true;
+  }
+  virtual bool ClearDir(const gd::String& directory) { return true; }
+  virtual bool WriteToFile(const gd::String& file,
+                           const gd::String& content_) {
+    content = content_;
+    return true;
+  }
+  virtual gd::String ReadFile(const gd::String& file) { return content; }
+  virtual gd::String GetTempDir() { return "/tmp/"; }
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  }
+
+  const gd::String& GetContent() const { return content; }
+
+ private:
+  gd::String content;
+};
+}  // namespace
+
 TEST_CASE("SerializerElement", "[common]") {
   SECTION("Basics and copying") {
     SerializerElement element;
@@ -81,6 +134,90 @@ TEST_CASE("SerializerElement", "[common]") {
     REQUIRE(element.GetChild(2).GetDoubleValue() == 45.6);
   }
 
+  SECTION("Accessing children by index after modifications") {
+    SerializerElement element;
+    element.AddChild("child").SetIntValue(1);
+    element.AddChild("other").SetIntValue(2);
+    element.AddChild("oldChild").SetIntValue(3);
+    REQUIRE(element.GetChildrenCount("child") == 1);
+    REQUIRE(element.GetChildrenCount("child", "oldChild") == 2);
+    REQUIRE(element.GetChild("child", 1, "oldChild").GetIntValue() == 3);
+
+    element.RemoveChild("child");
+    REQUIRE(element.GetChildrenCount("child", "oldChild") == 1);
+    REQUIRE(element.GetChild("child", 0, "oldChild").GetIntValue() == 3);
+
+    // Unnamed children are part of the array once the element is considered
+    // as an array.
+    element.AddChild("").SetIntValue(4);
+    REQUIRE(element.GetChildrenCount("other") == 1);
+    element.ConsiderAsArrayOf("other");
+    REQUIRE(element.GetChildrenCount() == 2);
+    REQUIRE(element.GetChild(0).GetIntValue() == 2);
+    REQUIRE(element.GetChild(1).GetIntValue() == 4);
+
+    element.AddChild("other").SetIntValue(5);
+    REQUIRE(element.GetChildrenCount() == 3);
+    REQUIRE(element.GetChild(2).GetIntValue() == 5);
+
+    SerializerElement copiedElement = element;
+    copiedElement.AddChild("other").SetIntValue(6);
+    REQUIRE(copiedElement.GetChildrenCount() == 4);
+    REQUIRE(copiedElement.GetChild(3).GetIntValue() == 6);
+    REQUIRE(element.GetChildrenCount() == 3);
+  }
+
+  SECTION("Elements allocated from an arena") {
+    std::unique_ptr<gd::Arena> arena(new gd::Arena(1024));
+    std::unique_ptr<SerializerElement> element(new SerializerElement(*arena));
+    element->AddChild("child1").SetStringValue("value123");
+    element->SetAttribute("attribute", "A value longer than a small string");
+    SerializerElement& array = element->AddChild("array");
+    array.ConsiderAsArrayOf("item");
+    for (std::size_t i = 0; i < 100; ++i)
+      array.AddChild("item").AddChild("value").SetIntValue(i);
+
+    REQUIRE(arena->GetAllocatedSize() > 0);
+    REQUIRE(arena->GetBlocksCount() > 1);
+
+    REQUIRE(element->GetChild("child1").GetStringValue() == "value123");
+    REQUIRE(element->GetStringAttribute("attribute") ==
+            "A value longer than a small string");
+    REQUIRE(element->GetChild("array").GetChild(42).GetChild("value")
+                .GetIntValue() == 42);
+
+    // Strings are stored in the arena too, and are not copied when read.
+    REQUIRE(element->GetChild("child1").GetValue().IsStringView());
+    REQUIRE(element->GetAllAttributes().find("attribute")->second.IsStringView());
+    element->AddChild("number").SetStringValue("12.5");
+    REQUIRE(element->GetChild("number").GetIntValue() == 12);
+    REQUIRE(element->GetChild("number").GetDoubleValue() == 12.5);
+    REQUIRE(element->GetChild("number").GetValue().IsStringView());
+
+    // Copies don't use the arena and are still valid when the arena is
+    // released.
+    std::size_t allocatedSize = arena->GetAllocatedSize();
+    SerializerElement copiedElement = *element;
+    REQUIRE(arena->GetAllocatedSize() == allocatedSize);
+    element.reset();
+    arena.reset();
+    REQUIRE(copiedElement.GetChild("child1").GetStringValue() == "value123");
+    REQUIRE(copiedElement.GetStringAttribute("attribute") ==
+            "A value longer than a small string");
+    REQUIRE(copiedElement.GetChild("array").GetChildrenCount() == 100);
+
+    // Copying into an element using an arena allocates from it.
+    gd::Arena otherArena;
+    SerializerElement otherElement(otherArena);
+    otherElement = copiedElement;
+    REQUIRE(otherArena.GetAllocatedSize() > 0);
+    REQUIRE(otherElement.GetChild("child1").GetValue().IsStringView());
+    REQUIRE(otherElement.GetChild("array").GetChild(99).GetChild("value")
+                .GetIntValue() == 99);
+    REQUIRE(Serializer::ToJSON(otherElement) ==
+            Serializer::ToJSON(copiedElement));
+  }
+
   SECTION("Multiline strings") {
     SerializerElement element;
 
@@ -206,6 +343,205 @@ TEST_CASE("Serializer", "[common]") {
     }
   }
 
+  SECTION("Parsing errors") {
+    gd::String errorMessage;
+    SerializerElement element;
+    element.AddChild("existing").SetStringValue("value");
+
+    gd::String invalidJSON = "{\"ok\":true,\"hello\":}";
+    REQUIRE(Serializer::FromJSON(element,
+                                 invalidJSON.c_str(),
+                                 invalidJSON.Raw().size(),
+                                 errorMessage) == false);
+    REQUIRE(errorMessage.find("offset 19") != gd::String::npos);
+    REQUIRE(element.HasChild("existing") == false);
+    REQUIRE(element.HasChild("ok") == false);
+
+    REQUIRE(Serializer::ToJSON(Serializer::FromJSON(invalidJSON)) == "{}");
+  }
+
+  SECTION("Parsing a buffer which is not null terminated") {
+    gd::String errorMessage;
+    SerializerElement element;
+    const char* json = "[1,\"two\",{\"three\":3}]GARBAGE";
+
+    REQUIRE(Serializer::FromJSON(element, json, 21, errorMessage) == true);
+    REQUIRE(element.ConsideredAsArray() == true);
+    REQUIRE(element.GetChildrenCount() == 3);
+    REQUIRE(element.GetChild(0).GetIntValue() == 1);
+    REQUIRE(element.GetChild(1).GetStringValue() == "two");
+    REQUIRE(element.GetChild(2).GetChild("three").GetIntValue() == 3);
+  }
+
+  SECTION("Parsing in situ") {
+    char json[] =
+        u8"{\"name\":\"Hello \\\"官话\\\"\",\"values\":[1,2.5,true,\"false\"]}";
+    gd::String errorMessage;
+    SerializerElement element;
+    REQUIRE(Serializer::FromJSONInsitu(element, json, errorMessage) == true);
+
+    // Strings reference the buffer, without copy...
+    REQUIRE(element.GetChild("name").GetValue().IsStringView() == true);
+    REQUIRE(element.GetChild("name").GetStringValue() == u8"Hello \"官话\"");
+    REQUIRE(element.GetChild("values").GetChild(3).GetBoolValue() == false);
+    // ...even when they are read or converted.
+    REQUIRE(element.GetChild("name").GetValue().IsStringView() == true);
+    REQUIRE(element.GetChild("values").GetChild(3).GetValue().IsStringView() ==
+            true);
+    REQUIRE(Serializer::ToJSON(element) ==
+            u8"{\"name\":\"Hello \\\"官话\\\"\",\"values\":[1,2.5,true,"
+            u8"\"false\"]}");
+
+    // ...but copies own their strings.
+    SerializerElement copiedElement = element;
+    REQUIRE(copiedElement.GetChild("name").GetValue().IsStringView() == false);
+    memset(json, ' ', sizeof(json) - 1);
+    REQUIRE(copiedElement.GetChild("name").GetStringValue() ==
+            u8"Hello \"官话\"");
+    REQUIRE(copiedElement.GetChild("values").GetChild(3).GetStringValue() ==
+            "false");
+  }
+
+  SECTION("Parsing a file read by chunks") {
+    // Build a JSON larger than the chunks read from the file system.
+    gd::String originalJSON = "{\"items\":[";
+    for (std::size_t i = 0; i < 20000; ++i) {
+      if (i != 0) originalJSON += ",";
+      originalJSON += u8"{\"name\":\"Item 官话 " + gd::String::From(i) +
+                      "\",\"value\":" + gd::String::From(i) + "}";
+    }
+    originalJSON += "],\"ok\":true}";
+
+    JSONFileSystem fs(originalJSON);
+    gd::String errorMessage;
+    SerializerElement element;
+    REQUIRE(Serializer::FromJSONFile(element, fs, "game.json", errorMessage) ==
+            true);
+    REQUIRE(element.GetChild("ok").GetBoolValue() == true);
+    REQUIRE(element.GetChild("items").GetChildrenCount() == 20000);
+    REQUIRE(element.GetChild("items").GetChild(12345).GetIntAttribute(
+                "value") == 12345);
+    REQUIRE(Serializer::ToJSON(element) == originalJSON);
+
+    JSONFileSystem invalidFs("{\"items\":[1,2");
+    REQUIRE(Serializer::FromJSONFile(
+                element, invalidFs, "game.json", errorMessage) == false);
+    REQUIRE(errorMessage.find("offset 13") != gd::String::npos);
+
+    // Each reader has its own position in its file.
+    auto reader = invalidFs.OpenFileForReading("game.json");
+    auto otherReader = invalidFs.OpenFileForReading("other.json");
+    char buffer[9];
+    REQUIRE(reader->Read(buffer, 9) == 9);
+    REQUIRE(std::string(buffer, 9) == "{\"items\":");
+    REQUIRE(otherReader->Read(buffer, 4) == 4);
+    REQUIRE(std::string(buffer, 4) == "{\"it");
+    REQUIRE(reader->Read(buffer, 9) == 4);
+    REQUIRE(std::string(buffer, 4) == "[1,2");
+    REQUIRE(reader->Read(buffer, 9) == 0);
+  }
+
+  SECTION("Writing JSON to a file by chunks") {
+    SerializerElement element;
+    element.SetStringAttribute("attr", "value");
+    SerializerElement& items = element.AddChild("items");
+    items.ConsiderAsArrayOf("item");
+    for (std::size_t i = 0; i < 1000; ++i) {
+      SerializerElement& item = items.AddChild("item");
+      item.AddChild("name").SetStringValue(u8"Item \"官话\" " +
+                                           gd::String::From(i));
+      item.AddChild("value").SetDoubleValue(i + 0.5);
+    }
+
+    JSONFileSystem fs;
+    gd::FileWriteStream stream(fs, "data.js", 100);
+    stream.Write("data = ");
+    Serializer::ToJSON(element, stream);
+    stream.Write(";");
+    REQUIRE(stream.Close() == true);
+
+    REQUIRE(fs.GetContent() == "data = " + Serializer::ToJSON(element) + ";");
+    REQUIRE(fs.GetContent().find(u8"{\"name\":\"Item \\\"官话\\\" 999\","
+                                 u8"\"value\":999.5}]}") != gd::String::npos);
+  }
+
+  SECTION("Binary snapshots") {
+    gd::String originalJSON =
+        u8"{\"a\":[1,2.5,\"官话\",true,{\"b\":\"c\"}],\"d\":{\"e\":-3}}";
+    SerializerElement element = Serializer::FromJSON(originalJSON);
+    element.GetChild("a").ConsiderAsArrayOf("item");
+    element.SetAttribute("attribute", 42);
+
+    std::string binary = Serializer::ToBinary(element);
+    SerializerElement readElement;
+    gd::String errorMessage;
+    REQUIRE(Serializer::FromBinary(readElement, binary, errorMessage) == true);
+    REQUIRE(Serializer::ToJSON(readElement) == Serializer::ToJSON(element));
+    REQUIRE(readElement.GetIntAttribute("attribute") == 42);
+    REQUIRE(readElement.GetChild("a").ConsideredAsArrayOf() == "item");
+    REQUIRE(readElement.GetChild("a").GetChildrenCount() == 5);
+    REQUIRE(readElement.GetChild("a").GetChild(1).GetValue().IsDouble());
+    REQUIRE(readElement.GetChild("d").GetChild("e").GetValue().IsInt());
+    REQUIRE(Serializer::ToBinary(readElement) == binary);
+
+    // Truncated, corrupted or incompatible snapshots are rejected.
+    REQUIRE(Serializer::FromBinary(
+                readElement, binary.data(), binary.size() - 1, errorMessage) ==
+            false);
+    REQUIRE(errorMessage.find("offset") != gd::String::npos);
+    REQUIRE(readElement.GetChildrenCount() == 0);
+
+    std::string newerVersion = binary;
+    newerVersion[4] = 2;
+    REQUIRE(Serializer::FromBinary(readElement, newerVersion, errorMessage) ==
+            false);
+    REQUIRE(Serializer::FromBinary(readElement, "{}", errorMessage) == false);
+
+    // Too deeply nested elements are rejected.
+    SerializerElement nestedElement;
+    SerializerElement *deepestElement = &nestedElement;
+    for (std::size_t i = 0; i < 600; ++i)
+      deepestElement = &deepestElement->AddChild("child");
+    REQUIRE(Serializer::FromBinary(readElement,
+                                   Serializer::ToBinary(nestedElement),
+                                   errorMessage) == false);
+    REQUIRE(errorMessage.find("nested") != gd::String::npos);
+  }
+
+  SECTION("Binary snapshots of a project") {
+    gd::Platform platform;
+    gd::Project writtenProject;
+    SetupProjectWithDummyPlatform(writtenProject, platform);
+    writtenProject.SetName(u8"My game 官话");
+    gd::Layout &layout = writtenProject.InsertNewLayout("Scene", 0);
+    layout.InsertNewObject(
+        writtenProject, "MyExtension::Sprite", "MyObject", 0);
+    layout.GetVariables().InsertNew("MyVariable", 0).SetValue(1.5);
+    gd::InitialInstance &instance =
+        layout.GetInitialInstances().InsertNewInitialInstance();
+    instance.SetObjectName("MyObject");
+    instance.SetX(12.5);
+
+    SerializerElement projectElement;
+    writtenProject.SerializeTo(projectElement);
+    std::string binary = Serializer::ToBinary(projectElement);
+
+    SerializerElement readElement;
+    gd::String errorMessage;
+    REQUIRE(Serializer::FromBinary(readElement, binary, errorMessage) == true);
+
+    gd::Project readProject;
+    readProject.AddPlatform(platform);
+    readProject.UnserializeFrom(readElement);
+    REQUIRE(readProject.GetName() == u8"My game 官话");
+    REQUIRE(readProject.GetLayout("Scene").HasObjectNamed("MyObject"));
+
+    SerializerElement readProjectElement;
+    readProject.SerializeTo(readProjectElement);
+    REQUIRE(Serializer::ToJSON(readProjectElement) ==
+            Serializer::ToJSON(projectElement));
+  }
+
   SECTION("(Deprecated) attributes") {
     gd::String originalJSON = "{\"ok\":true,\"hello\":\"world\"}";
     SerializerElement element = Serializer::FromJSON(originalJSON);
@@ -0,0 +1,104 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the catalog of translations of GDevelop Core.
+ */
+#include "GDCore/Tools/TranslationCatalog.h"
+
+#include <cstdint>
+
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+namespace {
+// The hash of literals is computed at compile time.
+static_assert(gd::TranslationCatalog::Hash("") == 14695981039346656037ull,
+              "Unexpected hash of an empty string");
+static_assert(gd::TranslationCatalog::Hash("a") == 0xaf63dc4c8601ec8cull,
+              "Unexpected hash of a string");
+static_assert(gd::TranslationCatalog::Hash(
+                  "abcdefghijklmnopqrstuvwxyz0123456789") ==
+                  0x9ef613c4254dbc0dull,
+              "Unexpected hash of a string longer than a chunk");
+}  // namespace
+
+TEST_CASE("TranslationCatalog", "[common]") {
+  std::size_t translationsCount = 0;
+  gd::TranslationCatalog catalog([&translationsCount](const char* str) {
+    translationsCount++;
+    return gd::String("Translated ") + str;
+  });
+
+  SECTION("Hash") {
+    const char* str = "Hello world";
+    REQUIRE(gd::TranslationCatalog::Hash(str) ==
+            gd::TranslationCatalog::Hash("Hello world"));
+    REQUIRE(gd::TranslationCatalog::Hash("Hello world") !=
+            gd::TranslationCatalog::Hash("Hello World"));
+  }
+
+  SECTION("Strings are translated once") {
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello world"),
+                                   "Hello world") == "Translated Hello world");
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello world"),
+                                   "Hello world") == "Translated Hello world");
+    REQUIRE(translationsCount == 1);
+
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello"),
+                                   "Hello") == "Translated Hello");
+    REQUIRE(translationsCount == 2);
+    REQUIRE(catalog.GetTranslationsCount() == 2);
+  }
+
+  SECTION("Strings with the same hash") {
+    catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello world"),
+                           "Hello world");
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello world"),
+                                   "Another string") ==
+            "Translated Another string");
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello world"),
+                                   "Hello world") == "Translated Hello world");
+    REQUIRE(translationsCount == 2);
+  }
+
+  SECTION("Clear and change the translation function") {
+    catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello"), "Hello");
+    catalog.Clear();
+    REQUIRE(catalog.GetTranslationsCount() == 0);
+    catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello"), "Hello");
+    REQUIRE(translationsCount == 2);
+
+    catalog.SetTranslationFunction(
+        [](const char* str) { return gd::String("Traduit ") + str; });
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello"),
+                                   "Hello") == "Traduit Hello");
+  }
+
+  SECTION("Translation function using the catalog") {
+    // The catalog is not locked while strings are translated.
+    catalog.SetTranslationFunction([&catalog](const char* str) -> gd::String {
+      if (gd::String(str) == "Hello world")
+        return catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello"),
+                                      "Hello") +
+               " world";
+
+      return gd::String("Translated ") + str;
+    });
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello world"),
+                                   "Hello world") == "Translated Hello world");
+    REQUIRE(catalog.GetTranslationsCount() == 2);
+  }
+
+  SECTION("Translations made while the catalog is cleared are not kept") {
+    catalog.SetTranslationFunction([&catalog](const char* str) {
+      catalog.Clear();
+      return gd::String("Outdated ") + str;
+    });
+    REQUIRE(catalog.GetTranslation(gd::TranslationCatalog::Hash("Hello"),
+                                   "Hello") == "Outdated Hello");
+    REQUIRE(catalog.GetTranslationsCount() == 0);
+  }
+}
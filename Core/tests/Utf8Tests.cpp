@@ -177,6 +177,116 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
             gd::String::npos);
   }
 
+  SECTION("size of a String") {
+    // Only the length is stored in addition to the std::string.
+    REQUIRE(sizeof(gd::String) <= sizeof(std::string) + sizeof(std::size_t));
+  }
+
+  SECTION("random access in long strings") {
+    // The string is longer than the blocks of ASCII characters skipped at
+    // once.
+    gd::String str;
+    std::u32string expected;
+    for (std::size_t i = 0; i < 200; ++i) {
+      char32_t character = i % 3 == 0 ? U'é' : (i % 3 == 1 ? U'a' : U'й');
+      str.push_back(character);
+      expected.push_back(character);
+    }
+
+    REQUIRE(str.size() == 200);
+    for (std::size_t i = 0; i < 200; ++i) REQUIRE(str[i] == expected[i]);
+    REQUIRE(str.substr(95, 10) ==
+            gd::String::FromUTF32(expected.substr(95, 10)));
+    REQUIRE(str.substr(195).size() == 5);
+    REQUIRE(str.find(u8"aй", 100) == 100);
+    REQUIRE(str.find(u8"aйé", 101) == 103);
+    REQUIRE(str.rfind(u8"éa", 150) == 150);
+
+    gd::String copy = str;
+    copy.erase(0, 100);
+    REQUIRE(copy.size() == 100);
+    REQUIRE(copy[0] == expected[100]);
+    REQUIRE(copy[99] == expected[199]);
+  }
+
+  SECTION("size and random access after modifications") {
+    gd::String str = "abc";
+    REQUIRE(str.size() == 3);
+    REQUIRE(str[1] == U'b');
+
+    str += u8"é";
+    REQUIRE(str.size() == 4);
+    str += "d";
+    REQUIRE(str.size() == 5);
+    REQUIRE(str[4] == U'd');
+
+    str.Raw() = u8"éé";
+    REQUIRE(str.size() == 2);
+    REQUIRE(str[1] == U'é');
+
+    str.clear();
+    REQUIRE(str.size() == 0);
+    str.push_back(U'a');
+    str.push_back(U'й');
+    str.push_back(U'b');
+    REQUIRE(str.size() == 3);
+    REQUIRE(str[2] == U'b');
+
+    str.insert(1, u8"éé");
+    REQUIRE(str.size() == 5);
+    str.erase(0, 3);
+    REQUIRE(str.size() == 2);
+    REQUIRE(str[1] == U'b');
+    str.replace(0, 1, u8"cd");
+    REQUIRE(str.size() == 3);
+    REQUIRE(str[2] == U'b');
+    str.pop_back();
+    REQUIRE(str.size() == 2);
+
+    gd::String copy = str;
+    REQUIRE(copy.size() == 2);
+    gd::String moved = std::move(copy);
+    REQUIRE(moved.size() == 2);
+    REQUIRE(moved.substr(1).size() == 1);
+    moved = u8"éèà";
+    REQUIRE(moved.size() == 3);
+    REQUIRE(moved[2] == U'à');
+  }
+
+  SECTION("validation and conversions of long strings") {
+    // Non ASCII and invalid characters at any position, in strings longer
+    // than the blocks of bytes checked at once.
+    std::string text = "Lorem ipsum dolor sit amet, consectetur";
+    for (std::size_t i = 0; i <= text.size(); ++i) {
+      for (const std::string &character :
+           std::vector<std::string>{u8"é", u8"й", u8"😀"}) {
+        gd::String str =
+            gd::String::FromUTF8(text.substr(0, i) + character + text.substr(i));
+        std::u32string expected =
+            gd::String(text.substr(0, i).c_str()).ToUTF32() +
+            gd::String(character.c_str()).ToUTF32() +
+            gd::String(text.substr(i).c_str()).ToUTF32();
+
+        REQUIRE(str.IsValid());
+        REQUIRE(str.size() == text.size() + 1);
+        REQUIRE(str.ToUTF32() == expected);
+        REQUIRE(str.ReplaceInvalid().ToUTF32() == expected);
+      }
+
+      // An invalid byte, a truncated sequence and an overlong encoding.
+      for (const std::string &invalidBytes :
+           std::vector<std::string>{"\xff", "\xc3", "\xc0\xaf"}) {
+        gd::String str = gd::String::FromUTF8(text.substr(0, i) + invalidBytes +
+                                              text.substr(i));
+        REQUIRE(!str.IsValid());
+
+        str.ReplaceInvalid(U'?');
+        REQUIRE(str.IsValid());
+        REQUIRE(str.Raw() == text.substr(0, i) + "?" + text.substr(i));
+      }
+    }
+  }
+
   SECTION("Split") {
     // Use a "special" character as separator to test the worst case
     gd::String str =
@@ -16,7 +16,16 @@ namespace gdjs {
 
 AdvancedExtension::AdvancedExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsAdvancedExtension(*this);
+  DeclareCodeGeneration();
+}
+
+AdvancedExtension::AdvancedExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void AdvancedExtension::DeclareCodeGeneration() {
   GetAllActions()["SetReturnNumber"]
       .SetCustomCodeGenerator([](gd::Instruction& instruction,
                                  gd::EventsCodeGenerator& codeGenerator,
@@ -17,7 +17,18 @@ namespace gdjs {
 class AdvancedExtension : public gd::PlatformExtension {
  public:
   AdvancedExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  AdvancedExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~AdvancedExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
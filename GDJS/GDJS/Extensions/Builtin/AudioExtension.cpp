@@ -14,7 +14,15 @@ namespace gdjs {
 
 AudioExtension::AudioExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsAudioExtension(*this);
+  DeclareCodeGeneration();
+}
+
+AudioExtension::AudioExtension(const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void AudioExtension::DeclareCodeGeneration() {
   GetAllActions()["PlaySound"].SetFunctionName("gdjs.evtTools.sound.playSound");
   GetAllActions()["PlaySoundCanal"].SetFunctionName(
       "gdjs.evtTools.sound.playSoundOnChannel");
@@ -17,7 +17,18 @@ namespace gdjs {
 class AudioExtension : public gd::PlatformExtension {
  public:
   AudioExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  AudioExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~AudioExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
@@ -14,7 +14,16 @@ namespace gdjs {
 
 CommonConversionsExtension::CommonConversionsExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsCommonConversionsExtension(*this);
+  DeclareCodeGeneration();
+}
+
+CommonConversionsExtension::CommonConversionsExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void CommonConversionsExtension::DeclareCodeGeneration() {
   GetAllExpressions()["ToNumber"].SetFunctionName(
       "gdjs.evtTools.common.toNumber");
   GetAllStrExpressions()["ToString"].SetFunctionName(
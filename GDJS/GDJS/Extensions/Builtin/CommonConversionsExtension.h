@@ -18,7 +18,18 @@ namespace gdjs {
 class CommonConversionsExtension : public gd::PlatformExtension {
  public:
   CommonConversionsExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  CommonConversionsExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~CommonConversionsExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
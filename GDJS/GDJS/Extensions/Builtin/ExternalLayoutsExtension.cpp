@@ -14,7 +14,16 @@ namespace gdjs {
 
 ExternalLayoutsExtension::ExternalLayoutsExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsExternalLayoutsExtension(*this);
+  DeclareCodeGeneration();
+}
+
+ExternalLayoutsExtension::ExternalLayoutsExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void ExternalLayoutsExtension::DeclareCodeGeneration() {
   GetAllActions()["BuiltinExternalLayouts::CreateObjectsFromExternalLayout"]
       .SetFunctionName(
           "gdjs.evtTools.runtimeScene.createObjectsFromExternalLayout");
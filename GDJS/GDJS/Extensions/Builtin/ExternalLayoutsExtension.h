@@ -17,7 +17,18 @@ namespace gdjs {
 class ExternalLayoutsExtension : public gd::PlatformExtension {
  public:
   ExternalLayoutsExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  ExternalLayoutsExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~ExternalLayoutsExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
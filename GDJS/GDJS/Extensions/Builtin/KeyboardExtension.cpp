@@ -11,7 +11,16 @@ namespace gdjs {
 
 KeyboardExtension::KeyboardExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsKeyboardExtension(*this);
+  DeclareCodeGeneration();
+}
+
+KeyboardExtension::KeyboardExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void KeyboardExtension::DeclareCodeGeneration() {
   GetAllConditions()["KeyPressed"].SetFunctionName(
       "gdjs.evtTools.input.isKeyPressed");
   GetAllConditions()["KeyReleased"].SetFunctionName(
@@ -17,7 +17,18 @@ namespace gdjs {
 class KeyboardExtension : public gd::PlatformExtension {
  public:
   KeyboardExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  KeyboardExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~KeyboardExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
@@ -4,6 +4,9 @@
  * reserved. This project is released under the MIT License.
  */
 #include "MathematicalToolsExtension.h"
+
+#include <cmath>
+
 #include "GDCore/Extensions/Builtin/AllBuiltinExtensions.h"
 #include "GDCore/Extensions/Metadata/InstructionMetadata.h"
 #include "GDCore/Tools/Localization.h"
@@ -12,7 +15,16 @@ namespace gdjs {
 
 MathematicalToolsExtension::MathematicalToolsExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsMathematicalToolsExtension(*this);
+  DeclareCodeGeneration();
+}
+
+MathematicalToolsExtension::MathematicalToolsExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void MathematicalToolsExtension::DeclareCodeGeneration() {
   GetAllExpressions()["Random"].SetFunctionName("gdjs.random");
   GetAllExpressions()["RandomInRange"].SetFunctionName("gdjs.randomInRange");
   GetAllExpressions()["RandomFloat"].SetFunctionName("gdjs.randomFloat");
@@ -24,10 +36,12 @@ MathematicalToolsExtension::MathematicalToolsExtension() {
   GetAllExpressions()["cos"].SetFunctionName("Math.cos");
   GetAllExpressions()["sin"].SetFunctionName("Math.sin");
   GetAllExpressions()["tan"].SetFunctionName("Math.tan");
-  GetAllExpressions()["abs"].SetFunctionName("Math.abs");
+  GetAllExpressions()["abs"].SetFunctionName("Math.abs").SetPure(
+      [](double number) { return std::fabs(number); });
   GetAllExpressions()["min"].SetFunctionName("Math.min");
   GetAllExpressions()["max"].SetFunctionName("Math.max");
-  GetAllExpressions()["sqrt"].SetFunctionName("Math.sqrt");
+  GetAllExpressions()["sqrt"].SetFunctionName("Math.sqrt").SetPure(
+      [](double number) { return std::sqrt(number); });
   GetAllExpressions()["acos"].SetFunctionName("Math.acos");
   GetAllExpressions()["acosh"].SetFunctionName("gdjs.evtTools.common.acosh");
   GetAllExpressions()["asin"].SetFunctionName("Math.asin");
@@ -36,9 +50,11 @@ MathematicalToolsExtension::MathematicalToolsExtension() {
   GetAllExpressions()["atan2"].SetFunctionName("Math.atan2");
   GetAllExpressions()["atanh"].SetFunctionName("gdjs.evtTools.common.atanh");
   GetAllExpressions()["cbrt"].SetFunctionName("gdjs.evtTools.common.cbrt");
-  GetAllExpressions()["ceil"].SetFunctionName("Math.ceil");
+  GetAllExpressions()["ceil"].SetFunctionName("Math.ceil").SetPure(
+      [](double number) { return std::ceil(number); });
   GetAllExpressions()["ceilTo"].SetFunctionName("gdjs.evtTools.common.ceilTo");
-  GetAllExpressions()["floor"].SetFunctionName("Math.floor");
+  GetAllExpressions()["floor"].SetFunctionName("Math.floor").SetPure(
+      [](double number) { return std::floor(number); });
   GetAllExpressions()["floorTo"].SetFunctionName("gdjs.evtTools.common.floorTo");
   GetAllExpressions()["cosh"].SetFunctionName("gdjs.evtTools.common.cosh");
   GetAllExpressions()["sinh"].SetFunctionName("gdjs.evtTools.common.sinh");
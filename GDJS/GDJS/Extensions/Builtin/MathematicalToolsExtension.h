@@ -17,7 +17,18 @@ namespace gdjs {
 class MathematicalToolsExtension : public gd::PlatformExtension {
  public:
   MathematicalToolsExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  MathematicalToolsExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~MathematicalToolsExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
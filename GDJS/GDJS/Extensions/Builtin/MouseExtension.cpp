@@ -12,7 +12,15 @@ namespace gdjs {
 
 MouseExtension::MouseExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsMouseExtension(*this);
+  DeclareCodeGeneration();
+}
+
+MouseExtension::MouseExtension(const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void MouseExtension::DeclareCodeGeneration() {
   GetAllConditions()["CursorX"].SetFunctionName(
       "gdjs.evtTools.input.getCursorX");
   GetAllConditions()["CursorY"].SetFunctionName(
@@ -17,7 +17,18 @@ namespace gdjs {
 class MouseExtension : public gd::PlatformExtension {
  public:
   MouseExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  MouseExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~MouseExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
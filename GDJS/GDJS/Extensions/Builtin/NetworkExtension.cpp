@@ -15,7 +15,16 @@ namespace gdjs {
 
 NetworkExtension::NetworkExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsNetworkExtension(*this);
+  DeclareCodeGeneration();
+}
+
+NetworkExtension::NetworkExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void NetworkExtension::DeclareCodeGeneration() {
   GetAllActions()["SendRequest"].SetFunctionName(
       "gdjs.evtTools.network.sendDeprecatedSynchronousRequest");
   GetAllActions()["SendAsyncRequest"]
@@ -17,7 +17,18 @@ namespace gdjs {
 class NetworkExtension : public gd::PlatformExtension {
  public:
   NetworkExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  NetworkExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~NetworkExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
@@ -16,7 +16,15 @@ namespace gdjs {
 
 SceneExtension::SceneExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsSceneExtension(*this);
+  DeclareCodeGeneration();
+}
+
+SceneExtension::SceneExtension(const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void SceneExtension::DeclareCodeGeneration() {
   GetAllStrExpressions()["CurrentSceneName"].SetFunctionName(
       "gdjs.evtTools.runtimeScene.getSceneName");
 
@@ -17,7 +17,18 @@ namespace gdjs {
 class SceneExtension : public gd::PlatformExtension {
  public:
   SceneExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  SceneExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~SceneExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
@@ -15,7 +15,16 @@ namespace gdjs {
 StringInstructionsExtension::StringInstructionsExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsStringInstructionsExtension(
       *this);
+  DeclareCodeGeneration();
+}
+
+StringInstructionsExtension::StringInstructionsExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void StringInstructionsExtension::DeclareCodeGeneration() {
   GetAllStrExpressions()["NewLine"].SetFunctionName(
       "gdjs.evtTools.string.newLine");
   GetAllStrExpressions()["FromCodePoint"].SetFunctionName(
@@ -17,7 +17,18 @@ namespace gdjs {
 class StringInstructionsExtension : public gd::PlatformExtension {
  public:
   StringInstructionsExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  StringInstructionsExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~StringInstructionsExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
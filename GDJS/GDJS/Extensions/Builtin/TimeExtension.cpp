@@ -13,7 +13,15 @@ namespace gdjs {
 
 TimeExtension::TimeExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsTimeExtension(*this);
+  DeclareCodeGeneration();
+}
+
+TimeExtension::TimeExtension(const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void TimeExtension::DeclareCodeGeneration() {
   GetAllConditions()["Timer"].SetFunctionName(
       "gdjs.evtTools.runtimeScene.timerElapsedTime");  // Deprecated
   GetAllConditions()["CompareTimer"].SetFunctionName(
@@ -17,7 +17,18 @@ namespace gdjs {
 class TimeExtension : public gd::PlatformExtension {
  public:
   TimeExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  TimeExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~TimeExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
@@ -22,7 +22,16 @@ namespace gdjs {
 
 VariablesExtension::VariablesExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsVariablesExtension(*this);
+  DeclareCodeGeneration();
+}
+
+VariablesExtension::VariablesExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void VariablesExtension::DeclareCodeGeneration() {
   GetAllConditions()["NumberVariable"].SetFunctionName(
       "gdjs.evtTools.variable.getVariableNumber");
   GetAllConditions()["StringVariable"].SetFunctionName(
@@ -18,7 +18,18 @@ namespace gdjs {
 class VariablesExtension : public gd::PlatformExtension {
  public:
   VariablesExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  VariablesExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~VariablesExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
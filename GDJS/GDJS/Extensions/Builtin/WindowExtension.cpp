@@ -14,7 +14,16 @@ namespace gdjs {
 
 WindowExtension::WindowExtension() {
   gd::BuiltinExtensionsImplementer::ImplementsWindowExtension(*this);
+  DeclareCodeGeneration();
+}
+
+WindowExtension::WindowExtension(
+    const gd::SerializerElement& metadataSnapshot) {
+  UnserializeMetadataFrom(metadataSnapshot);
+  DeclareCodeGeneration();
+}
 
+void WindowExtension::DeclareCodeGeneration() {
   GetAllActions()["SetFullScreen"].SetFunctionName(
       "gdjs.evtTools.window.setFullScreen");
   GetAllConditions()["IsFullScreen"].SetFunctionName(
@@ -18,7 +18,18 @@ namespace gdjs {
 class WindowExtension : public gd::PlatformExtension {
  public:
   WindowExtension();
+
+  /**
+   * \brief Create the extension from the snapshot of its metadata, only
+   * declaring in code how they are translated to JS.
+   *
+   * \see gd::Platform::AddLazyExtension
+   */
+  WindowExtension(const gd::SerializerElement& metadataSnapshot);
   virtual ~WindowExtension(){};
+
+ private:
+  void DeclareCodeGeneration();
 };
 
 }  // namespace gdjs
@@ -10,6 +10,7 @@
 #include "GDCore/IDE/ExtensionsLoader.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/TranslationCatalog.h"
 
 // Built-in extensions
 #include "GDJS/Extensions/Builtin/AdvancedExtension.h"
@@ -43,6 +44,19 @@ namespace gdjs {
 
 JsPlatform *JsPlatform::singleton = NULL;
 
+namespace {
+template <class T>
+std::shared_ptr<gd::PlatformExtension> CreateBuiltinExtension() {
+  return std::make_shared<T>();
+}
+
+template <class T>
+std::shared_ptr<gd::PlatformExtension> CreateBuiltinExtensionFromSnapshot(
+    const gd::SerializerElement& metadataSnapshot) {
+  return std::make_shared<T>(metadataSnapshot);
+}
+}  // namespace
+
 // When compiling with emscripten, extensions exposes specific functions to
 // create them.
 #if defined(EMSCRIPTEN)
@@ -71,70 +85,93 @@ void JsPlatform::ReloadBuiltinExtensions() {
   // Adding built-in extensions.
   std::cout << "* Loading builtin extensions... ";
   std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new BaseObjectExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new SpriteExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new CommonInstructionsExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new AsyncExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new CommonConversionsExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new VariablesExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new MouseExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new KeyboardExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new SceneExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new TimeExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new MathematicalToolsExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new CameraExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new AudioExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new FileExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new NetworkExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new WindowExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new StringInstructionsExtension));
-  std::cout.flush();
-  AddExtension(std::shared_ptr<gd::PlatformExtension>(new AdvancedExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new ExternalLayoutsExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new AnimatableExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new EffectExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new FlippableExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new ResizableExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new ScalableExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new OpacityExtension));
-  std::cout.flush();
-  AddExtension(
-      std::shared_ptr<gd::PlatformExtension>(new TextContainerExtension));
-  std::cout.flush();
+  // Extensions are reloaded when the language is changed: translate again
+  // their strings.
+  gd::TranslationCatalog::Get().Clear();
+
+  // Built-in extensions are only created when their metadata are needed (see
+  // gd::Platform::AddLazyExtension). The names must be the ones declared by
+  // the extensions. Extensions declaring objects, behaviors, events or
+  // instructions in GDJS are always declared in code, the others are built
+  // from the metadata snapshot loaded at startup, if any (see
+  // gd::Platform::UnserializeMetadataFrom).
+  AddLazyExtension("BuiltinObject",
+                   CreateBuiltinExtension<BaseObjectExtension>);
+  AddLazyExtension("Sprite", CreateBuiltinExtension<SpriteExtension>);
+  AddLazyExtension("BuiltinCommonInstructions",
+                   CreateBuiltinExtension<CommonInstructionsExtension>);
+  AddLazyExtension("BuiltinAsync", CreateBuiltinExtension<AsyncExtension>);
+  AddLazyExtension(
+      "BuiltinCommonConversions",
+      CreateBuiltinExtension<CommonConversionsExtension>,
+      CreateBuiltinExtensionFromSnapshot<CommonConversionsExtension>);
+  AddLazyExtension(
+      "BuiltinVariables",
+      CreateBuiltinExtension<VariablesExtension>,
+      CreateBuiltinExtensionFromSnapshot<VariablesExtension>);
+  AddLazyExtension(
+      "BuiltinMouse",
+      CreateBuiltinExtension<MouseExtension>,
+      CreateBuiltinExtensionFromSnapshot<MouseExtension>);
+  AddLazyExtension(
+      "BuiltinKeyboard",
+      CreateBuiltinExtension<KeyboardExtension>,
+      CreateBuiltinExtensionFromSnapshot<KeyboardExtension>);
+  AddLazyExtension(
+      "BuiltinScene",
+      CreateBuiltinExtension<SceneExtension>,
+      CreateBuiltinExtensionFromSnapshot<SceneExtension>);
+  AddLazyExtension(
+      "BuiltinTime",
+      CreateBuiltinExtension<TimeExtension>,
+      CreateBuiltinExtensionFromSnapshot<TimeExtension>);
+  AddLazyExtension(
+      "BuiltinMathematicalTools",
+      CreateBuiltinExtension<MathematicalToolsExtension>,
+      CreateBuiltinExtensionFromSnapshot<MathematicalToolsExtension>);
+  AddLazyExtension("BuiltinCamera", CreateBuiltinExtension<CameraExtension>);
+  AddLazyExtension(
+      "BuiltinAudio",
+      CreateBuiltinExtension<AudioExtension>,
+      CreateBuiltinExtensionFromSnapshot<AudioExtension>);
+  AddLazyExtension("BuiltinFile", CreateBuiltinExtension<FileExtension>);
+  AddLazyExtension(
+      "BuiltinNetwork",
+      CreateBuiltinExtension<NetworkExtension>,
+      CreateBuiltinExtensionFromSnapshot<NetworkExtension>);
+  AddLazyExtension(
+      "BuiltinWindow",
+      CreateBuiltinExtension<WindowExtension>,
+      CreateBuiltinExtensionFromSnapshot<WindowExtension>);
+  AddLazyExtension(
+      "BuiltinStringInstructions",
+      CreateBuiltinExtension<StringInstructionsExtension>,
+      CreateBuiltinExtensionFromSnapshot<StringInstructionsExtension>);
+  AddLazyExtension(
+      "BuiltinAdvanced",
+      CreateBuiltinExtension<AdvancedExtension>,
+      CreateBuiltinExtensionFromSnapshot<AdvancedExtension>);
+  AddLazyExtension(
+      "BuiltinExternalLayouts",
+      CreateBuiltinExtension<ExternalLayoutsExtension>,
+      CreateBuiltinExtensionFromSnapshot<ExternalLayoutsExtension>);
+  AddLazyExtension("AnimatableCapability",
+                   CreateBuiltinExtension<AnimatableExtension>);
+  AddLazyExtension("EffectCapability", CreateBuiltinExtension<EffectExtension>);
+  AddLazyExtension("FlippableCapability",
+                   CreateBuiltinExtension<FlippableExtension>);
+  AddLazyExtension("ResizableCapability",
+                   CreateBuiltinExtension<ResizableExtension>);
+  AddLazyExtension("ScalableCapability",
+                   CreateBuiltinExtension<ScalableExtension>);
+  AddLazyExtension("OpacityCapability",
+                   CreateBuiltinExtension<OpacityExtension>);
+  AddLazyExtension("TextContainerCapability",
+                   CreateBuiltinExtension<TextContainerExtension>);
+
+  // The snapshot loaded at startup is not translated: extensions are declared
+  // in code when they are reloaded in another language.
+  RemoveMetadataSnapshots();
   std::cout << "done." << std::endl;
 
 #if defined(EMSCRIPTEN) // When compiling with emscripten, hardcode extensions
@@ -26,6 +26,7 @@
 #include "GDCore/IDE/AbstractFileSystem.h"
 #include "GDCore/IDE/Events/UsedExtensionsFinder.h"
 #include "GDCore/IDE/ExportedDependencyResolver.h"
+#include "GDCore/IDE/FileWriteStream.h"
 #include "GDCore/IDE/Project/ProjectResourcesCopier.h"
 #include "GDCore/IDE/Project/SceneResourcesFinder.h"
 #include "GDCore/IDE/ProjectStripper.h"
@@ -40,6 +41,7 @@
 #include "GDCore/Project/SourceFile.h"
 #include "GDCore/Serialization/Serializer.h"
 #include "GDCore/TinyXml/tinyxml.h"
+#include "GDCore/Tools/Arena.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
 #include "GDJS/Events/CodeGeneration/LayoutCodeGenerator.h"
@@ -286,16 +288,22 @@ gd::String ExporterHelper::ExportProjectData(
     std::unordered_map<gd::String, std::set<gd::String>> &scenesUsedResources) {
   fs.MkDir(fs.DirNameFrom(filename));
 
-  // Save the project to JSON
-  gd::SerializerElement rootElement;
+  // Save the project to JSON. The whole tree is allocated from an arena
+  // to avoid a lot of small allocations (the arena must outlive the tree).
+  gd::Arena arena;
+  gd::SerializerElement rootElement(arena);
   project.SerializeTo(rootElement);
   SerializeUsedResources(rootElement, projectUsedResources, scenesUsedResources);
-  gd::String output =
-      "gdjs.projectData = " + gd::Serializer::ToJSON(rootElement) + ";\n" +
-      "gdjs.runtimeGameOptions = " +
-      gd::Serializer::ToJSON(runtimeGameOptions) + ";\n";
 
-  if (!fs.WriteToFile(filename, output)) return "Unable to write " + filename;
+  // Stream the JSON to the file, without building it in memory.
+  gd::FileWriteStream output(fs, filename);
+  output.Write("gdjs.projectData = ");
+  gd::Serializer::ToJSON(rootElement, output);
+  output.Write(";\ngdjs.runtimeGameOptions = ");
+  gd::Serializer::ToJSON(runtimeGameOptions, output);
+  output.Write(";\n");
+
+  if (!output.Close()) return "Unable to write " + filename;
 
   return "";
 }
@@ -1,9 +1,15 @@
+#include <cstdint>
+#include <cstring>
+
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/IDE/PlatformManager.h"
 #include "GDCore/Project/InitialInstancesContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/TinyXml/tinyxml.h"
+#include "GDCore/Tools/TranslationCatalog.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "GDJS/Extensions/JsPlatform.h"
 
@@ -192,4 +198,101 @@ class ProjectHelper {
 
     return "";
   }
+
+  /**
+   * \brief Save the metadata declared by the extensions of the JS platform,
+   * encoded in base64. Called at build time by
+   * scripts/generate-metadata-snapshot.js.
+   *
+   * \see gd::Platform::SerializeMetadataTo
+   */
+  static gd::String SavePlatformMetadataSnapshot() {
+    gd::SerializerElement element;
+    JsPlatform::Get().SerializeMetadataTo(element);
+    return EncodeBase64(gd::Serializer::ToBinary(element));
+  }
+
+  /**
+   * \brief Load the metadata saved with SavePlatformMetadataSnapshot, so that
+   * builtin extensions are built from them instead of being declared in code.
+   * To be called at startup, before metadata are searched.
+   *
+   * \return false if the snapshot is malformed or was saved by another
+   * version, in which case it's not used.
+   * \see gd::Platform::UnserializeMetadataFrom
+   */
+  static bool LoadPlatformMetadataSnapshot(const gd::String& snapshot) {
+    std::string binary;
+    gd::SerializerElement element;
+    gd::String errorMessage;
+    return DecodeBase64(snapshot.Raw(), binary) &&
+           gd::Serializer::FromBinary(element, binary, errorMessage) &&
+           JsPlatform::Get().UnserializeMetadataFrom(element);
+  }
+
+  /**
+   * \brief Remove the translations cached for the strings of the extensions,
+   * to be called when the translation function (gd.getTranslation) is
+   * replaced.
+   *
+   * \see gd::TranslationCatalog
+   */
+  static void ClearTranslationCatalog() {
+    gd::TranslationCatalog::Get().Clear();
+  }
+
+ private:
+  static const char* GetBase64Characters() {
+    return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  }
+
+  static gd::String EncodeBase64(const std::string& data) {
+    const char* characters = GetBase64Characters();
+    std::string text;
+    text.reserve((data.size() + 2) / 3 * 4);
+    for (std::size_t i = 0; i < data.size(); i += 3) {
+      std::size_t remaining = data.size() - i;
+      std::uint32_t bytes = static_cast<unsigned char>(data[i]) << 16;
+      if (remaining > 1) bytes |= static_cast<unsigned char>(data[i + 1]) << 8;
+      if (remaining > 2) bytes |= static_cast<unsigned char>(data[i + 2]);
+
+      text.push_back(characters[(bytes >> 18) & 63]);
+      text.push_back(characters[(bytes >> 12) & 63]);
+      text.push_back(remaining > 1 ? characters[(bytes >> 6) & 63] : '=');
+      text.push_back(remaining > 2 ? characters[bytes & 63] : '=');
+    }
+
+    return gd::String::FromUTF8(text);
+  }
+
+  static bool DecodeBase64(const std::string& text, std::string& data) {
+    if (text.size() % 4 != 0) return false;
+
+    const char* characters = GetBase64Characters();
+    data.clear();
+    data.reserve(text.size() / 4 * 3);
+    std::uint32_t bytes = 0;
+    std::size_t paddingCount = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      std::uint32_t value = 0;
+      if (text[i] == '=' && i + 2 >= text.size() &&
+          (i + 1 == text.size() || text[i + 1] == '=')) {
+        paddingCount++;
+      } else {
+        const char* character = std::strchr(characters, text[i]);
+        if (text[i] == '\0' || !character || paddingCount) return false;
+        value = character - characters;
+      }
+
+      bytes = (bytes << 6) | value;
+      if (i % 4 == 3) {
+        data.push_back(static_cast<char>((bytes >> 16) & 255));
+        if (paddingCount < 2) data.push_back(static_cast<char>((bytes >> 8) & 255));
+        if (paddingCount < 1) data.push_back(static_cast<char>(bytes & 255));
+        bytes = 0;
+      }
+    }
+
+    return true;
+  }
 };
@@ -315,6 +315,64 @@ class AbstractFileSystemJS : public AbstractFileSystem {
         content.c_str());
   }
 
+  /**
+   * \brief Write a file by parts with the optional appendToFile method of the
+   * JS implementation (receiving the bytes as a Uint8Array), so that the file
+   * is not built in memory before being written.
+   */
+  class FileWriterJS : public AbstractFileSystem::FileWriter {
+   public:
+    FileWriterJS(AbstractFileSystemJS &fs_, const gd::String &file_)
+        : fs(fs_), file(file_), success(true), closed(false) {
+      // Create or truncate the file.
+      success = fs.WriteToFile(file, "");
+    };
+    virtual ~FileWriterJS(){};
+
+    virtual bool Write(const char *data, std::size_t size) override {
+      if (closed) return false;
+      if (!success || size == 0) return success;
+
+      success = (bool)EM_ASM_INT(
+          {
+            var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+            return self.appendToFile(UTF8ToString($1),
+                                     HEAPU8.slice($2, $2 + $3));
+          },
+          (int)&fs,
+          file.c_str(),
+          (int)data,
+          (int)size);
+      return success;
+    }
+
+    virtual bool Close() override {
+      if (closed) return false;
+
+      closed = true;
+      return success;
+    }
+
+   private:
+    AbstractFileSystemJS &fs;
+    gd::String file;
+    bool success;
+    bool closed;
+  };
+
+  virtual std::unique_ptr<FileWriter> OpenFileForWriting(
+      const gd::String &file) {
+    bool canAppend = (bool)EM_ASM_INT(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          return self.hasOwnProperty('appendToFile');
+        },
+        (int)this);
+    if (!canAppend) return AbstractFileSystem::OpenFileForWriting(file);
+
+    return std::unique_ptr<FileWriter>(new FileWriterJS(*this, file));
+  }
+
   virtual gd::String ReadFile(const gd::String &file) {
     return (const char *)EM_ASM_INT(
         {
@@ -452,7 +510,7 @@ typedef EventsFunctionsContainer::FunctionOwner
     EventsFunctionsContainer_FunctionOwner;
 typedef std::unique_ptr<gd::Object> UniquePtrObject;
 typedef std::unique_ptr<gd::ObjectConfiguration> UniquePtrObjectConfiguration;
-typedef std::unique_ptr<ExpressionNode> UniquePtrExpressionNode;
+typedef ArenaUniquePtr<ExpressionNode> UniquePtrExpressionNode;
 typedef std::vector<gd::ExpressionParserError *>
     VectorExpressionParserError;
 typedef gd::SerializableWithNameList<gd::EventsBasedBehavior>
@@ -469,7 +527,7 @@ typedef std::map<gd::String, std::map<gd::String, gd::PropertyDescriptor>>
     MapExtensionProperties;
 typedef gd::Variable::Type Variable_Type;
 typedef gd::VariablesContainer::SourceType VariablesContainer_SourceType;
-typedef std::map<gd::String, gd::SerializerValue> MapStringSerializerValue;
+typedef gd::SerializerElement::Attributes MapStringSerializerValue;
 typedef std::vector<std::pair<gd::String, std::shared_ptr<SerializerElement>>>
     VectorPairStringSharedPtrSerializerElement;
 typedef std::shared_ptr<SerializerElement> SharedPtrSerializerElement;
@@ -477,6 +535,22 @@ typedef std::vector<UnfilledRequiredBehaviorPropertyProblem>
     VectorUnfilledRequiredBehaviorPropertyProblem;
 typedef std::vector<const gd::ObjectFolderOrObject*> VectorObjectFolderOrObject;
 
+// Move the previous tree to the parser, as unique pointers can't be passed by
+// value from JavaScript. The previous tree can't be used afterwards.
+UniquePtrExpressionNode parseExpressionAfterEdit(
+    gd::ExpressionParser2 &parser,
+    const gd::String &expression,
+    UniquePtrExpressionNode &previousRootNode,
+    size_t editPosition,
+    size_t removedLength,
+    size_t insertedLength) {
+  return parser.ParseExpressionAfterEdit(expression,
+                                         std::move(previousRootNode),
+                                         editPosition,
+                                         removedLength,
+                                         insertedLength);
+}
+
 typedef ExtensionAndMetadata<BehaviorMetadata> ExtensionAndBehaviorMetadata;
 typedef ExtensionAndMetadata<ObjectMetadata> ExtensionAndObjectMetadata;
 typedef ExtensionAndMetadata<EffectMetadata> ExtensionAndEffectMetadata;
@@ -679,6 +753,9 @@ typedef ExtensionAndMetadata<ExpressionMetadata> ExtensionAndExpressionMetadata;
 #define STATIC_GenerateConditionSkeleton GenerateConditionSkeleton
 #define STATIC_CreateRectangle CreateRectangle
 #define STATIC_SanityCheckBehaviorProperty SanityCheckBehaviorProperty
+#define STATIC_SavePlatformMetadataSnapshot SavePlatformMetadataSnapshot
+#define STATIC_LoadPlatformMetadataSnapshot LoadPlatformMetadataSnapshot
+#define STATIC_ClearTranslationCatalog ClearTranslationCatalog
 #define STATIC_SanityCheckObjectProperty SanityCheckObjectProperty
 #define STATIC_SanityCheckObjectInitialInstanceProperty \
   SanityCheckObjectInitialInstanceProperty
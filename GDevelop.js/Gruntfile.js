@@ -102,6 +102,15 @@ module.exports = function (grunt) {
           },
         },
       },
+      // Save the metadata of the builtin extensions, loaded by newIDE at startup
+      generateMetadataSnapshot: {
+        command: 'node scripts/generate-metadata-snapshot.js',
+        options: {
+          execOptions: {
+            cwd: __dirname,
+          },
+        },
+      },
       // Copy the library to newIDE
       copyToNewIDE: {
         command: 'node scripts/copy-to-newIDE.js',
@@ -136,6 +145,7 @@ module.exports = function (grunt) {
           buildPath,
           buildOutputPath + 'libGD.js',
           buildOutputPath + 'libGD.wasm',
+          buildOutputPath + 'libGD-metadata-snapshot.txt',
         ],
       },
     },
@@ -155,6 +165,7 @@ module.exports = function (grunt) {
   ]);
   grunt.registerTask('build', [
     'build:raw',
+    'shell:generateMetadataSnapshot',
     'shell:copyToNewIDE',
     'shell:generateFlowTypes',
     'shell:generateTSTypes',
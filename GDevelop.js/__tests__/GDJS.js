@@ -90,6 +90,35 @@ describe('libGD.js - GDJS related tests', function () {
         "icons": []
       });
     });
+    it('streams the project data when the file system can append to files', () => {
+      const project = gd.ProjectHelper.createNewGDJSProject();
+      project.setName('My streamed project');
+
+      var fs = makeFakeAbstractFileSystem(gd, {
+        '/fake-gdjs-root/Runtime/index.html': fakeIndexHtmlContent,
+        '/fake-gdjs-root/Runtime/Electron/LICENSE.GDevelop.txt': "",
+      });
+      const appendedBytes = [];
+      fs.appendToFile = jest.fn();
+      fs.appendToFile.mockImplementation(function (filePath, bytes) {
+        appendedBytes.push(Buffer.from(bytes));
+        return true;
+      });
+
+      const exporter = new gd.Exporter(fs, '/fake-gdjs-root');
+      const exportOptions = new gd.ExportOptions(project, '/fake-export-dir');
+      expect(exporter.exportWholePixiProject(exportOptions)).toBe(true);
+      exportOptions.delete();
+      exporter.delete();
+
+      // The file is created empty, then written by parts.
+      expect(fs.writeToFile).toHaveBeenCalledWith('/fake-export-dir/data.js', '');
+      expect(fs.appendToFile.mock.calls[0][0]).toBe('/fake-export-dir/data.js');
+      const content = Buffer.concat(appendedBytes).toString('utf8');
+      expect(content.startsWith('gdjs.projectData = ')).toBe(true);
+      expect(content).toContain('My streamed project');
+      expect(content.endsWith(';\n')).toBe(true);
+    });
     it('properly exports Cordova files', () => {
       // Create a simple project
       const project = gd.ProjectHelper.createNewGDJSProject();
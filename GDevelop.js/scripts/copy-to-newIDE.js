@@ -48,6 +48,15 @@ if (shell.test('-f', sourceWasmFile)) {
   shell.exit(1);
 }
 
+// Copy the metadata snapshot, if generated.
+const sourceMetadataSnapshotFile = path.join(
+  sourcePath,
+  'libGD-metadata-snapshot.txt'
+);
+if (shell.test('-f', sourceMetadataSnapshotFile)) {
+  copyLibGdJsFile(sourceMetadataSnapshotFile);
+}
+
 // Copy the JS file.
 if (
   !shell.cp(sourceJsFile, destinationPath).stderr &&
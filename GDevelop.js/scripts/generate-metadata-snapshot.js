@@ -0,0 +1,27 @@
+const shell = require('shelljs');
+const path = require('path');
+const fs = require('fs');
+
+const libGdPath = path.join(
+  __dirname,
+  '../../Binaries/embuild/GDevelop.js/libGD.js'
+);
+const snapshotPath = path.join(
+  __dirname,
+  '../../Binaries/embuild/GDevelop.js/libGD-metadata-snapshot.txt'
+);
+
+if (!shell.test('-f', libGdPath)) {
+  shell.echo('❌ You must compile GDevelop.js first');
+  shell.exit(1);
+}
+
+// Save the metadata declared by the builtin extensions, so that the editor
+// can load them at startup instead of declaring the extensions in code.
+require(libGdPath)().then(gd => {
+  const snapshot = gd.ProjectHelper.savePlatformMetadataSnapshot();
+  fs.writeFileSync(snapshotPath, snapshot);
+  shell.echo(
+    '✅ Generated libGD-metadata-snapshot.txt in Binaries/embuild/GDevelop.js.'
+  );
+});
@@ -188,6 +188,9 @@ export class ProjectHelper extends EmscriptenObject {
   static sanityCheckBehaviorsSharedDataProperty(behavior: BehaviorsSharedData, propertyName: string, newValue: string): string;
   static sanityCheckObjectProperty(configuration: ObjectConfiguration, propertyName: string, newValue: string): string;
   static sanityCheckObjectInitialInstanceProperty(configuration: ObjectConfiguration, propertyName: string, newValue: string): string;
+  static savePlatformMetadataSnapshot(): string;
+  static loadPlatformMetadataSnapshot(snapshot: string): boolean;
+  static clearTranslationCatalog(): void;
 }
 
 export class EventsVariablesFinder extends EmscriptenObject {
@@ -565,6 +568,8 @@ export class Project extends EmscriptenObject {
   getResourcesManager(): ResourcesManager;
   serializeTo(element: SerializerElement): void;
   unserializeFrom(element: SerializerElement): void;
+  setIncrementalSerializationEnabled(enable: boolean): void;
+  isIncrementalSerializationEnabled(): boolean;
   getWholeProjectDiagnosticReport(): WholeProjectDiagnosticReport;
   static isNameSafe(name: string): boolean;
   static getSafeName(name: string): string;
@@ -763,6 +768,8 @@ export class Layout extends EmscriptenObject {
   serializeLayersTo(element: SerializerElement): void;
   unserializeLayersFrom(element: SerializerElement): void;
   getAssociatedEditorSettings(): EditorSettings;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: SerializerElement): void;
   unserializeFrom(project: Project, element: SerializerElement): void;
   setStopSoundsOnStartup(enable: boolean): void;
@@ -790,6 +797,8 @@ export class ExternalEvents extends EmscriptenObject {
   getAssociatedLayout(): string;
   setAssociatedLayout(name: string): void;
   getEvents(): EventsList;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: SerializerElement): void;
   unserializeFrom(project: Project, element: SerializerElement): void;
 }
@@ -802,6 +811,8 @@ export class ExternalLayout extends EmscriptenObject {
   getAssociatedLayout(): string;
   getInitialInstances(): InitialInstancesContainer;
   getAssociatedEditorSettings(): EditorSettings;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: SerializerElement): void;
   unserializeFrom(element: SerializerElement): void;
 }
@@ -1005,6 +1016,8 @@ export class ResourcesManager extends EmscriptenObject {
   moveResourceUpInList(oldName: string): boolean;
   moveResourceDownInList(oldName: string): boolean;
   moveResource(oldIndex: number, newIndex: number): void;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
 }
 
 export class ImageResource extends Resource {
@@ -2008,6 +2021,7 @@ export class UniquePtrExpressionNode extends EmscriptenObject {
 export class ExpressionParser2 extends EmscriptenObject {
   constructor();
   parseExpression(expression: string): UniquePtrExpressionNode;
+  parseExpressionAfterEdit(expression: string, previousRootNode: UniquePtrExpressionNode, editPosition: number, removedLength: number, insertedLength: number): UniquePtrExpressionNode;
 }
 
 export class EventsFunction extends EmscriptenObject {
@@ -2200,6 +2214,8 @@ export class EventsFunctionsExtension extends EmscriptenObject {
   getSceneVariables(): VariablesContainer;
   getEventsBasedBehaviors(): EventsBasedBehaviorsList;
   getEventsBasedObjects(): EventsBasedObjectsList;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: SerializerElement): void;
   unserializeFrom(project: Project, element: SerializerElement): void;
   static isExtensionLifecycleEventsFunction(eventsFunctionName: string): boolean;
@@ -2,6 +2,7 @@
 declare class gdExpressionParser2 {
   constructor(): void;
   parseExpression(expression: string): gdUniquePtrExpressionNode;
+  parseExpressionAfterEdit(expression: string, previousRootNode: gdUniquePtrExpressionNode, editPosition: number, removedLength: number, insertedLength: number): gdUniquePtrExpressionNode;
   delete(): void;
   ptr: number;
 };
\ No newline at end of file
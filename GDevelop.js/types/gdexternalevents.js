@@ -6,6 +6,8 @@ declare class gdExternalEvents {
   getAssociatedLayout(): string;
   setAssociatedLayout(name: string): void;
   getEvents(): gdEventsList;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: gdSerializerElement): void;
   unserializeFrom(project: gdProject, element: gdSerializerElement): void;
   delete(): void;
@@ -7,6 +7,8 @@ declare class gdExternalLayout {
   getAssociatedLayout(): string;
   getInitialInstances(): gdInitialInstancesContainer;
   getAssociatedEditorSettings(): gdEditorSettings;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: gdSerializerElement): void;
   unserializeFrom(element: gdSerializerElement): void;
   delete(): void;
@@ -28,6 +28,8 @@ declare class gdLayout extends gdObjectsContainer {
   serializeLayersTo(element: gdSerializerElement): void;
   unserializeLayersFrom(element: gdSerializerElement): void;
   getAssociatedEditorSettings(): gdEditorSettings;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   serializeTo(element: gdSerializerElement): void;
   unserializeFrom(project: gdProject, element: gdSerializerElement): void;
   setStopSoundsOnStartup(enable: boolean): void;
@@ -107,6 +107,8 @@ declare class gdProject extends gdObjectsContainer {
   getResourcesManager(): gdResourcesManager;
   serializeTo(element: gdSerializerElement): void;
   unserializeFrom(element: gdSerializerElement): void;
+  setIncrementalSerializationEnabled(enable: boolean): void;
+  isIncrementalSerializationEnabled(): boolean;
   getWholeProjectDiagnosticReport(): gdWholeProjectDiagnosticReport;
   static isNameSafe(name: string): boolean;
   static getSafeName(name: string): string;
@@ -14,6 +14,8 @@ declare class gdResourcesManager {
   moveResourceUpInList(oldName: string): boolean;
   moveResourceDownInList(oldName: string): boolean;
   moveResource(oldIndex: number, newIndex: number): void;
+  setDirty(dirty: boolean): void;
+  isDirty(): boolean;
   delete(): void;
   ptr: number;
 };
\ No newline at end of file
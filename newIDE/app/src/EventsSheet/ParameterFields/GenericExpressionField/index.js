@@ -124,6 +124,48 @@ type Props = {|
 
 const MAX_ERRORS_COUNT = 10;
 
+/**
+ * Return the edit transforming the previous expression into the new one (the
+ * text between their common prefix and suffix), or null if the positions in
+ * the string can't be used by the parser (which counts code points).
+ */
+const getExpressionEdit = (
+  previousExpression: string,
+  expression: string
+): ?{|
+  position: number,
+  removedLength: number,
+  insertedLength: number,
+|} => {
+  const surrogatesRegex = /[\uD800-\uDFFF]/;
+  if (
+    surrogatesRegex.test(previousExpression) ||
+    surrogatesRegex.test(expression)
+  )
+    return null;
+
+  const maxLength = Math.min(previousExpression.length, expression.length);
+  let prefixLength = 0;
+  while (
+    prefixLength < maxLength &&
+    previousExpression.charAt(prefixLength) === expression.charAt(prefixLength)
+  )
+    prefixLength++;
+  let suffixLength = 0;
+  while (
+    suffixLength < maxLength - prefixLength &&
+    previousExpression.charAt(previousExpression.length - 1 - suffixLength) ===
+      expression.charAt(expression.length - 1 - suffixLength)
+  )
+    suffixLength++;
+
+  return {
+    position: prefixLength,
+    removedLength: previousExpression.length - prefixLength - suffixLength,
+    insertedLength: expression.length - prefixLength - suffixLength,
+  };
+};
+
 const extractErrors = (
   platform: gdPlatform,
   project: gdProject,
@@ -177,6 +219,8 @@ export default class ExpressionField extends React.Component<Props, State> {
   _field: ?SemiControlledTextFieldInterface = null;
   _fieldElementWidth: ?number = null;
   _inputElement: ?HTMLInputElement = null;
+  _lastParsedExpression: ?string = null;
+  _lastExpressionNode: ?gdUniquePtrExpressionNode = null;
 
   state = {
     popoverOpen: false,
@@ -198,6 +242,10 @@ export default class ExpressionField extends React.Component<Props, State> {
 
   componentWillUnmount() {
     this._enqueueValidation.cancel();
+    if (this._lastExpressionNode) {
+      this._lastExpressionNode.delete();
+      this._lastExpressionNode = null;
+    }
   }
 
   focus: FieldFocusFunction = options => {
@@ -423,6 +471,36 @@ export default class ExpressionField extends React.Component<Props, State> {
     this._doValidation();
   }, 250);
 
+  // Parse the expression, reusing the nodes of the tree of the previous
+  // validation that are not affected by the edits made since.
+  _parseExpression = (
+    parser: gdExpressionParser2,
+    expression: string
+  ): gdExpressionNode => {
+    const previousExpression = this._lastParsedExpression;
+    const previousExpressionNode = this._lastExpressionNode;
+    const edit =
+      previousExpression !== null && previousExpressionNode
+        ? getExpressionEdit(previousExpression, expression)
+        : null;
+
+    const expressionNode =
+      edit && previousExpressionNode
+        ? parser.parseExpressionAfterEdit(
+            expression,
+            previousExpressionNode,
+            edit.position,
+            edit.removedLength,
+            edit.insertedLength
+          )
+        : parser.parseExpression(expression);
+    if (previousExpressionNode) previousExpressionNode.delete();
+
+    this._lastParsedExpression = expression;
+    this._lastExpressionNode = expressionNode;
+    return expressionNode.get();
+  };
+
   _doValidation = () => {
     const {
       project,
@@ -438,10 +516,11 @@ export default class ExpressionField extends React.Component<Props, State> {
     const expression = this.state.validatedValue;
 
     // Parsing can be time consuming (~1ms for simple expression,
-    // a few milliseconds for complex ones).
+    // a few milliseconds for complex ones), so only the edited part of the
+    // expression is parsed again.
 
     const parser = new gd.ExpressionParser2();
-    const expressionNode = parser.parseExpression(expression).get();
+    const expressionNode = this._parseExpression(parser, expression);
 
     const { errorText, errorHighlights } = extractErrors(
       gd.JsPlatform.get(),
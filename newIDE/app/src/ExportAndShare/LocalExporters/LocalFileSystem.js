@@ -167,6 +167,15 @@ class LocalFileSystem {
     }
     return true;
   };
+  appendToFile = (file: string, bytes: Uint8Array) => {
+    try {
+      fs.appendFileSync(file, bytes);
+    } catch (e) {
+      console.error('appendToFile(' + file + ', ...) failed: ' + e);
+      return false;
+    }
+    return true;
+  };
   readFile = (file: string) => {
     try {
       var contents = fs.readFileSync(file);
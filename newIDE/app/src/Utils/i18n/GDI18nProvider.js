@@ -70,6 +70,9 @@ export default class GDI18nProvider extends React.Component<Props, State> {
         () => {
           const { i18n } = this.state;
           gd.getTranslation = getTranslationFunction(i18n);
+          // Strings already translated with the previous function must be
+          // translated again.
+          gd.ProjectHelper.clearTranslationCatalog();
           console.info(`Loaded "${language}" language`);
         }
       );
@@ -13,7 +13,10 @@ import optionalRequire from './Utils/OptionalRequire';
 import { loadScript } from './Utils/LoadScript';
 import { showErrorBox } from './UI/Messages/MessageBox';
 import VersionMetadata from './Version/VersionMetadata';
-import { loadPreferencesFromLocalStorage } from './MainFrame/Preferences/PreferencesProvider';
+import {
+  loadPreferencesFromLocalStorage,
+  getInitialPreferences,
+} from './MainFrame/Preferences/PreferencesProvider';
 import { getFullTheme } from './UI/Theme';
 
 const GD_STARTUP_TIMES = global.GD_STARTUP_TIMES || [];
@@ -110,29 +113,56 @@ class Bootstrapper extends Component<{}, State> {
         ]);
         sendProgramOpening();
 
-        if (electron) {
-          import(/* webpackChunkName: "local-app" */ './LocalApp')
-            .then(module =>
-              this.setState({
-                App: module.create(this.authentication),
-                loadingMessage: '',
-              })
-            )
-            .catch(this.handleEditorLoadError);
-        } else {
-          import(/* webpackChunkName: "browser-app" */ './BrowserApp')
-            .then(module =>
-              this.setState({
-                App: module.create(this.authentication),
-                loadingMessage: '',
-              })
-            )
-            .catch(this.handleEditorLoadError);
-        }
+        // Load the metadata of the builtin extensions saved at build time,
+        // so that they are not declared in code. If missing, the extensions
+        // are declared in code as usual.
+        // The snapshot is saved in English, so it's only used if the editor
+        // is in English: otherwise, the extensions are declared in code to
+        // translate their strings.
+        const { language } =
+          loadPreferencesFromLocalStorage() || getInitialPreferences();
+        const snapshotPromise =
+          language === 'en'
+            ? fetch(
+                `./libGD-metadata-snapshot.txt?cache-buster=${VersionMetadata.versionWithHash}`
+              )
+                .then(response => (response.ok ? response.text() : null))
+                .catch(() => null)
+            : Promise.resolve(null);
+        snapshotPromise.then(snapshot => {
+          if (snapshot) gd.ProjectHelper.loadPlatformMetadataSnapshot(snapshot);
+          GD_STARTUP_TIMES.push([
+            'Metadata snapshot loading done',
+            performance.now(),
+          ]);
+          this._loadApp();
+        });
       });
     }, this.handleEditorLoadError);
   }
 
+  _loadApp = () => {
+    if (electron) {
+      import(/* webpackChunkName: "local-app" */ './LocalApp')
+        .then(module =>
+          this.setState({
+            App: module.create(this.authentication),
+            loadingMessage: '',
+          })
+        )
+        .catch(this.handleEditorLoadError);
+    } else {
+      import(/* webpackChunkName: "browser-app" */ './BrowserApp')
+        .then(module =>
+          this.setState({
+            App: module.create(this.authentication),
+            loadingMessage: '',
+          })
+        )
+        .catch(this.handleEditorLoadError);
+    }
+  };
+
   handleEditorLoadError = rawError => {
     const message = !electron
       ? 'Please check your internet connectivity, close the tab and reopen it.'